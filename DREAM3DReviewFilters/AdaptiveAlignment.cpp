@@ -38,6 +38,7 @@
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -72,6 +73,7 @@ AdaptiveAlignment::AdaptiveAlignment()
 , m_MinRadius(0.0f)
 , m_MaxRadius(0.0f)
 , m_NumberCircles(0)
+, m_UsePhaseCorrelation(false)
 {
 }
 
@@ -130,6 +132,7 @@ void AdaptiveAlignment::setupFilterParameters()
     parameters.push_back(SIMPL_NEW_FLOAT_FP("Total Shift In X-Direction (Microns)", ShiftX, FilterParameter::Parameter, AdaptiveAlignment, 2));
     parameters.push_back(SIMPL_NEW_FLOAT_FP("Total Shift In Y-Direction (Microns)", ShiftY, FilterParameter::Parameter, AdaptiveAlignment, 2));
   }
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Coarse Search With Phase Correlation", UsePhaseCorrelation, FilterParameter::Parameter, AdaptiveAlignment));
   {
     MultiDataArraySelectionFilterParameter::RequirementType req;
     parameters.push_back(SIMPL_NEW_MDA_SELECTION_FP("Attribute Arrays to Ignore", IgnoredDataArrayPaths, FilterParameter::Parameter, AdaptiveAlignment, req));
@@ -149,6 +152,7 @@ void AdaptiveAlignment::readFilterParameters(AbstractFilterParametersReader* rea
   setImageDataArrayPath(reader->readDataArrayPath("ImageDataArrayPath", getImageDataArrayPath()));
   setShiftX(reader->readValue("ShiftX", getShiftX()));
   setShiftY(reader->readValue("ShiftY", getShiftY()));
+  setUsePhaseCorrelation(reader->readValue("UsePhaseCorrelation", getUsePhaseCorrelation()));
   reader->closeFilterGroup();
 }
 
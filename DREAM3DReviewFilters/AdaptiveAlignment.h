@@ -60,6 +60,7 @@ class DREAM3DReview_EXPORT AdaptiveAlignment : public AbstractFilter
   PYB11_PROPERTY(float MinRadius READ getMinRadius WRITE setMinRadius)
   PYB11_PROPERTY(float MaxRadius READ getMaxRadius WRITE setMaxRadius)
   PYB11_PROPERTY(int NumberCircles READ getNumberCircles WRITE setNumberCircles)
+  PYB11_PROPERTY(bool UsePhaseCorrelation READ getUsePhaseCorrelation WRITE setUsePhaseCorrelation)
 public:
   SIMPL_SHARED_POINTERS(AdaptiveAlignment)
   SIMPL_FILTER_NEW_MACRO(AdaptiveAlignment)
@@ -106,6 +107,9 @@ public:
   SIMPL_FILTER_PARAMETER(int, NumberCircles)
   Q_PROPERTY(int NumberCircles READ getNumberCircles WRITE setNumberCircles)
 
+  SIMPL_FILTER_PARAMETER(bool, UsePhaseCorrelation)
+  Q_PROPERTY(bool UsePhaseCorrelation READ getUsePhaseCorrelation WRITE setUsePhaseCorrelation)
+
   SIMPL_FILTER_PARAMETER(QVector<DataArrayPath>, IgnoredDataArrayPaths)
   Q_PROPERTY(QVector<DataArrayPath> IgnoredDataArrayPaths READ getIgnoredDataArrayPaths WRITE setIgnoredDataArrayPaths)
 
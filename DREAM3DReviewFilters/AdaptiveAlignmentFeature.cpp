@@ -37,6 +37,13 @@
 
 #include <fstream>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -44,8 +51,116 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/PhaseCorrelation.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+/**
+ * @brief The FindFeatureShiftsImpl class determines the best candidate shifts for a range of
+ * slice pairs by comparing the mask arrays of neighboring sections. Each slice pair is registered
+ * independently of the others; the cumulative shifts are composed afterwards by the caller.
+ */
+class FindFeatureShiftsImpl
+{
+public:
+  FindFeatureShiftsImpl(AbstractFilter* filter, const int64_t* dims, uint64_t maxstoredshifts, bool usePhaseCorrelation, bool* goodVoxels, std::vector<std::vector<int64_t>>& newxshift,
+                        std::vector<std::vector<int64_t>>& newyshift, std::vector<std::vector<float>>& mindisorientation)
+  : m_Filter(filter)
+  , m_MaxStoredShifts(maxstoredshifts)
+  , m_UsePhaseCorrelation(usePhaseCorrelation)
+  , m_GoodVoxels(goodVoxels)
+  , m_NewXShift(newxshift)
+  , m_NewYShift(newyshift)
+  , m_MinDisorientation(mindisorientation)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~FindFeatureShiftsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    // visited candidate shifts, reused from slice to slice
+    std::vector<std::vector<bool>> visited;
+    std::vector<float> refImage;
+    std::vector<float> curImage;
+
+    for(size_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t slice = (m_Dims[2] - 1) - static_cast<int64_t>(iter);
+      if(m_UsePhaseCorrelation)
+      {
+        // coarse estimate of the shift from the mask images of both sections
+        fillMaskImage(slice + 1, refImage);
+        fillMaskImage(slice, curImage);
+        PhaseCorrelation::SeedShift(refImage, curImage, m_Dims[0], m_Dims[1], m_NewXShift[iter][0], m_NewYShift[iter][0]);
+      }
+      PhaseCorrelation::RefineShift(m_Dims[0], m_Dims[1], m_MaxStoredShifts, visited, m_NewXShift[iter], m_NewYShift[iter], m_MinDisorientation[iter],
+                                    [&](int64_t shiftX, int64_t shiftY) { return maskMismatch(slice, shiftX, shiftY); });
+    }
+  }
+
+  void fillMaskImage(int64_t slice, std::vector<float>& image) const
+  {
+    const bool* sliceMask = m_GoodVoxels + (slice * m_Dims[0] * m_Dims[1]);
+    image.resize(m_Dims[0] * m_Dims[1]);
+    for(int64_t i = 0; i < m_Dims[0] * m_Dims[1]; i++)
+    {
+      image[i] = sliceMask[i] ? 1.0f : 0.0f;
+    }
+  }
+
+  /**
+   * @brief maskMismatch Returns the fraction of sampled pixels whose mask value differs between the
+   * reference section slice + 1 and the current section slice moved by (shiftX, shiftY)
+   */
+  float maskMismatch(int64_t slice, int64_t shiftX, int64_t shiftY) const
+  {
+    const int64_t* dims = m_Dims;
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    for(int64_t l = 0; l < dims[1]; l = l + 4)
+    {
+      for(int64_t n = 0; n < dims[0]; n = n + 4)
+      {
+        if((l + shiftY) >= 0 && (l + shiftY) < dims[1] && (n + shiftX) >= 0 && (n + shiftX) < dims[0])
+        {
+          int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+          int64_t curposition = (slice * dims[0] * dims[1]) + ((l + shiftY) * dims[0]) + (n + shiftX);
+          if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+          {
+            disorientation++;
+          }
+          count++;
+        }
+      }
+    }
+    return disorientation / count;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  int64_t m_Dims[3];
+  uint64_t m_MaxStoredShifts;
+  bool m_UsePhaseCorrelation;
+  bool* m_GoodVoxels;
+  std::vector<std::vector<int64_t>>& m_NewXShift;
+  std::vector<std::vector<int64_t>>& m_NewYShift;
+  std::vector<std::vector<float>>& m_MinDisorientation;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -157,8 +272,6 @@ void AdaptiveAlignmentFeature::find_shifts(std::vector<int64_t>& xshifts, std::v
     maxstoredshifts = 20;
   }
 
-  float disorientation = 0.0f;
-
   std::vector<std::vector<int64_t>> newxshift(dims[2]);
   std::vector<std::vector<int64_t>> newyshift(dims[2]);
   std::vector<std::vector<float>> mindisorientation(dims[2]);
@@ -169,97 +282,34 @@ void AdaptiveAlignmentFeature::find_shifts(std::vector<int64_t>& xshifts, std::v
     mindisorientation[a].resize(maxstoredshifts, std::numeric_limits<float>::max());
   }
 
-  // Allocate a 2D Array which will be reused from slice to slice
-  // second dimension is assigned in each cycle separately
-  std::vector<std::vector<bool>> misorients(dims[0]);
+  notifyStatusMessage(QObject::tr("Aligning Anisotropic Sections || Determining Shifts"));
 
-  const uint64_t halfDim0 = static_cast<uint64_t>(dims[0] * 0.5f);
-  const uint64_t halfDim1 = static_cast<uint64_t>(dims[1] * 0.5f);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  int32_t oldxshift = 0;
-  int32_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-  uint64_t progInt = 0;
-
-  for(int64_t iter = 1; iter < dims[2]; iter++)
+  // every slice pair is registered independently; the pairs are z-slices 1 ... dims[2] - 1
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    progInt = static_cast<uint64_t>(iter * 100 / static_cast<float>(dims[2]));
-    QString ss = QObject::tr("Aligning Anisotropic Sections || Determining Shifts || %1% Complete").arg(progInt);
-
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-
-    for(size_t i = 0; i < udims[0]; i++)
-    {
-      misorients[i].assign(dims[1], false);
-    }
-
-    while(newxshift[iter][0] != oldxshift || newyshift[iter][0] != oldyshift)
-    {
-      oldxshift = newxshift[iter][0];
-      oldyshift = newyshift[iter][0];
-
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          if((llabs(k + oldxshift) < static_cast<long long int>(halfDim0)) && llabs(j + oldyshift) < static_cast<long long int>(halfDim1) &&
-             !misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1])
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
-                  {
-                    disorientation++;
-                  }
-                  count++;
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1] = true;
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, udims[2]), FindFeatureShiftsImpl(this, dims, maxstoredshifts, getUsePhaseCorrelation(), m_GoodVoxels, newxshift, newyshift, mindisorientation), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindFeatureShiftsImpl serial(this, dims, maxstoredshifts, getUsePhaseCorrelation(), m_GoodVoxels, newxshift, newyshift, mindisorientation);
+    serial.compute(1, udims[2]);
+  }
 
-            // compare the new shift with currently stored ones
-            int64_t s = maxstoredshifts;
-            while(s - 1 >= 0 && disorientation < mindisorientation[iter][s - 1])
-            {
-              s--;
-            }
+  if(getCancel())
+  {
+    return;
+  }
 
-            // new shift is stored with index 's' in the arrays
-            if(s < static_cast<int64_t>(maxstoredshifts))
-            {
-              // lag the shifts already stored
-              for(int64_t t = maxstoredshifts - 1; t > s; t--)
-              {
-                newxshift[iter][t] = newxshift[iter][t - 1];
-                newyshift[iter][t] = newyshift[iter][t - 1];
-                mindisorientation[iter][t] = mindisorientation[iter][t - 1];
-              }
-              // store the new shift
-              newxshift[iter][s] = k + oldxshift;
-              newyshift[iter][s] = j + oldyshift;
-              mindisorientation[iter][s] = disorientation;
-            }
-          }
-        }
-      }
-    }
+  // compose the cumulative shifts once all slice pairs have been registered
+  for(int64_t iter = 1; iter < dims[2]; iter++)
+  {
     xshifts[iter] = xshifts[iter - 1] + newxshift[iter][0];
     yshifts[iter] = yshifts[iter - 1] + newyshift[iter][0];
   }
@@ -391,7 +441,7 @@ void AdaptiveAlignmentFeature::find_shifts(std::vector<int64_t>& xshifts, std::v
     outFile.open(getAlignmentShiftFileName().toLatin1().data());
     for(size_t iter = 1; iter < udims[2]; iter++)
     {
-      slice = (dims[2] - 1) - iter;
+      int64_t slice = (dims[2] - 1) - iter;
       xshifts[iter] = xshifts[iter - 1] + newxshift[iter][curindex[iter]];
       yshifts[iter] = yshifts[iter - 1] + newyshift[iter][curindex[iter]];
       outFile << slice << "	" << slice + 1 << "	" << newxshift[iter][curindex[iter]] << "	" << newyshift[iter][curindex[iter]] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
@@ -35,8 +35,16 @@
 
 #include "AdaptiveAlignmentMisorientation.h"
 
+#include <cmath>
 #include <fstream>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include <QtCore/QDateTime>
 
 #include "SIMPLib/Common/Constants.h"
@@ -48,8 +56,274 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/PhaseCorrelation.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+/**
+ * @brief The SectionOrientations struct holds the per-pixel data of one section that the alignment
+ * needs for every candidate shift: the normalized quaternion and the Laue class of the pixel, which is
+ * -1 when the pixel has no phase or no matching Laue class.
+ */
+struct SectionOrientations
+{
+  std::vector<QuatF> unitQuats;
+  std::vector<int32_t> laueIndex;
+};
+
+/**
+ * @brief The FindMisorientationShiftsImpl class determines the best candidate shifts for a range of
+ * slice pairs. Each slice pair is registered independently of the others, so the pairs can be
+ * distributed across threads; the cumulative shifts are composed afterwards by the caller.
+ */
+class FindMisorientationShiftsImpl
+{
+public:
+  FindMisorientationShiftsImpl(AbstractFilter* filter, const uint64_t* dims, uint64_t maxstoredshifts, bool usePhaseCorrelation, float misorientationTolerance, bool useGoodVoxels, float* quats, int32_t* cellPhases,
+                               bool* goodVoxels, uint32_t* crystalStructures, QVector<LaueOps::Pointer> orientationOps, std::vector<std::vector<int64_t>>& newxshift,
+                               std::vector<std::vector<int64_t>>& newyshift, std::vector<std::vector<float>>& mindisorientation)
+  : m_Filter(filter)
+  , m_MaxStoredShifts(maxstoredshifts)
+  , m_UsePhaseCorrelation(usePhaseCorrelation)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_UseGoodVoxels(useGoodVoxels)
+  , m_Quats(reinterpret_cast<QuatF*>(quats))
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_CosHalfTolerance(std::cos(0.5f * misorientationTolerance))
+  , m_NewXShift(newxshift)
+  , m_NewYShift(newyshift)
+  , m_MinDisorientation(mindisorientation)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~FindMisorientationShiftsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    // visited candidate shifts, reused from slice to slice
+    std::vector<std::vector<bool>> visited;
+    std::vector<float> refImage;
+    std::vector<float> curImage;
+    SectionOrientations refSection;
+    SectionOrientations curSection;
+    int64_t curSectionSlice = -1;
+
+    for(size_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      // consecutive slice pairs share a section, so the previous current section becomes the new reference
+      uint64_t slice = (m_Dims[2] - 1) - iter;
+      if(curSectionSlice == static_cast<int64_t>(slice + 1))
+      {
+        std::swap(refSection, curSection);
+      }
+      else
+      {
+        fillSection(slice + 1, refSection);
+      }
+      fillSection(slice, curSection);
+      curSectionSlice = static_cast<int64_t>(slice);
+
+      if(m_UsePhaseCorrelation)
+      {
+        // coarse estimate of the shift from the grain boundary maps of both sections
+        fillBoundaryImage(slice + 1, refSection, refImage);
+        fillBoundaryImage(slice, curSection, curImage);
+        PhaseCorrelation::SeedShift(refImage, curImage, m_Dims[0], m_Dims[1], m_NewXShift[iter][0], m_NewYShift[iter][0]);
+      }
+      PhaseCorrelation::RefineShift(m_Dims[0], m_Dims[1], m_MaxStoredShifts, visited, m_NewXShift[iter], m_NewYShift[iter], m_MinDisorientation[iter],
+                                    [&](int64_t shiftX, int64_t shiftY) { return misorientedFraction(slice, refSection, curSection, shiftX, shiftY); });
+    }
+  }
+
+  /**
+   * @brief fillSection Gathers the normalized quaternions and Laue classes of a section once, so
+   * that the candidate shifts do not repeat the phase and crystal structure lookups
+   */
+  void fillSection(uint64_t slice, SectionOrientations& section) const
+  {
+    uint64_t sliceOffset = slice * m_Dims[0] * m_Dims[1];
+    uint64_t numPoints = m_Dims[0] * m_Dims[1];
+    section.unitQuats.resize(numPoints);
+    section.laueIndex.resize(numPoints);
+    for(uint64_t i = 0; i < numPoints; i++)
+    {
+      uint64_t point = sliceOffset + i;
+      const QuatF& q = m_Quats[point];
+      float norm = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+      QuatF& unitQuat = section.unitQuats[i];
+      QuaternionMathF::Copy(q, unitQuat);
+      if(norm > 0.0f)
+      {
+        unitQuat.x /= norm;
+        unitQuat.y /= norm;
+        unitQuat.z /= norm;
+        unitQuat.w /= norm;
+      }
+      section.laueIndex[i] = -1;
+      if(m_CellPhases[point] > 0)
+      {
+        uint32_t laue = m_CrystalStructures[m_CellPhases[point]];
+        if(laue < static_cast<uint32_t>(m_OrientationOps.size()))
+        {
+          section.laueIndex[i] = static_cast<int32_t>(laue);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief isMisoriented Decides whether two pixels are misoriented by more than the tolerance. The
+   * rotation between the raw orientations bounds the symmetry-reduced misorientation from above, so
+   * pairs whose quaternion dot product is within the tolerance are accepted without evaluating the
+   * symmetry operators; only the remaining pairs go through getMisoQuat.
+   */
+  bool isMisoriented(const SectionOrientations& section1, uint64_t index1, uint64_t point1, const SectionOrientations& section2, uint64_t index2, uint64_t point2) const
+  {
+    int32_t laue1 = section1.laueIndex[index1];
+    if(laue1 < 0 || laue1 != section2.laueIndex[index2])
+    {
+      return true;
+    }
+    const QuatF& u1 = section1.unitQuats[index1];
+    const QuatF& u2 = section2.unitQuats[index2];
+    float dot = std::fabs(u1.x * u2.x + u1.y * u2.y + u1.z * u2.z + u1.w * u2.w);
+    if(dot > m_CosHalfTolerance)
+    {
+      return false;
+    }
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    QuaternionMathF::Copy(m_Quats[point1], q1);
+    QuaternionMathF::Copy(m_Quats[point2], q2);
+    float w = m_OrientationOps[laue1]->getMisoQuat(q1, q2, n1, n2, n3);
+    return (w > m_MisorientationTolerance);
+  }
+
+  /**
+   * @brief fillBoundaryImage Creates a scalar image of a section that is 1 for every pixel misoriented
+   * (or of a different phase or mask value) with respect to its +x or +y neighbor and 0 elsewhere
+   */
+  void fillBoundaryImage(uint64_t slice, const SectionOrientations& section, std::vector<float>& image) const
+  {
+    uint64_t sliceOffset = slice * m_Dims[0] * m_Dims[1];
+    uint64_t neighborOffsets[2] = {1, m_Dims[0]};
+
+    image.assign(m_Dims[0] * m_Dims[1], 0.0f);
+    for(uint64_t l = 0; l < m_Dims[1]; l++)
+    {
+      for(uint64_t n = 0; n < m_Dims[0]; n++)
+      {
+        uint64_t index = (l * m_Dims[0]) + n;
+        uint64_t point = sliceOffset + index;
+        for(int32_t i = 0; i < 2; i++)
+        {
+          if((i == 0 && n == m_Dims[0] - 1) || (i == 1 && l == m_Dims[1] - 1))
+          {
+            continue;
+          }
+          uint64_t neighbor = point + neighborOffsets[i];
+          bool boundary = false;
+          if(m_UseGoodVoxels && m_GoodVoxels[point] != m_GoodVoxels[neighbor])
+          {
+            boundary = true;
+          }
+          else if(m_CellPhases[point] != m_CellPhases[neighbor])
+          {
+            boundary = true;
+          }
+          else if(m_CellPhases[point] > 0)
+          {
+            boundary = isMisoriented(section, index, point, section, index + neighborOffsets[i], neighbor);
+          }
+          if(boundary)
+          {
+            image[index] = 1.0f;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief misorientedFraction Returns the fraction of sampled pixels that are misoriented, or differ in
+   * their mask value, between the reference section slice + 1 and the current section slice moved by
+   * (shiftX, shiftY)
+   */
+  float misorientedFraction(uint64_t slice, const SectionOrientations& refSection, const SectionOrientations& curSection, int64_t shiftX, int64_t shiftY) const
+  {
+    const uint64_t* dims = m_Dims;
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    for(uint64_t l = 0; l < dims[1]; l = l + 4)
+    {
+      for(uint64_t n = 0; n < dims[0]; n = n + 4)
+      {
+        if(int64_t((l + shiftY)) >= 0 && (l + shiftY) < dims[1] && int64_t((n + shiftX)) >= 0 && (n + shiftX) < dims[0])
+        {
+          count++;
+          uint64_t refindex = (l * dims[0]) + n;
+          uint64_t curindex = ((l + shiftY) * dims[0]) + (n + shiftX);
+          uint64_t refposition = ((slice + 1) * dims[0] * dims[1]) + refindex;
+          uint64_t curposition = (slice * dims[0] * dims[1]) + curindex;
+          if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
+          {
+            if(isMisoriented(refSection, refindex, refposition, curSection, curindex, curposition))
+            {
+              disorientation++;
+            }
+          }
+          if(m_UseGoodVoxels)
+          {
+            if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
+            {
+              disorientation++;
+            }
+            if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
+            {
+              disorientation++;
+            }
+          }
+        }
+      }
+    }
+    return disorientation / count;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  uint64_t m_Dims[3];
+  uint64_t m_MaxStoredShifts;
+  bool m_UsePhaseCorrelation;
+  float m_MisorientationTolerance;
+  bool m_UseGoodVoxels;
+  QuatF* m_Quats;
+  int32_t* m_CellPhases;
+  bool* m_GoodVoxels;
+  uint32_t* m_CrystalStructures;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+  float m_CosHalfTolerance;
+  std::vector<std::vector<int64_t>>& m_NewXShift;
+  std::vector<std::vector<int64_t>>& m_NewYShift;
+  std::vector<std::vector<float>>& m_MinDisorientation;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -231,8 +505,6 @@ void AdaptiveAlignmentMisorientation::find_shifts(std::vector<int64_t>& xshifts,
     maxstoredshifts = 20;
   }
 
-  float disorientation = 0.0f;
-
   std::vector<std::vector<int64_t>> newxshift(dims[2]);
   std::vector<std::vector<int64_t>> newyshift(dims[2]);
   std::vector<std::vector<float>> mindisorientation(dims[2]);
@@ -243,138 +515,40 @@ void AdaptiveAlignmentMisorientation::find_shifts(std::vector<int64_t>& xshifts,
     mindisorientation[a].resize(maxstoredshifts, std::numeric_limits<float>::max());
   }
 
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  uint64_t slice = 0;
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  uint64_t refposition = 0;
-  uint64_t curposition = 0;
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+  float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
 
-  uint32_t phase1 = 0, phase2 = 0;
-  uint64_t progInt = 0;
+  notifyStatusMessage(QObject::tr("Aligning Anisotropic Sections || Determining Shifts"));
 
-  // Allocate a 2D Array which will be reused from slice to slice
-  // second dimension is assigned in each cycle separately
-  std::vector<std::vector<bool>> misorients(dims[0]);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  const uint64_t halfDim0 = static_cast<uint64_t>(dims[0] * 0.5f);
-  const uint64_t halfDim1 = static_cast<uint64_t>(dims[1] * 0.5f);
+  // every slice pair is registered independently; the pairs are z-slices 1 ... dims[2] - 1
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, dims[2]),
+                      FindMisorientationShiftsImpl(this, dims, maxstoredshifts, getUsePhaseCorrelation(), misorientationTolerance, m_UseGoodVoxels, m_Quats, m_CellPhases, m_GoodVoxels, m_CrystalStructures,
+                                                   m_OrientationOps, newxshift, newyshift, mindisorientation),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindMisorientationShiftsImpl serial(this, dims, maxstoredshifts, getUsePhaseCorrelation(), misorientationTolerance, m_UseGoodVoxels, m_Quats, m_CellPhases, m_GoodVoxels, m_CrystalStructures, m_OrientationOps,
+                                        newxshift, newyshift, mindisorientation);
+    serial.compute(1, dims[2]);
+  }
 
-  float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
+  if(getCancel())
+  {
+    return;
+  }
 
-  // Loop over the Z Direction
+  // compose the cumulative shifts once all slice pairs have been registered
   for(uint64_t iter = 1; iter < dims[2]; iter++)
   {
-    progInt = static_cast<uint64_t>(iter * 100 / static_cast<float>(dims[2]));
-    QString ss = QObject::tr("Aligning Anisotropic Sections || Determining Shifts || %1% Complete").arg(progInt);
-    notifyStatusMessage(ss);
-    if(getCancel())
-    {
-      return;
-    }
-
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-
-    for(uint64_t i = 0; i < dims[0]; i++)
-    {
-      misorients[i].assign(dims[1], false);
-    }
-
-    while(newxshift[iter][0] != oldxshift || newyshift[iter][0] != oldyshift)
-    {
-      oldxshift = newxshift[iter][0];
-      oldyshift = newyshift[iter][0];
-
-      for(int32_t j = -3; j <= 3; j++)
-      {
-        for(int32_t k = -3; k <= 3; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          if(llabs(k + oldxshift) < static_cast<int64_t>(halfDim0) && llabs(j + oldyshift) < static_cast<int64_t>(halfDim1) && !misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1])
-          {
-            for(uint64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(uint64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if(int64_t((l + j + oldyshift)) >= 0 && (l + j + oldyshift) < dims[1] && int64_t((n + k + oldxshift)) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
-                  {
-                    w = std::numeric_limits<float>::max();
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
-                    {
-                      QuaternionMathF::Copy(quats[refposition], q1);
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      QuaternionMathF::Copy(quats[curposition], q2);
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
-                      {
-                        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                      }
-                    }
-                    if(w > misorientationTolerance)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_UseGoodVoxels)
-                  {
-                    if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                    if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                  }
-                }
-                else
-                {
-                }
-              }
-            }
-
-            disorientation = disorientation / count;
-            misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1] = true;
-
-            // compare the new shift with currently stored ones
-            int64_t s = maxstoredshifts;
-            while(s - 1 >= 0 && disorientation < mindisorientation[iter][s - 1])
-            {
-              s--;
-            }
-
-            // new shift is stored with index 's' in the arrays
-            if(s < static_cast<int64_t>(maxstoredshifts))
-            {
-              // lag the shifts already stored
-              for(int64_t t = maxstoredshifts - 1; t > s; t--)
-              {
-                newxshift[iter][t] = newxshift[iter][t - 1];
-                newyshift[iter][t] = newyshift[iter][t - 1];
-                mindisorientation[iter][t] = mindisorientation[iter][t - 1];
-              }
-              // store the new shift
-              newxshift[iter][s] = k + oldxshift;
-              newyshift[iter][s] = j + oldyshift;
-              mindisorientation[iter][s] = disorientation;
-            }
-          }
-        }
-      }
-    }
     xshifts[iter] = xshifts[iter - 1] + newxshift[iter][0];
     yshifts[iter] = yshifts[iter - 1] + newyshift[iter][0];
   }
@@ -506,7 +680,7 @@ void AdaptiveAlignmentMisorientation::find_shifts(std::vector<int64_t>& xshifts,
     outFile.open(getAlignmentShiftFileName().toLatin1().data());
     for(uint64_t iter = 1; iter < dims[2]; iter++)
     {
-      slice = (dims[2] - 1) - iter;
+      uint64_t slice = (dims[2] - 1) - iter;
       xshifts[iter] = xshifts[iter - 1] + newxshift[iter][curindex[iter]];
       yshifts[iter] = yshifts[iter - 1] + newyshift[iter][curindex[iter]];
       outFile << slice << "	" << slice + 1 << "	" << newxshift[iter][curindex[iter]] << "	" << newyshift[iter][curindex[iter]] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
@@ -35,8 +35,16 @@
 
 #include "AdaptiveAlignmentMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -47,8 +55,190 @@
 #include "SIMPLib/Math/SIMPLibRandom.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/PhaseCorrelation.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+/**
+ * @brief The FindMutualInformationShiftsImpl class determines the best candidate shifts for a range of
+ * slice pairs by maximizing the mutual information between the features identified on neighboring
+ * sections. Each slice pair is registered independently of the others; the cumulative shifts are
+ * composed afterwards by the caller.
+ */
+class FindMutualInformationShiftsImpl
+{
+public:
+  FindMutualInformationShiftsImpl(AbstractFilter* filter, const uint64_t* dims, uint64_t maxstoredshifts, bool usePhaseCorrelation, int32_t* miFeatureIds, int32_t* featurecounts,
+                                  std::vector<std::vector<int64_t>>& newxshift, std::vector<std::vector<int64_t>>& newyshift, std::vector<std::vector<float>>& mindisorientation)
+  : m_Filter(filter)
+  , m_MaxStoredShifts(maxstoredshifts)
+  , m_UsePhaseCorrelation(usePhaseCorrelation)
+  , m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featurecounts)
+  , m_NewXShift(newxshift)
+  , m_NewYShift(newyshift)
+  , m_MinDisorientation(mindisorientation)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~FindMutualInformationShiftsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    // visited candidate shifts, reused from slice to slice
+    std::vector<std::vector<bool>> visited;
+    std::vector<float> refImage;
+    std::vector<float> curImage;
+    std::vector<uint64_t> pairKeys;
+    std::vector<float> mutualinfo1;
+    std::vector<float> mutualinfo2;
+
+    for(size_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      uint64_t slice = (m_Dims[2] - 1) - iter;
+      if(m_UsePhaseCorrelation)
+      {
+        // coarse estimate of the shift from the feature boundary maps of both sections
+        fillBoundaryImage(slice + 1, refImage);
+        fillBoundaryImage(slice, curImage);
+        PhaseCorrelation::SeedShift(refImage, curImage, m_Dims[0], m_Dims[1], m_NewXShift[iter][0], m_NewYShift[iter][0]);
+      }
+      int32_t featurecount1 = m_FeatureCounts[slice];
+      int32_t featurecount2 = m_FeatureCounts[slice + 1];
+      mutualinfo1.resize(featurecount1);
+      mutualinfo2.resize(featurecount2);
+      pairKeys.reserve(((m_Dims[0] + 3) / 4) * ((m_Dims[1] + 3) / 4));
+      PhaseCorrelation::RefineShift(m_Dims[0], m_Dims[1], m_MaxStoredShifts, visited, m_NewXShift[iter], m_NewYShift[iter], m_MinDisorientation[iter],
+                                    [&](int64_t shiftX, int64_t shiftY) { return inverseMutualInformation(slice, shiftX, shiftY, pairKeys, mutualinfo1, mutualinfo2); });
+    }
+  }
+
+  /**
+   * @brief fillBoundaryImage Creates a scalar image of a section that is 1 for every pixel whose
+   * section feature differs from its +x or +y neighbor and 0 elsewhere
+   */
+  void fillBoundaryImage(uint64_t slice, std::vector<float>& image) const
+  {
+    const int32_t* sliceIds = m_MIFeatureIds + (slice * m_Dims[0] * m_Dims[1]);
+    image.assign(m_Dims[0] * m_Dims[1], 0.0f);
+    for(uint64_t l = 0; l < m_Dims[1]; l++)
+    {
+      for(uint64_t n = 0; n < m_Dims[0]; n++)
+      {
+        uint64_t point = (l * m_Dims[0]) + n;
+        if((n < m_Dims[0] - 1 && sliceIds[point] != sliceIds[point + 1]) || (l < m_Dims[1] - 1 && sliceIds[point] != sliceIds[point + m_Dims[0]]))
+        {
+          image[point] = 1.0f;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief inverseMutualInformation Returns the inverse of the mutual information between the section
+   * features of the reference section slice + 1 and the current section slice moved by (shiftX, shiftY).
+   * The joint histogram of section features is kept sparse as a list of (cur, ref) pair keys, so its cost
+   * scales with the number of sampled pixels instead of the product of the per-section feature counts. The
+   * scratch buffers are owned by the calling task and reused across slices and candidate shifts.
+   */
+  float inverseMutualInformation(uint64_t slice, int64_t shiftX, int64_t shiftY, std::vector<uint64_t>& pairKeys, std::vector<float>& mutualinfo1, std::vector<float>& mutualinfo2) const
+  {
+    const uint64_t* dims = m_Dims;
+    int32_t featurecount1 = m_FeatureCounts[slice];
+    int32_t featurecount2 = m_FeatureCounts[slice + 1];
+
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    pairKeys.clear();
+    std::fill(mutualinfo1.begin(), mutualinfo1.end(), 0.0f);
+    std::fill(mutualinfo2.begin(), mutualinfo2.end(), 0.0f);
+    for(uint64_t l = 0; l < dims[1]; l = l + 4)
+    {
+      for(uint64_t n = 0; n < dims[0]; n = n + 4)
+      {
+        if(int64_t((l + shiftY)) >= 0 && (l + shiftY) < dims[1] && int64_t((n + shiftX)) >= 0 && (n + shiftX) < dims[0])
+        {
+          uint64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+          uint64_t curposition = (slice * dims[0] * dims[1]) + ((l + shiftY) * dims[0]) + (n + shiftX);
+          int32_t refgnum = m_MIFeatureIds[refposition];
+          int32_t curgnum = m_MIFeatureIds[curposition];
+          if(curgnum >= 0 && refgnum >= 0)
+          {
+            pairKeys.push_back(static_cast<uint64_t>(curgnum) * featurecount2 + refgnum);
+            mutualinfo1[curgnum]++;
+            mutualinfo2[refgnum]++;
+            count++;
+          }
+        }
+        else
+        {
+          pairKeys.push_back(0);
+          mutualinfo1[0]++;
+          mutualinfo2[0]++;
+        }
+      }
+    }
+    // normalize the marginal histograms
+    for(int32_t b = 0; b < featurecount1; b++)
+    {
+      mutualinfo1[b] = mutualinfo1[b] / count;
+    }
+    for(int32_t c = 0; c < featurecount2; c++)
+    {
+      mutualinfo2[c] = mutualinfo2[c] / count;
+    }
+    // sorting the pair keys groups equal (cur, ref) pairs together, so each run is one non-zero
+    // cell of the joint histogram, visited in the same order as a dense row-major traversal
+    std::sort(pairKeys.begin(), pairKeys.end());
+    for(size_t p = 0; p < pairKeys.size();)
+    {
+      size_t q = p + 1;
+      while(q < pairKeys.size() && pairKeys[q] == pairKeys[p])
+      {
+        q++;
+      }
+      int32_t b = static_cast<int32_t>(pairKeys[p] / featurecount2);
+      int32_t c = static_cast<int32_t>(pairKeys[p] % featurecount2);
+      float mutualinfo12 = static_cast<float>(q - p) / count;
+      float value = 0.0f;
+      if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
+      {
+        value = (mutualinfo12 / (mutualinfo1[b] * mutualinfo2[c]));
+      }
+      if(value != 0.0f)
+      {
+        disorientation = disorientation + (mutualinfo12 * logf(value));
+      }
+      p = q;
+    }
+    return 1.0f / disorientation;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  uint64_t m_Dims[3];
+  uint64_t m_MaxStoredShifts;
+  bool m_UsePhaseCorrelation;
+  int32_t* m_MIFeatureIds;
+  int32_t* m_FeatureCounts;
+  std::vector<std::vector<int64_t>>& m_NewXShift;
+  std::vector<std::vector<int64_t>>& m_NewYShift;
+  std::vector<std::vector<float>>& m_MinDisorientation;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -240,8 +430,6 @@ void AdaptiveAlignmentMutualInformation::find_shifts(std::vector<int64_t>& xshif
     maxstoredshifts = 20;
   }
 
-  float disorientation = 0.0f;
-
   std::vector<std::vector<int64_t>> newxshift(dims[2]);
   std::vector<std::vector<int64_t>> newyshift(dims[2]);
   std::vector<std::vector<float>> mindisorientation(dims[2]);
@@ -252,189 +440,39 @@ void AdaptiveAlignmentMutualInformation::find_shifts(std::vector<int64_t>& xshif
     mindisorientation[a].resize(maxstoredshifts, std::numeric_limits<float>::max());
   }
 
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  uint64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  uint64_t refposition = 0;
-  uint64_t curposition = 0;
-
   form_features_sections();
 
-  // Allocate a 2D Array which will be reused from slice to slice
-  // second dimension is assigned in each cycle separately
-  std::vector<std::vector<bool>> misorients(dims[0]);
+  notifyStatusMessage(QObject::tr("Aligning Anisotropic Sections || Determining Shifts"));
 
-  const uint64_t halfDim0 = static_cast<uint64_t>(dims[0] * 0.5f);
-  const uint64_t halfDim1 = static_cast<uint64_t>(dims[1] * 0.5f);
-  uint64_t progInt = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  for(uint64_t iter = 1; iter < dims[2]; iter++)
+  // every slice pair is registered independently; the pairs are z-slices 1 ... dims[2] - 1
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    progInt = static_cast<uint64_t>(iter * 100 / static_cast<float>(dims[2]));
-    QString ss = QObject::tr("Aligning Anisotropic Sections || Determining Shifts || %1% Complete").arg(progInt);
-    notifyStatusMessage(ss);
-
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-
-    for(uint64_t i = 0; i < dims[0]; i++)
-    {
-      misorients[i].assign(dims[1], false);
-    }
-
-    while(newxshift[iter][0] != oldxshift || newyshift[iter][0] != oldyshift)
-    {
-      oldxshift = newxshift[iter][0];
-      oldyshift = newyshift[iter][0];
-
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(static_cast<uint64_t>(std::abs(k + oldxshift)) < halfDim0 && static_cast<uint64_t>(std::abs(j + oldyshift)) < halfDim1 && !misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1])
-          {
-            for(uint64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(uint64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if(int64_t((l + j + oldyshift)) >= 0 && (l + j + oldyshift) < dims[1] && int64_t((n + k + oldxshift)) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0.0f)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0.0f)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0.0f)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0.0f)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1] = true;
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, dims[2]), FindMutualInformationShiftsImpl(this, dims, maxstoredshifts, getUsePhaseCorrelation(), miFeatureIds, featurecounts, newxshift, newyshift, mindisorientation),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindMutualInformationShiftsImpl serial(this, dims, maxstoredshifts, getUsePhaseCorrelation(), miFeatureIds, featurecounts, newxshift, newyshift, mindisorientation);
+    serial.compute(1, dims[2]);
+  }
 
-            // compare the new shift with currently stored ones
-            int64_t s = static_cast<int64_t>(maxstoredshifts);
-            while(s - 1 >= 0 && disorientation < mindisorientation[iter][s - 1])
-            {
-              s--;
-            }
+  if(getCancel())
+  {
+    return;
+  }
 
-            // new shift is stored with index 's' in the arrays
-            if(s < static_cast<int64_t>(maxstoredshifts))
-            {
-              // lag the shifts already stored
-              for(int64_t t = maxstoredshifts - 1; t > s; t--)
-              {
-                newxshift[iter][t] = newxshift[iter][t - 1];
-                newyshift[iter][t] = newyshift[iter][t - 1];
-                mindisorientation[iter][t] = mindisorientation[iter][t - 1];
-              }
-              // store the new shift
-              newxshift[iter][s] = k + oldxshift;
-              newyshift[iter][s] = j + oldyshift;
-              mindisorientation[iter][s] = disorientation;
-            }
-          }
-        }
-      }
-    }
+  // compose the cumulative shifts once all slice pairs have been registered
+  for(uint64_t iter = 1; iter < dims[2]; iter++)
+  {
     xshifts[iter] = xshifts[iter - 1] + newxshift[iter][0];
     yshifts[iter] = yshifts[iter - 1] + newyshift[iter][0];
-
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
-    }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
   }
 
   std::vector<uint64_t> curindex(dims[2], 0);
@@ -564,7 +602,7 @@ void AdaptiveAlignmentMutualInformation::find_shifts(std::vector<int64_t>& xshif
     outFile.open(getAlignmentShiftFileName().toLatin1().data());
     for(uint64_t iter = 1; iter < dims[2]; iter++)
     {
-      slice = (dims[2] - 1) - iter;
+      uint64_t slice = (dims[2] - 1) - iter;
       xshifts[iter] = xshifts[iter - 1] + newxshift[iter][curindex[iter]];
       yshifts[iter] = yshifts[iter - 1] + newyshift[iter][curindex[iter]];
       outFile << slice << "	" << slice + 1 << "	" << newxshift[iter][curindex[iter]] << "	" << newyshift[iter][curindex[iter]] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
@@ -13,10 +13,22 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "CombineStlFiles.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputPathFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
@@ -27,6 +39,236 @@
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+/**
+ * @brief The ReadStlFilesImpl class executes a range of independent Read STL File filters, each of
+ * which writes into its own DataContainerArray
+ */
+class ReadStlFilesImpl
+{
+public:
+  ReadStlFilesImpl(AbstractFilter* filter, std::vector<AbstractFilter::Pointer>& readers)
+  : m_Filter(filter)
+  , m_Readers(readers)
+  {
+  }
+  virtual ~ReadStlFilesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      m_Readers[i]->execute();
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  std::vector<AbstractFilter::Pointer>& m_Readers;
+};
+
+/**
+ * @brief The CopyStlGeometriesImpl class copies the triangles, vertices and face normals of a range of
+ * STL geometries into the combined geometry. The offsets of every geometry are computed beforehand, so
+ * each geometry writes to its own block of the combined arrays.
+ */
+class CopyStlGeometriesImpl
+{
+public:
+  CopyStlGeometriesImpl(std::vector<TriangleGeom::Pointer>& stlGeoms, std::vector<DoubleArrayType::Pointer>& faceNormals, std::vector<MeshIndexType>& triOffsets,
+                        std::vector<MeshIndexType>& vertOffsets, MeshIndexType* tris, float* verts, double* normals)
+  : m_StlGeoms(stlGeoms)
+  , m_FaceNormals(faceNormals)
+  , m_TriOffsets(triOffsets)
+  , m_VertOffsets(vertOffsets)
+  , m_Tris(tris)
+  , m_Verts(verts)
+  , m_Normals(normals)
+  {
+  }
+  virtual ~CopyStlGeometriesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      TriangleGeom::Pointer geom = m_StlGeoms[i];
+      MeshIndexType numTris = geom->getNumberOfTris();
+      MeshIndexType* curTris = geom->getTriPointer(0);
+      MeshIndexType* tris = m_Tris + 3 * m_TriOffsets[i];
+      for(MeshIndexType t = 0; t < 3 * numTris; t++)
+      {
+        tris[t] = curTris[t] + m_VertOffsets[i];
+      }
+      std::memcpy(m_Verts + 3 * m_VertOffsets[i], geom->getVertexPointer(0), geom->getNumberOfVertices() * 3 * sizeof(float));
+      std::memcpy(m_Normals + 3 * m_TriOffsets[i], m_FaceNormals[i]->getPointer(0), numTris * 3 * sizeof(double));
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  std::vector<TriangleGeom::Pointer>& m_StlGeoms;
+  std::vector<DoubleArrayType::Pointer>& m_FaceNormals;
+  std::vector<MeshIndexType>& m_TriOffsets;
+  std::vector<MeshIndexType>& m_VertOffsets;
+  MeshIndexType* m_Tris;
+  float* m_Verts;
+  double* m_Normals;
+};
+
+/**
+ * @brief The WeldCell struct stores the integer coordinates of the welding grid cell a vertex falls into
+ */
+struct WeldCell
+{
+  int64_t x;
+  int64_t y;
+  int64_t z;
+  MeshIndexType vertex;
+
+  bool operator<(const WeldCell& other) const
+  {
+    if(x != other.x)
+    {
+      return x < other.x;
+    }
+    if(y != other.y)
+    {
+      return y < other.y;
+    }
+    if(z != other.z)
+    {
+      return z < other.z;
+    }
+    return vertex < other.vertex;
+  }
+};
+
+/**
+ * @brief The FindWeldCellsImpl class assigns each vertex in a range to its welding grid cell
+ */
+class FindWeldCellsImpl
+{
+public:
+  FindWeldCellsImpl(float* verts, float cellSize, std::vector<WeldCell>& cells)
+  : m_Verts(verts)
+  , m_CellSize(cellSize)
+  , m_Cells(cells)
+  {
+  }
+  virtual ~FindWeldCellsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      WeldCell& cell = m_Cells[i];
+      cell.x = static_cast<int64_t>(std::floor(m_Verts[3 * i + 0] / m_CellSize));
+      cell.y = static_cast<int64_t>(std::floor(m_Verts[3 * i + 1] / m_CellSize));
+      cell.z = static_cast<int64_t>(std::floor(m_Verts[3 * i + 2] / m_CellSize));
+      cell.vertex = static_cast<MeshIndexType>(i);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_Verts;
+  float m_CellSize;
+  std::vector<WeldCell>& m_Cells;
+};
+
+/**
+ * @brief The FindWeldTargetsImpl class finds, for each vertex in a range, the lowest indexed vertex that
+ * lies within the welding tolerance. The grid cells are as large as the tolerance, so only the 27 cells
+ * around a vertex need to be searched.
+ */
+class FindWeldTargetsImpl
+{
+public:
+  FindWeldTargetsImpl(float* verts, float tolerance, std::vector<WeldCell>& sortedCells, std::vector<WeldCell>& cells, std::vector<MeshIndexType>& targets)
+  : m_Verts(verts)
+  , m_Tolerance(tolerance)
+  , m_SortedCells(sortedCells)
+  , m_Cells(cells)
+  , m_Targets(targets)
+  {
+  }
+  virtual ~FindWeldTargetsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    float toleranceSquared = m_Tolerance * m_Tolerance;
+    WeldCell key = {0, 0, 0, 0};
+    for(size_t i = start; i < end; i++)
+    {
+      MeshIndexType target = static_cast<MeshIndexType>(i);
+      const float* vert = m_Verts + 3 * i;
+      for(int64_t dx = -1; dx <= 1; dx++)
+      {
+        for(int64_t dy = -1; dy <= 1; dy++)
+        {
+          for(int64_t dz = -1; dz <= 1; dz++)
+          {
+            key.x = m_Cells[i].x + dx;
+            key.y = m_Cells[i].y + dy;
+            key.z = m_Cells[i].z + dz;
+            key.vertex = 0;
+            // vertices within a cell are sorted by index, so the scan stops at the current best target
+            auto iter = std::lower_bound(m_SortedCells.begin(), m_SortedCells.end(), key);
+            for(; iter != m_SortedCells.end() && iter->x == key.x && iter->y == key.y && iter->z == key.z && iter->vertex < target; ++iter)
+            {
+              const float* other = m_Verts + 3 * iter->vertex;
+              float distanceSquared = (vert[0] - other[0]) * (vert[0] - other[0]) + (vert[1] - other[1]) * (vert[1] - other[1]) + (vert[2] - other[2]) * (vert[2] - other[2]);
+              if(distanceSquared <= toleranceSquared)
+              {
+                target = iter->vertex;
+                break;
+              }
+            }
+          }
+        }
+      }
+      m_Targets[i] = target;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_Verts;
+  float m_Tolerance;
+  std::vector<WeldCell>& m_SortedCells;
+  std::vector<WeldCell>& m_Cells;
+  std::vector<MeshIndexType>& m_Targets;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -35,6 +277,8 @@ CombineStlFiles::CombineStlFiles()
 , m_TriangleDataContainerName(SIMPL::Defaults::TriangleDataContainerName)
 , m_FaceAttributeMatrixName(SIMPL::Defaults::FaceAttributeMatrixName)
 , m_FaceNormalsArrayName(SIMPL::FaceData::SurfaceMeshFaceNormals)
+, m_WeldVertices(false)
+, m_WeldingTolerance(1.0e-5f)
 , m_FaceNormals(nullptr)
 , m_FileList(QFileInfoList())
 {
@@ -63,6 +307,9 @@ void CombineStlFiles::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INPUT_PATH_FP("Path to STL Files", StlFilesPath, FilterParameter::Parameter, CombineStlFiles, "", ""));
+  QStringList linkedProps("WeldingTolerance");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Weld Vertices", WeldVertices, FilterParameter::Parameter, CombineStlFiles, linkedProps));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Welding Tolerance", WeldingTolerance, FilterParameter::Parameter, CombineStlFiles));
   parameters.push_back(SIMPL_NEW_STRING_FP("Data Container", TriangleDataContainerName, FilterParameter::CreatedArray, CombineStlFiles));
   parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Face Attribute Matrix", FaceAttributeMatrixName, TriangleDataContainerName, FilterParameter::CreatedArray, CombineStlFiles));
@@ -100,6 +347,12 @@ void CombineStlFiles::dataCheck()
     setErrorCondition(-388, ss);
   }
 
+  if(getWeldVertices() && getWeldingTolerance() <= 0.0f)
+  {
+    QString ss = QObject::tr("The welding tolerance must be greater than 0");
+    setErrorCondition(-389, ss);
+  }
+
   if(getErrorCode() < 0)
   {
     return;
@@ -173,52 +426,81 @@ void CombineStlFiles::execute()
     return;
   }
 
-  DataContainerArray::Pointer dca = DataContainerArray::New();
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
+  // every file gets its own reader and DataContainerArray, so the files can be read concurrently
   FilterManager* fm = FilterManager::Instance();
   IFilterFactory::Pointer factory = fm->getFactoryFromClassName("ReadStlFile");
-  AbstractFilter::Pointer reader = factory->create();
-  reader->setDataContainerArray(dca);
+  std::vector<AbstractFilter::Pointer> readers(m_FileList.size());
+  std::vector<DataContainerArray::Pointer> dcas(m_FileList.size());
 
-  for(auto&& file : m_FileList)
+  for(int32_t i = 0; i < m_FileList.size(); i++)
   {
+    const QFileInfo& file = m_FileList[i];
+    dcas[i] = DataContainerArray::New();
+    readers[i] = factory->create();
+    readers[i]->setDataContainerArray(dcas[i]);
     QVariant var;
     var.setValue(file.canonicalFilePath());
-    reader->setProperty("StlFilePath", var);
+    readers[i]->setProperty("StlFilePath", var);
     var.setValue(file.baseName());
-    reader->setProperty("SurfaceMeshDataContainerName", var);
+    readers[i]->setProperty("SurfaceMeshDataContainerName", var);
     var.setValue(SIMPL::Defaults::FaceAttributeMatrixName);
-    reader->setProperty("FaceAttributeMatrixName", var);
+    readers[i]->setProperty("FaceAttributeMatrixName", var);
     var.setValue(SIMPL::FaceData::SurfaceMeshFaceNormals);
-    reader->setProperty("FaceNormalsArrayName", var);
-    reader->execute();
-    if(reader->getErrorCode() < 0)
+    readers[i]->setProperty("FaceNormalsArrayName", var);
+  }
+
+  notifyStatusMessage(QObject::tr("Reading %1 STL files").arg(m_FileList.size()));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, readers.size()), ReadStlFilesImpl(this, readers), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    ReadStlFilesImpl serial(this, readers);
+    serial.compute(0, readers.size());
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  for(int32_t i = 0; i < m_FileList.size(); i++)
+  {
+    if(readers[i]->getErrorCode() < 0)
     {
-      QString ss = QObject::tr("Error reading STL file: %1").arg(file.fileName());
-      setErrorCondition(reader->getErrorCode(), ss);
+      QString ss = QObject::tr("Error reading STL file: %1").arg(m_FileList[i].fileName());
+      setErrorCondition(readers[i]->getErrorCode(), ss);
       return;
     }
   }
 
-  std::list<TriangleGeom::Pointer> stlGeoms;
-  std::list<DoubleArrayType::Pointer> faceNormals;
-  auto containers = dca->getDataContainers();
+  std::vector<TriangleGeom::Pointer> stlGeoms(m_FileList.size());
+  std::vector<DoubleArrayType::Pointer> faceNormals(m_FileList.size());
+  std::vector<MeshIndexType> triOffsets(m_FileList.size(), 0);
+  std::vector<MeshIndexType> vertOffsets(m_FileList.size(), 0);
+  MeshIndexType totalTriangles = 0;
+  MeshIndexType totalVertices = 0;
   DataArrayPath path;
 
-  for(auto&& container : containers)
+  for(int32_t i = 0; i < m_FileList.size(); i++)
   {
-    stlGeoms.push_back(container->getGeometryAs<TriangleGeom>());
+    DataContainer::Pointer container = dcas[i]->getDataContainer(m_FileList[i].baseName());
+    stlGeoms[i] = container->getGeometryAs<TriangleGeom>();
     path.update(container->getName(), SIMPL::Defaults::FaceAttributeMatrixName, "");
-    faceNormals.push_back(container->getAttributeMatrix(path)->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceNormals));
-  }
-
-  int64_t totalTriangles = 0;
-  int64_t totalVertices = 0;
-
-  for(auto&& geom : stlGeoms)
-  {
-    totalTriangles += geom->getNumberOfTris();
-    totalVertices += geom->getNumberOfVertices();
+    faceNormals[i] = container->getAttributeMatrix(path)->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceNormals);
+    triOffsets[i] = totalTriangles;
+    vertOffsets[i] = totalVertices;
+    totalTriangles += stlGeoms[i]->getNumberOfTris();
+    totalVertices += stlGeoms[i]->getNumberOfVertices();
   }
 
   TriangleGeom::Pointer combined = getDataContainerArray()->getDataContainer(m_TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
@@ -227,41 +509,152 @@ void CombineStlFiles::execute()
   combined->resizeTriList(totalTriangles);
   combined->resizeVertexList(totalVertices);
   faceAttrmat->resizeAttributeArrays(tDims);
-  MeshIndexType triOffset = 0;
-  MeshIndexType vertOffset = 0;
-  MeshIndexType triCounter = 0;
-  MeshIndexType* tris = combined->getTriPointer(0);
-  float* verts = combined->getVertexPointer(0);
+  m_FaceNormals = faceAttrmat->getAttributeArrayAs<DoubleArrayType>(m_FaceNormalsArrayName)->getPointer(0);
 
-  for(auto&& geom : stlGeoms)
+  CopyStlGeometriesImpl copyImpl(stlGeoms, faceNormals, triOffsets, vertOffsets, combined->getTriPointer(0), combined->getVertexPointer(0), m_FaceNormals);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    MeshIndexType* curTris = geom->getTriPointer(0);
-    for(MeshIndexType t = 0; t < geom->getNumberOfTris(); t++)
-    {
-      curTris[3 * t + 0] += triCounter;
-      curTris[3 * t + 1] += triCounter;
-      curTris[3 * t + 2] += triCounter;
-    }
-    triCounter += geom->getNumberOfVertices();
-    float* curVerts = geom->getVertexPointer(0);
-    std::memcpy(tris + triOffset, curTris, geom->getNumberOfTris() * 3 * sizeof(MeshIndexType));
-    std::memcpy(verts + vertOffset, curVerts, geom->getNumberOfVertices() * 3 * sizeof(float));
-    triOffset += geom->getNumberOfTris() * 3;
-    vertOffset += geom->getNumberOfVertices() * 3;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, stlGeoms.size()), copyImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    copyImpl.compute(0, stlGeoms.size());
   }
 
-  size_t faceNormalsOffset = 0;
-  m_FaceNormals = faceAttrmat->getAttributeArrayAs<DoubleArrayType>(m_FaceNormalsArrayName)->getPointer(0);
+  // the per file containers are no longer needed
+  stlGeoms.clear();
+  faceNormals.clear();
+  dcas.clear();
+  readers.clear();
 
-  for(auto&& dataArray : faceNormals)
+  if(getWeldVertices())
   {
-    std::memcpy(m_FaceNormals + faceNormalsOffset, dataArray->getPointer(0), dataArray->getSize() * sizeof(double));
-    faceNormalsOffset += dataArray->getSize();
+    weldVertices(combined, faceAttrmat);
   }
 
   notifyStatusMessage("Complete");
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CombineStlFiles::weldVertices(TriangleGeom::Pointer triangleGeom, AttributeMatrix::Pointer faceAttrMat)
+{
+  notifyStatusMessage("Welding vertices");
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  MeshIndexType numVerts = triangleGeom->getNumberOfVertices();
+  MeshIndexType numTris = triangleGeom->getNumberOfTris();
+  float* verts = triangleGeom->getVertexPointer(0);
+  MeshIndexType* tris = triangleGeom->getTriPointer(0);
+
+  std::vector<WeldCell> cells(numVerts);
+  std::vector<MeshIndexType> targets(numVerts);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numVerts), FindWeldCellsImpl(verts, m_WeldingTolerance, cells), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindWeldCellsImpl serial(verts, m_WeldingTolerance, cells);
+    serial.compute(0, numVerts);
+  }
+
+  std::vector<WeldCell> sortedCells(cells);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_sort(sortedCells.begin(), sortedCells.end());
+  }
+  else
+#endif
+  {
+    std::sort(sortedCells.begin(), sortedCells.end());
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numVerts), FindWeldTargetsImpl(verts, m_WeldingTolerance, sortedCells, cells, targets), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindWeldTargetsImpl serial(verts, m_WeldingTolerance, sortedCells, cells, targets);
+    serial.compute(0, numVerts);
+  }
+
+  cells.clear();
+  sortedCells.clear();
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // targets always have a lower index, so resolving chains in ascending order makes every vertex
+  // point directly at the first vertex of its chain; the kept vertices are then renumbered in order
+  MeshIndexType numWelded = 0;
+  for(MeshIndexType v = 0; v < numVerts; v++)
+  {
+    if(targets[v] == v)
+    {
+      targets[v] = numWelded;
+      std::memmove(verts + 3 * numWelded, verts + 3 * v, 3 * sizeof(float));
+      numWelded++;
+    }
+    else
+    {
+      targets[v] = targets[targets[v]];
+    }
+  }
+
+  // remap the triangles and drop the ones that collapsed onto an edge or a point
+  DoubleArrayType::Pointer normalsPtr = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(m_FaceNormalsArrayName);
+  double* normals = normalsPtr->getPointer(0);
+  MeshIndexType numKept = 0;
+  for(MeshIndexType t = 0; t < numTris; t++)
+  {
+    MeshIndexType v0 = targets[tris[3 * t + 0]];
+    MeshIndexType v1 = targets[tris[3 * t + 1]];
+    MeshIndexType v2 = targets[tris[3 * t + 2]];
+    if(v0 == v1 || v1 == v2 || v0 == v2)
+    {
+      continue;
+    }
+    tris[3 * numKept + 0] = v0;
+    tris[3 * numKept + 1] = v1;
+    tris[3 * numKept + 2] = v2;
+    normals[3 * numKept + 0] = normals[3 * t + 0];
+    normals[3 * numKept + 1] = normals[3 * t + 1];
+    normals[3 * numKept + 2] = normals[3 * t + 2];
+    numKept++;
+  }
+
+  triangleGeom->resizeVertexList(numWelded);
+  triangleGeom->resizeTriList(numKept);
+  std::vector<size_t> tDims(1, numKept);
+  faceAttrMat->resizeAttributeArrays(tDims);
+  m_FaceNormals = normalsPtr->getPointer(0);
+
+  QString ss = QObject::tr("Welded %1 vertices into %2, removed %3 collapsed triangles").arg(numVerts).arg(numWelded).arg(numTris - numKept);
+  notifyStatusMessage(ss);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
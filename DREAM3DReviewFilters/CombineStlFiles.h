@@ -17,7 +17,9 @@
 #include <QDir>
 
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/SIMPLib.h"
 
 /**
@@ -46,6 +48,12 @@ public:
   SIMPL_FILTER_PARAMETER(QString, FaceNormalsArrayName)
   Q_PROPERTY(QString FaceNormalsArrayName READ getFaceNormalsArrayName WRITE setFaceNormalsArrayName)
 
+  SIMPL_FILTER_PARAMETER(bool, WeldVertices)
+  Q_PROPERTY(bool WeldVertices READ getWeldVertices WRITE setWeldVertices)
+
+  SIMPL_FILTER_PARAMETER(float, WeldingTolerance)
+  Q_PROPERTY(float WeldingTolerance READ getWeldingTolerance WRITE setWeldingTolerance)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -142,6 +150,14 @@ protected:
   */
   void initialize();
 
+  /**
+   * @brief weldVertices Merges all vertices of the combined geometry that lie within the welding
+   * tolerance of each other and removes the triangles that collapse as a result
+   * @param triangleGeom Combined triangle geometry
+   * @param faceAttrMat Face Attribute Matrix of the combined geometry
+   */
+  void weldVertices(TriangleGeom::Pointer triangleGeom, AttributeMatrix::Pointer faceAttrMat);
+
 private:
   DEFINE_DATAARRAY_VARIABLE(double, FaceNormals);
 
@@ -36,6 +36,17 @@
 
 #include "DiscretizeDDDomain.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
@@ -46,9 +57,9 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/EdgeGeom.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
-#include "SIMPLib/Math/GeometryMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "DREAM3DReview/DREAM3DReviewFilters/util/DislocationLengthTracer.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -60,6 +71,68 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+// Edges are traced in fixed size chunks, independent of the number of threads, and a batch of chunks is
+// traced before its contributions are summed
+const size_t k_EdgesPerChunk = 1024;
+const size_t k_ChunksPerBatch = 64;
+
+using LengthContribution = std::pair<size_t, float>;
+
+/**
+ * @brief The TraceEdgesImpl class traces the edges of a range of chunks through the grid. Each chunk records
+ * the lengths it adds to the cells in edge order, so summing the chunks in order reproduces the serial sums
+ * for any number of threads.
+ */
+class TraceEdgesImpl
+{
+  const DislocationLengthTracer& m_Tracer;
+  const float* m_Nodes;
+  const MeshIndexType* m_Edges;
+  size_t m_FirstEdge;
+  size_t m_EndEdge;
+  std::vector<std::vector<LengthContribution>>& m_Contributions;
+
+public:
+  TraceEdgesImpl(const DislocationLengthTracer& tracer, const float* nodes, const MeshIndexType* edges, size_t firstEdge, size_t endEdge,
+                 std::vector<std::vector<LengthContribution>>& contributions)
+  : m_Tracer(tracer)
+  , m_Nodes(nodes)
+  , m_Edges(edges)
+  , m_FirstEdge(firstEdge)
+  , m_EndEdge(endEdge)
+  , m_Contributions(contributions)
+  {
+  }
+  virtual ~TraceEdgesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      std::vector<LengthContribution>& contributions = m_Contributions[chunk];
+      contributions.clear();
+      size_t edgeStart = m_FirstEdge + chunk * k_EdgesPerChunk;
+      size_t edgeEnd = std::min(edgeStart + k_EdgesPerChunk, m_EndEdge);
+      for(size_t i = edgeStart; i < edgeEnd; i++)
+      {
+        const float* point1 = m_Nodes + 3 * m_Edges[2 * i + 0];
+        const float* point2 = m_Nodes + 3 * m_Edges[2 * i + 1];
+        m_Tracer.trace(point1, point2, [&](size_t point, float length) { contributions.emplace_back(point, length); });
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -202,7 +275,7 @@ void DiscretizeDDDomain::dataCheck()
   // Get the name and create the array in the new data attrMat
   std::vector<size_t> dims(1, 1);
   tempPath.update(getOutputDataContainerName().getDataContainerName(), getOutputAttributeMatrixName(), getOutputArrayName());
-  m_OutputArrayPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, dims, "", DataArrayID31);
+  m_OutputArrayPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims, "", DataArrayID31);
   if(nullptr != m_OutputArrayPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
   {
     m_OutputArray = m_OutputArrayPtr.lock()->getPointer(0);
@@ -288,10 +361,6 @@ void DiscretizeDDDomain::execute()
   halfCellSize[0] = (m_CellSize[0] / 2.0);
   halfCellSize[1] = (m_CellSize[1] / 2.0);
   halfCellSize[2] = (m_CellSize[2] / 2.0);
-  FloatVec3Type quarterCellSize;
-  quarterCellSize[0] = (m_CellSize[0] / 4.0);
-  quarterCellSize[1] = (m_CellSize[1] / 4.0);
-  quarterCellSize[2] = (m_CellSize[2] / 4.0);
 
   vdc->getGeometryAs<ImageGeom>()->setOrigin(FloatVec3Type(xMin, yMin, zMin));
   size_t dcDims[3];
@@ -307,94 +376,52 @@ void DiscretizeDDDomain::execute()
   tDims[2] = dcDims[2];
   cellAttrMat->resizeAttributeArrays(tDims);
 
-  float point1[3], point2[3], corner1[3], corner2[3];
-  size_t xCellMin, xCellMax;
-  size_t yCellMin, yCellMax;
-  size_t zCellMin, zCellMax;
-  float x1, y1, z1, x2, y2, z2;
-  size_t zStride, yStride, point;
-  int system = 0;
-  float length;
-  for(size_t i = 0; i < numEdges; i++)
+  if(nullptr != m_OutputArrayPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
   {
-    point1[0] = nodes[3 * edge[2 * i + 0] + 0];
-    point1[1] = nodes[3 * edge[2 * i + 0] + 1];
-    point1[2] = nodes[3 * edge[2 * i + 0] + 2];
-    point2[0] = nodes[3 * edge[2 * i + 1] + 0];
-    point2[1] = nodes[3 * edge[2 * i + 1] + 1];
-    point2[2] = nodes[3 * edge[2 * i + 1] + 2];
-    x1 = (point1[0] - xMin);
-    y1 = (point1[1] - yMin);
-    z1 = (point1[2] - zMin);
-    x2 = (point2[0] - xMin);
-    y2 = (point2[1] - yMin);
-    z2 = (point2[2] - zMin);
-    if(x1 > x2)
-    {
-      xCellMin = size_t(x2 / quarterCellSize[0]), xCellMax = size_t(x1 / quarterCellSize[0]);
-    }
-    else
-    {
-      xCellMin = size_t(x1 / quarterCellSize[0]), xCellMax = size_t(x2 / quarterCellSize[0]);
-    }
-    if(y1 > y2)
-    {
-      yCellMin = size_t(y2 / quarterCellSize[1]), yCellMax = size_t(y1 / quarterCellSize[1]);
-    }
-    else
+    m_OutputArray = m_OutputArrayPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  m_OutputArrayPtr.lock()->initializeWithZeros();
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  float origin[3] = {xMin, yMin, zMin};
+  DislocationLengthTracer tracer(origin, halfCellSize.data(), dcDims);
+
+  std::vector<std::vector<LengthContribution>> contributions(k_ChunksPerBatch);
+  for(size_t batchStart = 0; batchStart < numEdges; batchStart += k_EdgesPerChunk * k_ChunksPerBatch)
+  {
+    if(getCancel())
     {
-      yCellMin = size_t(y1 / quarterCellSize[1]), yCellMax = size_t(y2 / quarterCellSize[1]);
+      return;
     }
-    if(z1 > z2)
+
+    size_t batchEnd = std::min(batchStart + k_EdgesPerChunk * k_ChunksPerBatch, static_cast<size_t>(numEdges));
+    size_t numChunks = (batchEnd - batchStart + k_EdgesPerChunk - 1) / k_EdgesPerChunk;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      zCellMin = size_t(z2 / quarterCellSize[2]), zCellMax = size_t(z1 / quarterCellSize[2]);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), TraceEdgesImpl(tracer, nodes, edge, batchStart, batchEnd, contributions), tbb::simple_partitioner());
     }
     else
+#endif
     {
-      zCellMin = size_t(z1 / quarterCellSize[2]), zCellMax = size_t(z2 / quarterCellSize[2]);
-    }
-    xCellMin = (xCellMin - 1) / 2;
-    yCellMin = (yCellMin - 1) / 2;
-    zCellMin = (zCellMin - 1) / 2;
-    xCellMax = ((xCellMax - 1) / 2) + 1;
-    yCellMax = ((yCellMax - 1) / 2) + 1;
-    zCellMax = ((zCellMax - 1) / 2) + 1;
-    if(xCellMax >= tDims[0])
-    {
-      xCellMax = tDims[0] - 1;
-    }
-    if(yCellMax >= tDims[1])
-    {
-      yCellMax = tDims[1] - 1;
-    }
-    if(zCellMax >= tDims[2])
-    {
-      zCellMax = tDims[2] - 1;
+      TraceEdgesImpl serial(tracer, nodes, edge, batchStart, batchEnd, contributions);
+      serial.compute(0, numChunks);
     }
-    for(size_t j = zCellMin; j <= zCellMax; j++)
+
+    for(size_t c = 0; c < numChunks; c++)
     {
-      zStride = j * tDims[0] * tDims[1];
-      corner1[2] = (j * halfCellSize[2]) - halfCellSize[2] + quarterCellSize[2] + zMin;
-      corner2[2] = (j * halfCellSize[2]) + halfCellSize[2] + quarterCellSize[2] + zMin;
-      for(size_t k = yCellMin; k <= yCellMax; k++)
+      for(const LengthContribution& contribution : contributions[c])
       {
-        yStride = k * tDims[0];
-        corner1[1] = (k * halfCellSize[1]) - halfCellSize[1] + quarterCellSize[1] + yMin;
-        corner2[1] = (k * halfCellSize[1]) + halfCellSize[1] + quarterCellSize[1] + yMin;
-        for(size_t l = xCellMin; l <= xCellMax; l++)
-        {
-          corner1[0] = (l * halfCellSize[0]) - halfCellSize[0] + quarterCellSize[0] + xMin;
-          corner2[0] = (l * halfCellSize[0]) + halfCellSize[0] + quarterCellSize[0] + xMin;
-          length = GeometryMath::LengthOfRayInBox(point1, point2, corner1, corner2);
-          point = (zStride + yStride + l);
-          m_OutputArray[14 * point + 0] += length;
-          m_OutputArray[14 * point + system] += length;
-        }
+        m_OutputArray[contribution.first] += contribution.second;
       }
     }
   }
 
-  float max = 0.0;
+  size_t zStride, yStride, point;
   float cellVolume = m_CellSize[0] * m_CellSize[1] * m_CellSize[2];
   for(size_t j = 0; j < tDims[2]; j++)
   {
@@ -405,17 +432,9 @@ void DiscretizeDDDomain::execute()
       for(size_t l = 0; l < tDims[0]; l++)
       {
         point = (zStride + yStride + l);
-        // take care of total density first before looping over all systems
-        m_OutputArray[14 * point] /= cellVolume;
+        m_OutputArray[point] /= cellVolume;
         // convert to m/mm^3 from um/um^3
-        m_OutputArray[14 * point] *= 1.0E12f;
-        max = 0.0;
-        for(int iter = 1; iter < 14; iter++)
-        {
-          m_OutputArray[14 * point + iter] /= cellVolume;
-          // convert to m/mm^3 from um/um^3
-          m_OutputArray[14 * point + iter] *= 1.0E12f;
-        }
+        m_OutputArray[point] *= 1.0E12f;
       }
     }
   }
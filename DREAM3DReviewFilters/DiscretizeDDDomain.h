@@ -178,7 +178,7 @@ protected:
   void initialize();
 
 private:
-  DEFINE_DATAARRAY_VARIABLE(int32_t, OutputArray)
+  DEFINE_DATAARRAY_VARIABLE(float, OutputArray)
 
 public:
   DiscretizeDDDomain(const DiscretizeDDDomain&) = delete;            // Copy Constructor Not Implemented
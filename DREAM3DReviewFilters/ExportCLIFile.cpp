@@ -13,14 +13,28 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ExportCLIFile.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <map>
+#include <string>
+#include <vector>
 
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
+#include <QtCore/QtEndian>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
 
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
@@ -35,6 +49,184 @@
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+namespace
+{
+// binary CLI command indices, see the Common Layer Interface specification
+const quint16 k_StartLayerLong = 127;
+const quint16 k_StartHatchesLong = 132;
+
+// layers are formatted in batches of about this many edges before they are written
+const int64_t k_EdgesPerBatch = 1 << 20;
+
+/**
+ * @brief AppendFixed Appends value in fixed point notation with precision digits after the decimal
+ * point. Values whose scaled magnitude does not fit a 64 bit integer fall back to QByteArray::number.
+ */
+void AppendFixed(std::string& out, double value, int32_t precision)
+{
+  static const double k_Powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+
+  double scaled = (precision <= 18) ? value * k_Powers[precision] : 0.0;
+  if(precision > 18 || !(std::fabs(scaled) < 9.0e18))
+  {
+    QByteArray number = QByteArray::number(value, 'f', precision);
+    out.append(number.constData(), static_cast<size_t>(number.size()));
+    return;
+  }
+
+  // ties round to even, like the standard fixed point conversions
+  int64_t rounded = static_cast<int64_t>(std::nearbyint(scaled));
+  uint64_t magnitude = static_cast<uint64_t>(rounded < 0 ? -rounded : rounded);
+  char buffer[48];
+  char* pos = buffer + sizeof(buffer);
+  for(int32_t i = 0; i < precision; i++)
+  {
+    *--pos = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  }
+  if(precision > 0)
+  {
+    *--pos = '.';
+  }
+  do
+  {
+    *--pos = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while(magnitude != 0);
+  if(rounded < 0)
+  {
+    *--pos = '-';
+  }
+  out.append(pos, static_cast<size_t>(buffer + sizeof(buffer) - pos));
+}
+
+template <typename T>
+void AppendBinary(std::string& out, T value)
+{
+  uchar bytes[sizeof(T)];
+  qToLittleEndian<T>(value, bytes);
+  out.append(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+void AppendBinary(std::string& out, float value)
+{
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(float));
+  AppendBinary<uint32_t>(out, bits);
+}
+
+/**
+ * @brief The FormatCLILayersImpl class formats the layers of one group into separate byte buffers,
+ * so that consecutive layers can be formatted concurrently and then written in order. The edges of
+ * every layer are given in compressed row form: layer j of the batch holds layerEdges[layerOffsets[j]]
+ * up to layerEdges[layerOffsets[j + 1]].
+ */
+class FormatCLILayersImpl
+{
+public:
+  FormatCLILayersImpl(const MeshIndexType* edges, const float* vertices, const int64_t* layerOffsets, const MeshIndexType* layerEdges, double unitsScaleFactor, int32_t precision, bool binary,
+                      std::vector<std::string>& buffers, std::vector<int64_t>& badEdges)
+  : m_Edges(edges)
+  , m_Vertices(vertices)
+  , m_LayerOffsets(layerOffsets)
+  , m_LayerEdges(layerEdges)
+  , m_UnitsScaleFactor(unitsScaleFactor)
+  , m_Precision(precision)
+  , m_Binary(binary)
+  , m_Buffers(buffers)
+  , m_BadEdges(badEdges)
+  {
+  }
+  virtual ~FormatCLILayersImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t j = start; j < end; j++)
+    {
+      std::string& out = m_Buffers[j];
+      out.clear();
+      m_BadEdges[j] = -1;
+      int64_t first = m_LayerOffsets[j];
+      int64_t count = m_LayerOffsets[j + 1] - first;
+      if(count == 0)
+      {
+        continue;
+      }
+
+      float layerHeight = m_Vertices[3 * m_Edges[2 * m_LayerEdges[first] + 0] + 2];
+      double scaledHeight = static_cast<double>(layerHeight) / m_UnitsScaleFactor;
+      if(m_Binary)
+      {
+        out.reserve(static_cast<size_t>(16 + 16 * count));
+        AppendBinary<quint16>(out, k_StartLayerLong);
+        AppendBinary(out, static_cast<float>(scaledHeight));
+        AppendBinary<quint16>(out, k_StartHatchesLong);
+        AppendBinary<int32_t>(out, 1);
+        AppendBinary<int32_t>(out, static_cast<int32_t>(count));
+      }
+      else
+      {
+        out.reserve(static_cast<size_t>(32 + 4 * (m_Precision + 6) * count));
+        out.append("$$LAYER/");
+        AppendFixed(out, scaledHeight, m_Precision);
+        out.append("\n$$HATCHES/1,");
+        out.append(std::to_string(count));
+      }
+
+      for(int64_t k = first; k < first + count; k++)
+      {
+        MeshIndexType hatch = m_LayerEdges[k];
+        const float* start = m_Vertices + 3 * m_Edges[2 * hatch + 0];
+        const float* end = m_Vertices + 3 * m_Edges[2 * hatch + 1];
+        // heights are compared unscaled, so the check does not depend on the units scale factor
+        if(!SIMPLibMath::closeEnough(static_cast<double>(start[2]), static_cast<double>(layerHeight)) || !SIMPLibMath::closeEnough(static_cast<double>(end[2]), static_cast<double>(layerHeight)))
+        {
+          m_BadEdges[j] = static_cast<int64_t>(hatch);
+          break;
+        }
+
+        double coords[4] = {start[0] / m_UnitsScaleFactor, start[1] / m_UnitsScaleFactor, end[0] / m_UnitsScaleFactor, end[1] / m_UnitsScaleFactor};
+        for(double coord : coords)
+        {
+          if(m_Binary)
+          {
+            AppendBinary(out, static_cast<float>(coord));
+          }
+          else
+          {
+            out.push_back(',');
+            AppendFixed(out, coord, m_Precision);
+          }
+        }
+      }
+
+      if(!m_Binary)
+      {
+        out.append("\n\n");
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const MeshIndexType* m_Edges;
+  const float* m_Vertices;
+  const int64_t* m_LayerOffsets;
+  const MeshIndexType* m_LayerEdges;
+  double m_UnitsScaleFactor;
+  int32_t m_Precision;
+  bool m_Binary;
+  std::vector<std::string>& m_Buffers;
+  std::vector<int64_t>& m_BadEdges;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -47,6 +239,7 @@ ExportCLIFile::ExportCLIFile()
 , m_OutputFilePrefix("")
 , m_UnitsScaleFactor(1.0)
 , m_Precision(5)
+, m_WriteBinary(false)
 , m_LayerIds(nullptr)
 , m_GroupIds(nullptr)
 {
@@ -78,6 +271,7 @@ void ExportCLIFile::setupFilterParameters()
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Units Scale Factor", UnitsScaleFactor, FilterParameter::Parameter, ExportCLIFile));
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Precision (places after decimal)", Precision, FilterParameter::Parameter, ExportCLIFile));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Write Binary CLI", WriteBinary, FilterParameter::Parameter, ExportCLIFile));
   parameters.push_back(SIMPL_NEW_OUTPUT_PATH_FP("Output File Directory", OutputDirectory, FilterParameter::Parameter, ExportCLIFile));
   parameters.push_back(SIMPL_NEW_STRING_FP("Output File Prefix", OutputFilePrefix, FilterParameter::Parameter, ExportCLIFile));
   QStringList linkedProps = {"GroupIdsArrayPath"};
@@ -212,6 +406,12 @@ void ExportCLIFile::execute()
 
   for(MeshIndexType i = 0; i < numEdges; i++)
   {
+    if(m_LayerIds[i] < 0 || (m_SplitByGroup && m_GroupIds[i] < 0))
+    {
+      QString ss = QObject::tr("Found Edge (%1) with a negative layer or group id").arg(i);
+      setErrorCondition(-1, ss);
+      return;
+    }
     if(m_SplitByGroup)
     {
       if(m_GroupIds[i] > numGroups)
@@ -243,88 +443,126 @@ void ExportCLIFile::execute()
   numGroups++;
   numLayers++;
 
-  QVector<std::shared_ptr<QFile>> files;
-  for(auto i = 0; i < numGroups; i++)
-  {
-    QString fname = m_OutputDirectory + "/" + m_OutputFilePrefix + "Group" + QString::number(i + 1) + ".cli";
-    std::shared_ptr<QFile> filePtr = std::make_shared<QFile>(fname);
-    filePtr->open(QIODevice::WriteOnly | QIODevice::Text);
-    files.push_back(filePtr);
-  }
-
-  for(auto&& f : files)
-  {
-    QString header = "$$HEADERSTART\n"
-                     "$$ASCII\n"
-                     "$$UNITS/" +
-                     QString::number(m_UnitsScaleFactor, 'f', m_Precision) + "\n"
-                                                                             "$$HEADEREND\n"
-                                                                             "$$GEOMETRYSTART\n"
-                                                                             "\n"
-                                                                             "$$LAYER/0.00000\n"
-                                                                             "\n";
-
-    QTextStream out(f.get());
-    out << header;
-  }
-
-  using GroupLayerTable = std::vector<std::vector<std::vector<int64_t>>>;
-  using LayerTable = std::vector<std::vector<int64_t>>;
-  GroupLayerTable table(numGroups, LayerTable(numLayers));
-  Int32ArrayType::Pointer groups = Int32ArrayType::CreateArray(numEdges, "_INTERNAL_USE_ONLY_GroupIds", false);
-  int32_t* groupIds = nullptr;
-  if(m_SplitByGroup)
+  // group the edges by group and layer in compressed row form, keeping their order within each layer
+  std::vector<int64_t> layerOffsets(static_cast<size_t>(numGroups) * numLayers + 1, 0);
+  for(MeshIndexType i = 0; i < numEdges; i++)
   {
-    groupIds = m_GroupIds;
+    int32_t group = m_SplitByGroup ? m_GroupIds[i] : 1;
+    layerOffsets[static_cast<size_t>(group) * numLayers + m_LayerIds[i] + 1]++;
   }
-  else
+  for(size_t i = 1; i < layerOffsets.size(); i++)
   {
-    groups->allocate();
-    groups->initializeWithValue(1);
-    groupIds = groups->getPointer(0);
+    layerOffsets[i] += layerOffsets[i - 1];
   }
-  for(MeshIndexType i = 0; i < numEdges; i++)
+  std::vector<MeshIndexType> layerEdges(numEdges);
   {
-    table[groupIds[i]][m_LayerIds[i]].push_back(i);
+    std::vector<int64_t> next(layerOffsets.begin(), layerOffsets.end() - 1);
+    for(MeshIndexType i = 0; i < numEdges; i++)
+    {
+      int32_t group = m_SplitByGroup ? m_GroupIds[i] : 1;
+      layerEdges[next[static_cast<size_t>(group) * numLayers + m_LayerIds[i]]++] = i;
+    }
   }
 
-  for(auto i = 0; i < numGroups; i++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  std::vector<std::string> buffers;
+  std::vector<int64_t> badEdges;
+  for(int32_t i = 0; i < numGroups; i++)
   {
-    QFile* file = files[i].get();
-    QTextStream out(file);
-    for(auto j = 0; j < numLayers; j++)
+    QString fname = m_OutputDirectory + "/" + m_OutputFilePrefix + "Group" + QString::number(i + 1) + ".cli";
+    QFile file(fname);
+    if(!file.open(m_WriteBinary ? QIODevice::WriteOnly : (QIODevice::WriteOnly | QIODevice::Text)))
+    {
+      QString ss = QObject::tr("Error opening output file '%1'").arg(fname);
+      setErrorCondition(-11111, ss);
+      return;
+    }
+
+    QString header;
+    if(m_WriteBinary)
     {
-      if(!table[i][j].empty())
+      // the binary geometry section starts directly after $$HEADEREND
+      header = "$$HEADERSTART\n"
+               "$$BINARY\n"
+               "$$UNITS/" +
+               QString::number(m_UnitsScaleFactor, 'f', m_Precision) + "\n$$HEADEREND";
+      std::string layerZero;
+      AppendBinary<quint16>(layerZero, k_StartLayerLong);
+      AppendBinary(layerZero, 0.0f);
+      file.write(header.toLatin1());
+      file.write(layerZero.data(), static_cast<qint64>(layerZero.size()));
+    }
+    else
+    {
+      header = "$$HEADERSTART\n"
+               "$$ASCII\n"
+               "$$UNITS/" +
+               QString::number(m_UnitsScaleFactor, 'f', m_Precision) + "\n"
+                                                                       "$$HEADEREND\n"
+                                                                       "$$GEOMETRYSTART\n"
+                                                                       "\n"
+                                                                       "$$LAYER/0.00000\n"
+                                                                       "\n";
+      file.write(header.toLatin1());
+    }
+
+    // the layers are formatted concurrently in batches and written in layer order, so only one
+    // batch of formatted text is held in memory at a time
+    const int64_t* groupOffsets = layerOffsets.data() + static_cast<size_t>(i) * numLayers;
+    for(int32_t batchStart = 0; batchStart < numLayers;)
+    {
+      if(getCancel())
       {
-        double layerHeight = static_cast<double>(vertices[3 * edges[2 * table[i][j].front() + 0] + 2]);
-        QString layerStr = "$$LAYER/" + QString::number(layerHeight / m_UnitsScaleFactor, 'f', m_Precision) + "\n";
-        out << layerStr;
-        QString hatchStr = "$$HATCHES/1," + QString::number(table[i][j].size()) + ",";
-        for(auto&& hatch : table[i][j])
-        {
-          double zStart = static_cast<double>(vertices[3 * edges[2 * hatch + 0] + 2] / m_UnitsScaleFactor);
-          double zEnd = static_cast<double>(vertices[3 * edges[2 * hatch + 1] + 2] / m_UnitsScaleFactor);
-          if(!SIMPLibMath::closeEnough(zStart, layerHeight) || !SIMPLibMath::closeEnough(zEnd, layerHeight))
-          {
-            QString ss = QObject::tr("Found Edge (%1) that spans multipe layers").arg(hatch);
-            setErrorCondition(-1, ss);
-            return;
-          }
+        return;
+      }
+
+      int32_t batchEnd = batchStart + 1;
+      while(batchEnd < numLayers && groupOffsets[batchEnd] - groupOffsets[batchStart] < k_EdgesPerBatch)
+      {
+        batchEnd++;
+      }
+      size_t batchSize = static_cast<size_t>(batchEnd - batchStart);
+      buffers.resize(std::max(buffers.size(), batchSize));
+      badEdges.resize(buffers.size());
 
-          double xStart = static_cast<double>(vertices[3 * edges[2 * hatch + 0] + 0] / m_UnitsScaleFactor);
-          double yStart = static_cast<double>(vertices[3 * edges[2 * hatch + 0] + 1] / m_UnitsScaleFactor);
-          double xEnd = static_cast<double>(vertices[3 * edges[2 * hatch + 1] + 0] / m_UnitsScaleFactor);
-          double yEnd = static_cast<double>(vertices[3 * edges[2 * hatch + 1] + 1] / m_UnitsScaleFactor);
-          hatchStr += (QString::number(xStart, 'f', m_Precision) + "," + QString::number(yStart, 'f', m_Precision) + "," + QString::number(xEnd, 'f', m_Precision) + "," +
-                       QString::number(yEnd, 'f', m_Precision) + ",");
+      FormatCLILayersImpl impl(edges, vertices, groupOffsets + batchStart, layerEdges.data(), m_UnitsScaleFactor, m_Precision, m_WriteBinary, buffers, badEdges);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, batchSize), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.compute(0, batchSize);
+      }
+
+      for(size_t j = 0; j < batchSize; j++)
+      {
+        if(badEdges[j] >= 0)
+        {
+          QString ss = QObject::tr("Found Edge (%1) that spans multipe layers").arg(badEdges[j]);
+          setErrorCondition(-1, ss);
+          return;
+        }
+        if(file.write(buffers[j].data(), static_cast<qint64>(buffers[j].size())) != static_cast<qint64>(buffers[j].size()))
+        {
+          QString ss = QObject::tr("Error writing output file '%1'").arg(fname);
+          setErrorCondition(-11112, ss);
+          return;
         }
-        hatchStr.chop(1);
-        hatchStr += "\n\n";
-        out << hatchStr;
       }
+      batchStart = batchEnd;
+    }
+
+    if(!m_WriteBinary)
+    {
+      file.write("$$GEOMETRYEND\n");
     }
-    QString footer = "$$GEOMETRYEND\n";
-    out << footer;
   }
 
   notifyStatusMessage("Complete");
@@ -56,6 +56,9 @@ public:
   SIMPL_FILTER_PARAMETER(int, Precision)
   Q_PROPERTY(int Precision READ getPrecision WRITE setPrecision)
 
+  SIMPL_FILTER_PARAMETER(bool, WriteBinary)
+  Q_PROPERTY(bool WriteBinary READ getWriteBinary WRITE setWriteBinary)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
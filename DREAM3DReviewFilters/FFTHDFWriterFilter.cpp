@@ -4,6 +4,8 @@
 
 #include "FFTHDFWriterFilter.h"
 
+#include <algorithm>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -12,6 +14,8 @@
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/H5FilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
@@ -19,6 +23,7 @@
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
+#include "H5Support/H5Lite.h"
 #include "H5Support/H5ScopedSentinel.h"
 #include "H5Support/QH5Lite.h"
 #include "H5Support/QH5Utilities.h"
@@ -62,8 +67,15 @@ FFTHDFWriterFilter::FFTHDFWriterFilter()
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_CellEulerAnglesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::EulerAngles)
+, m_ChunkDatasets(false)
+, m_CompressionLevel(0)
+, m_ShuffleData(true)
 , m_FileId(-1)
 {
+  // z-slab chunks by default, which matches the slice by slice input stage of the FFT solver
+  m_ChunkDimensions[0] = 0;
+  m_ChunkDimensions[1] = 0;
+  m_ChunkDimensions[2] = 1;
 }
 
 // -----------------------------------------------------------------------------
@@ -84,6 +96,11 @@ void FFTHDFWriterFilter::setupFilterParameters()
   parameters.push_back(OutputFileFilterParameter::New("Output File", "OutputFile", getOutputFile(), FilterParameter::Parameter, SIMPL_BIND_SETTER(FFTHDFWriterFilter, this, OutputFile),
                                                       SIMPL_BIND_GETTER(FFTHDFWriterFilter, this, OutputFile), "*.dream3d", ""));
   //  parameters.push_back(BooleanFilterParameter::New("Write Xdmf File", "WriteXdmfFile", getWriteXdmfFile(), FilterParameter::Parameter, "ParaView Compatible File"));
+  QStringList linkedProps = {"ChunkDimensions", "CompressionLevel", "ShuffleData"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Chunk Datasets", ChunkDatasets, FilterParameter::Parameter, FFTHDFWriterFilter, linkedProps));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Chunk Dimensions (0 = Full Extent)", ChunkDimensions, FilterParameter::Parameter, FFTHDFWriterFilter));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Compression Level (0-9)", CompressionLevel, FilterParameter::Parameter, FFTHDFWriterFilter));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Shuffle Data", ShuffleData, FilterParameter::Parameter, FFTHDFWriterFilter));
   //--------------
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -115,6 +132,10 @@ void FFTHDFWriterFilter::readFilterParameters(AbstractFilterParametersReader* re
 {
   reader->openFilterGroup(this, index);
   setOutputFile(reader->readString("OutputFile", getOutputFile()));
+  setChunkDatasets(reader->readValue("ChunkDatasets", getChunkDatasets()));
+  setChunkDimensions(reader->readIntVec3("ChunkDimensions", getChunkDimensions()));
+  setCompressionLevel(reader->readValue("CompressionLevel", getCompressionLevel()));
+  setShuffleData(reader->readValue("ShuffleData", getShuffleData()));
   //----------------------------
   setCellEulerAnglesArrayPath(reader->readDataArrayPath("CellEulerAnglesArrayPath", getCellEulerAnglesArrayPath()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
@@ -141,6 +162,25 @@ void FFTHDFWriterFilter::dataCheck()
   }
   FileSystemPathHelper::CheckOutputFile(this, "Output File Name", getOutputFile(), true);
 
+  if(getChunkDatasets())
+  {
+    if(getChunkDimensions()[0] < 0 || getChunkDimensions()[1] < 0 || getChunkDimensions()[2] < 0)
+    {
+      ss = QObject::tr("The chunk dimensions must be 0 (full extent) or positive");
+      setErrorCondition(-11113, ss);
+    }
+    if(getCompressionLevel() < 0 || getCompressionLevel() > 9)
+    {
+      ss = QObject::tr("The compression level must be between 0 (no compression) and 9");
+      setErrorCondition(-11114, ss);
+    }
+    else if(getCompressionLevel() > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+    {
+      ss = QObject::tr("The HDF5 library does not provide the deflate filter needed for compression");
+      setErrorCondition(-11115, ss);
+    }
+  }
+
   QVector<DataArrayPath> dataArrayPaths;
 
   std::vector<size_t> cDims(1, 1);
@@ -249,16 +289,22 @@ void FFTHDFWriterFilter::execute()
 
   AttributeMatrix::Pointer attrMat = getDataContainerArray()->getAttributeMatrix(m_FeatureIdsArrayPath);
   std::vector<size_t> tDims = attrMat->getTupleDimensions();
-  m_FeatureIdsPtr.lock()->writeH5Data(dcaGid, tDims);
+  err = writeDataArray<int32_t>(dcaGid, *m_FeatureIdsPtr.lock(), tDims);
   //     H5Lite::writePointerDataset;
 
-  attrMat = getDataContainerArray()->getAttributeMatrix(m_CellPhasesArrayPath);
-  tDims = attrMat->getTupleDimensions();
-  m_CellPhasesPtr.lock()->writeH5Data(dcaGid, tDims);
+  if(err >= 0)
+  {
+    attrMat = getDataContainerArray()->getAttributeMatrix(m_CellPhasesArrayPath);
+    tDims = attrMat->getTupleDimensions();
+    err = writeDataArray<int32_t>(dcaGid, *m_CellPhasesPtr.lock(), tDims);
+  }
 
-  attrMat = getDataContainerArray()->getAttributeMatrix(m_CellEulerAnglesArrayPath);
-  tDims = attrMat->getTupleDimensions();
-  m_CellEulerAnglesPtr.lock()->writeH5Data(dcaGid, tDims);
+  if(err >= 0)
+  {
+    attrMat = getDataContainerArray()->getAttributeMatrix(m_CellEulerAnglesArrayPath);
+    tDims = attrMat->getTupleDimensions();
+    err = writeDataArray<float>(dcaGid, *m_CellEulerAnglesPtr.lock(), tDims);
+  }
 
   // DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
 
@@ -274,6 +320,120 @@ void FFTHDFWriterFilter::execute()
   //       dcaGid = -1;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+herr_t FFTHDFWriterFilter::writeDataArray(hid_t parentId, DataArray<T>& array, const std::vector<size_t>& tDims)
+{
+  if(!m_ChunkDatasets)
+  {
+    int32_t err = array.writeH5Data(parentId, tDims);
+    if(err < 0)
+    {
+      QString ss = QObject::tr("Error writing dataset '%1'").arg(array.getName());
+      setErrorCondition(-11116, ss);
+    }
+    return err;
+  }
+
+  // the dataset has the same layout as written by DataArray::writeH5Data: the tuple dimensions,
+  // slowest first, followed by the component dimensions
+  std::vector<size_t> cDims = array.getComponentDimensions();
+  std::vector<hsize_t> h5Dims;
+  std::vector<hsize_t> chunkDims;
+  for(size_t i = tDims.size(); i > 0; i--)
+  {
+    size_t chunk = (i <= 3 && m_ChunkDimensions[i - 1] > 0) ? static_cast<size_t>(m_ChunkDimensions[i - 1]) : tDims[i - 1];
+    h5Dims.push_back(tDims[i - 1]);
+    chunkDims.push_back(std::max<hsize_t>(1, std::min(chunk, tDims[i - 1])));
+  }
+  for(auto&& cDim : cDims)
+  {
+    h5Dims.push_back(cDim);
+    chunkDims.push_back(std::max<hsize_t>(1, cDim));
+  }
+
+  // HDF5 limits a single chunk to 4 GB
+  uint64_t chunkBytes = sizeof(T);
+  for(auto&& chunkDim : chunkDims)
+  {
+    chunkBytes *= chunkDim;
+  }
+  if(chunkBytes >= (static_cast<uint64_t>(1) << 32))
+  {
+    QString ss = QObject::tr("The chunks of dataset '%1' would exceed the HDF5 limit of 4 GB; reduce the chunk dimensions").arg(array.getName());
+    setErrorCondition(-11117, ss);
+    return -1;
+  }
+
+  hid_t dataType = H5Lite::HDFTypeForPrimType(static_cast<T>(0));
+  hid_t spaceId = H5Screate_simple(static_cast<int32_t>(h5Dims.size()), h5Dims.data(), nullptr);
+  hid_t propertyId = H5Pcreate(H5P_DATASET_CREATE);
+  herr_t err = (spaceId < 0 || propertyId < 0) ? -1 : H5Pset_chunk(propertyId, static_cast<int32_t>(chunkDims.size()), chunkDims.data());
+  if(err >= 0 && m_CompressionLevel > 0)
+  {
+    // shuffling the bytes of each value before deflating usually compresses numeric data much better
+    if(m_ShuffleData)
+    {
+      err = H5Pset_shuffle(propertyId);
+    }
+    if(err >= 0)
+    {
+      err = H5Pset_deflate(propertyId, static_cast<uint32_t>(m_CompressionLevel));
+    }
+  }
+
+  hid_t datasetId = -1;
+  if(err >= 0)
+  {
+    datasetId = H5Dcreate(parentId, array.getName().toLatin1().data(), dataType, spaceId, H5P_DEFAULT, propertyId, H5P_DEFAULT);
+    err = (datasetId < 0) ? -1 : H5Dwrite(datasetId, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, array.getVoidPointer(0));
+  }
+
+  if(datasetId >= 0)
+  {
+    H5Dclose(datasetId);
+  }
+  if(propertyId >= 0)
+  {
+    H5Pclose(propertyId);
+  }
+  if(spaceId >= 0)
+  {
+    H5Sclose(spaceId);
+  }
+
+  // the same attributes DataArray::writeH5Data attaches, so the file reads back as DREAM.3D data
+  if(err >= 0)
+  {
+    hsize_t rank = tDims.size();
+    std::vector<uint64_t> values(tDims.begin(), tDims.end());
+    err = QH5Lite::writePointerAttribute<uint64_t>(parentId, array.getName(), SIMPL::HDF5::TupleDimensions, 1, &rank, values.data());
+    if(err >= 0)
+    {
+      rank = cDims.size();
+      values.assign(cDims.begin(), cDims.end());
+      err = QH5Lite::writePointerAttribute<uint64_t>(parentId, array.getName(), SIMPL::HDF5::ComponentDimensions, 1, &rank, values.data());
+    }
+    if(err >= 0)
+    {
+      err = QH5Lite::writeScalarAttribute(parentId, array.getName(), SIMPL::HDF5::DataArrayVersion, array.getClassVersion());
+    }
+    if(err >= 0)
+    {
+      err = QH5Lite::writeStringAttribute(parentId, array.getName(), SIMPL::HDF5::ObjectType, array.getNameOfClass());
+    }
+  }
+
+  if(err < 0)
+  {
+    QString ss = QObject::tr("Error writing dataset '%1'").arg(array.getName());
+    setErrorCondition(-11116, ss);
+  }
+  return err;
+}
+
 //--------------------------------------------------------------
 
 void FFTHDFWriterFilter::writeXdmfHeader(QTextStream& xdmf)
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <vector>
+
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/CoreFilters/FileWriter.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
 
@@ -23,6 +27,10 @@ class DREAM3DReview_EXPORT FFTHDFWriterFilter : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath CellEulerAnglesArrayPath READ getCellEulerAnglesArrayPath WRITE setCellEulerAnglesArrayPath)
+  PYB11_PROPERTY(bool ChunkDatasets READ getChunkDatasets WRITE setChunkDatasets)
+  PYB11_PROPERTY(IntVec3Type ChunkDimensions READ getChunkDimensions WRITE setChunkDimensions)
+  PYB11_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
+  PYB11_PROPERTY(bool ShuffleData READ getShuffleData WRITE setShuffleData)
 
 public:
   SIMPL_SHARED_POINTERS(FFTHDFWriterFilter)
@@ -48,6 +56,18 @@ public:
   SIMPL_FILTER_PARAMETER(DataArrayPath, CellEulerAnglesArrayPath)
   Q_PROPERTY(DataArrayPath CellEulerAnglesArrayPath READ getCellEulerAnglesArrayPath WRITE setCellEulerAnglesArrayPath)
 
+  SIMPL_FILTER_PARAMETER(bool, ChunkDatasets)
+  Q_PROPERTY(bool ChunkDatasets READ getChunkDatasets WRITE setChunkDatasets)
+
+  SIMPL_FILTER_PARAMETER(IntVec3Type, ChunkDimensions)
+  Q_PROPERTY(IntVec3Type ChunkDimensions READ getChunkDimensions WRITE setChunkDimensions)
+
+  SIMPL_FILTER_PARAMETER(int, CompressionLevel)
+  Q_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
+
+  SIMPL_FILTER_PARAMETER(bool, ShuffleData)
+  Q_PROPERTY(bool ShuffleData READ getShuffleData WRITE setShuffleData)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -163,6 +183,17 @@ protected:
    */
   int writePipeline();
 
+  /**
+   * @brief writeDataArray Writes a cell array below the given group, chunked and compressed
+   * according to the filter parameters when chunking is enabled
+   * @param parentId HDF5 group to write into
+   * @param array Array to write
+   * @param tDims Tuple dimensions of the array
+   * @return Integer error value
+   */
+  template <typename T>
+  herr_t writeDataArray(hid_t parentId, DataArray<T>& array, const std::vector<size_t>& tDims);
+
   /**
    * @brief writeXdmfHeader Writes the Xdmf header
    * @param out QTextStream for output
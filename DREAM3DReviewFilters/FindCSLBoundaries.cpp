@@ -37,9 +37,13 @@
 
 #include "FindCSLBoundaries.h"
 
+#include <algorithm>
+#include <vector>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
 #include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
 #endif
@@ -73,130 +77,241 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID32 = 32,
 };
 
-class CalculateCSLBoundaryImpl
+namespace
+{
+/**
+ * @brief The CSLMatch struct holds one symmetric variant of a misorientation that lies within the CSL
+ * tolerances: the symmetry operator that takes the face normal into the crystal frame of the variant, and
+ * the misorientation axis of the variant
+ */
+struct CSLMatch
+{
+  QuatF symQuat;
+  float axis[3];
+};
+
+/**
+ * @brief The CSLPairMatches struct holds the CSL matches of an ordered (feature1, feature2) pair, along
+ * with the orientation matrix of feature1, which takes the face normals into its crystal frame
+ */
+struct CSLPairMatches
+{
+  float g1[3][3];
+  std::vector<CSLMatch> matches;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t MakePairKey(int32_t feature1, int32_t feature2)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(feature1)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(feature2));
+}
+
+/**
+ * @brief The FindCSLPairMatchesImpl class runs the symmetry loops for each unique pair of features that
+ * share a face. Whether a face is a CSL boundary only depends on the orientations of its features, so
+ * this is done once per pair instead of once per face.
+ */
+class FindCSLPairMatchesImpl
 {
   int m_CSLIndex;
   float m_AxisTol;
   float m_AngTol;
-  int32_t* m_Labels;
-  double* m_Normals;
+  const std::vector<uint64_t>& m_PairKeys;
   int32_t* m_Phases;
   float* m_Quats;
-  bool* m_CSLBoundary;
-  float* m_CSLBoundaryIncoherence;
   unsigned int* m_CrystalStructures;
+  std::vector<CSLPairMatches>& m_PairMatches;
   QVector<LaueOps::Pointer> m_OrientationOps;
 
 public:
-  CalculateCSLBoundaryImpl(int cslindex, float angtol, float axistol, int32_t* Labels, double* Normals, float* Quats, int32_t* Phases, unsigned int* CrystalStructures, bool* CSLBoundary,
-                           float* CSLBoundaryIncoherence)
+  FindCSLPairMatchesImpl(int cslindex, float angtol, float axistol, const std::vector<uint64_t>& pairKeys, float* Quats, int32_t* Phases, unsigned int* CrystalStructures,
+                         std::vector<CSLPairMatches>& pairMatches)
   : m_CSLIndex(cslindex)
   , m_AxisTol(axistol)
   , m_AngTol(angtol)
-  , m_Labels(Labels)
-  , m_Normals(Normals)
+  , m_PairKeys(pairKeys)
   , m_Phases(Phases)
   , m_Quats(Quats)
-  , m_CSLBoundary(CSLBoundary)
-  , m_CSLBoundaryIncoherence(CSLBoundaryIncoherence)
   , m_CrystalStructures(CrystalStructures)
+  , m_PairMatches(pairMatches)
   {
     m_OrientationOps = LaueOps::getOrientationOpsQVector();
   }
 
-  virtual ~CalculateCSLBoundaryImpl() = default;
+  virtual ~FindCSLPairMatchesImpl() = default;
 
   void generate(size_t start, size_t end) const
   {
-    int feature1, feature2;
-    float normal[3];
-    float g1[3][3];
-    float w;
-    unsigned int phase1, phase2;
     QuatF q1;
     QuatF q2;
-    float axisdiffCSL, angdiffCSL;
-    float n[3];
-    float incoherence;
-    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-
     QuatF misq;
     QuatF sym_q;
+    QuatF sym_j;
     QuatF s1_misq;
     QuatF s2_misq;
     QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+    float axisdiffCSL, angdiffCSL;
+    float w;
 
-    float xstl_norm[3], s_xstl_norm[3], cslAxisNorm[3];
+    // the orientation transforms work on these stack buffers, so the symmetry loops do not allocate
+    float quBuffer[4];
+    float axBuffer[4];
+    float omBuffer[9];
+    FOrientArrayType qu(quBuffer, 4);
+    FOrientArrayType ax(axBuffer, 4);
+    FOrientArrayType om(omBuffer, 9);
+
+    float cslAxisNorm[3];
     float cslAxisNormDenom = 0.0f;
     cslAxisNormDenom =
         sqrtf(TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][2] + TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][3] + TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][4]);
     for(int i = 0; i < 3; ++i)
     {
       cslAxisNorm[i] = TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][i + 2] / cslAxisNormDenom;
-    };
+    }
+
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t feature1 = static_cast<int32_t>(m_PairKeys[i] >> 32);
+      int32_t feature2 = static_cast<int32_t>(m_PairKeys[i] & 0xFFFFFFFFULL);
+      CSLPairMatches& pairMatches = m_PairMatches[i];
+      pairMatches.matches.clear();
+
+      unsigned int phase1 = m_CrystalStructures[m_Phases[feature1]];
+      unsigned int phase2 = m_CrystalStructures[m_Phases[feature2]];
+      if(phase1 != phase2)
+      {
+        continue;
+      }
+
+      QuaternionMathF::Copy(quats[feature1], q1);
+      QuaternionMathF::Copy(quats[feature2], q2);
+      QuaternionMathF::Conjugate(q2);
+      QuaternionMathF::Multiply(q1, q2, misq);
+
+      quBuffer[0] = q1.x;
+      quBuffer[1] = q1.y;
+      quBuffer[2] = q1.z;
+      quBuffer[3] = q1.w;
+      FOrientTransformsType::qu2om(qu, om);
+      om.toGMatrix(pairMatches.g1);
+
+      int nsym = m_OrientationOps[phase1]->getNumSymOps();
+      for(int j = 0; j < nsym; j++)
+      {
+        m_OrientationOps[phase1]->getQuatSymOp(j, sym_j);
+        QuaternionMathF::Multiply(misq, sym_j, s1_misq);
+        for(int k = 0; k < nsym; k++)
+        {
+          // calculate the symmetric misorienation
+          m_OrientationOps[phase1]->getQuatSymOp(k, sym_q);
+          QuaternionMathF::Conjugate(sym_q);
+          QuaternionMathF::Multiply(sym_q, s1_misq, s2_misq);
+
+          quBuffer[0] = s2_misq.x;
+          quBuffer[1] = s2_misq.y;
+          quBuffer[2] = s2_misq.z;
+          quBuffer[3] = s2_misq.w;
+          FOrientTransformsType::qu2ax(qu, ax);
+          w = axBuffer[3] * 180.0 / SIMPLib::Constants::k_Pi;
+          axisdiffCSL = acosf(fabs(axBuffer[0]) * cslAxisNorm[0] + fabs(axBuffer[1]) * cslAxisNorm[1] + fabs(axBuffer[2]) * cslAxisNorm[2]);
+          angdiffCSL = fabs(w - TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][1]);
+          if(axisdiffCSL < m_AxisTol && angdiffCSL < m_AngTol)
+          {
+            CSLMatch match;
+            QuaternionMathF::Copy(sym_j, match.symQuat);
+            match.axis[0] = axBuffer[0];
+            match.axis[1] = axBuffer[1];
+            match.axis[2] = axBuffer[2];
+            pairMatches.matches.push_back(match);
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+} // namespace
+
+/**
+ * @brief The CalculateCSLBoundaryImpl class flags the faces whose feature pair has CSL matches, and computes
+ * the incoherence of each such face from its normal
+ */
+class CalculateCSLBoundaryImpl
+{
+  int32_t* m_Labels;
+  double* m_Normals;
+  const std::vector<uint64_t>& m_PairKeys;
+  const std::vector<CSLPairMatches>& m_PairMatches;
+  bool* m_CSLBoundary;
+  float* m_CSLBoundaryIncoherence;
+
+public:
+  CalculateCSLBoundaryImpl(int32_t* Labels, double* Normals, const std::vector<uint64_t>& pairKeys, const std::vector<CSLPairMatches>& pairMatches, bool* CSLBoundary, float* CSLBoundaryIncoherence)
+  : m_Labels(Labels)
+  , m_Normals(Normals)
+  , m_PairKeys(pairKeys)
+  , m_PairMatches(pairMatches)
+  , m_CSLBoundary(CSLBoundary)
+  , m_CSLBoundaryIncoherence(CSLBoundaryIncoherence)
+  {
+  }
+
+  virtual ~CalculateCSLBoundaryImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    int feature1, feature2;
+    float normal[3];
+    float n[3];
+    float incoherence;
+    QuatF sym_q;
+    float xstl_norm[3], s_xstl_norm[3];
+
     for(size_t i = start; i < end; i++)
     {
       feature1 = m_Labels[2 * i];
       feature2 = m_Labels[2 * i + 1];
-      normal[0] = m_Normals[3 * i];
-      normal[1] = m_Normals[3 * i + 1];
-      normal[2] = m_Normals[3 * i + 2];
       // different than Find Twin Boundaries here because will only compare if
       // the features are different phases
       if(feature1 > 0 && feature2 > 0) // && m_Phases[feature1] != m_Phases[feature2])
       {
-        w = 10000.0;
-
-        QuaternionMathF::Copy(quats[feature1], q1);
-        QuaternionMathF::Copy(quats[feature2], q2);
+        auto pair = std::lower_bound(m_PairKeys.begin(), m_PairKeys.end(), MakePairKey(feature1, feature2));
+        const CSLPairMatches& pairMatches = m_PairMatches[static_cast<size_t>(pair - m_PairKeys.begin())];
+        if(pairMatches.matches.empty())
+        {
+          continue;
+        }
 
-        phase1 = m_CrystalStructures[m_Phases[feature1]];
-        phase2 = m_CrystalStructures[m_Phases[feature2]];
-        if(phase1 == phase2)
+        normal[0] = m_Normals[3 * i];
+        normal[1] = m_Normals[3 * i + 1];
+        normal[2] = m_Normals[3 * i + 2];
+        MatrixMath::Multiply3x3with3x1(pairMatches.g1, normal, xstl_norm);
+        m_CSLBoundary[i] = true;
+        for(const CSLMatch& match : pairMatches.matches)
         {
-          int nsym = m_OrientationOps[phase1]->getNumSymOps();
-          QuaternionMathF::Conjugate(q2);
-          QuaternionMathF::Multiply(q1, q2, misq);
-          FOrientArrayType om(9);
-          FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-          om.toGMatrix(g1);
-          MatrixMath::Multiply3x3with3x1(g1, normal, xstl_norm);
-          for(int j = 0; j < nsym; j++)
+          // calculate crystal direction parallel to normal
+          QuaternionMathF::Copy(match.symQuat, sym_q);
+          QuaternionMathF::MultiplyQuatVec(sym_q, xstl_norm, s_xstl_norm);
+          n[0] = match.axis[0];
+          n[1] = match.axis[1];
+          n[2] = match.axis[2];
+          incoherence = 180.0 * acos(GeometryMath::CosThetaBetweenVectors(n, s_xstl_norm)) / SIMPLib::Constants::k_Pi;
+          if(incoherence > 90.0)
           {
-            m_OrientationOps[phase1]->getQuatSymOp(j, sym_q);
-            // calculate crystal direction parallel to normal
-            QuaternionMathF::Multiply(misq, sym_q, s1_misq);
-            QuaternionMathF::MultiplyQuatVec(sym_q, xstl_norm, s_xstl_norm);
-            for(int k = 0; k < nsym; k++)
-            {
-              // calculate the symmetric misorienation
-              m_OrientationOps[phase1]->getQuatSymOp(k, sym_q);
-              QuaternionMathF::Conjugate(sym_q);
-              QuaternionMathF::Multiply(sym_q, s1_misq, s2_misq);
-
-              FOrientArrayType ax(4);
-              FOrientTransformsType::qu2ax(FOrientArrayType(s2_misq), ax);
-              ax.toAxisAngle(n1, n2, n3, w);
-              w = w * 180.0 / SIMPLib::Constants::k_Pi;
-              axisdiffCSL = acosf(fabs(n1) * cslAxisNorm[0] + fabs(n2) * cslAxisNorm[1] + fabs(n3) * cslAxisNorm[2]);
-              angdiffCSL = fabs(w - TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][1]);
-              if(axisdiffCSL < m_AxisTol && angdiffCSL < m_AngTol)
-              {
-                n[0] = n1;
-                n[1] = n2;
-                n[2] = n3;
-                m_CSLBoundary[i] = true;
-                incoherence = 180.0 * acos(GeometryMath::CosThetaBetweenVectors(n, s_xstl_norm)) / SIMPLib::Constants::k_Pi;
-                if(incoherence > 90.0)
-                {
-                  incoherence = 180.0 - incoherence;
-                }
-                if(incoherence < m_CSLBoundaryIncoherence[i])
-                {
-                  m_CSLBoundaryIncoherence[i] = incoherence;
-                }
-              }
-            }
+            incoherence = 180.0 - incoherence;
+          }
+          if(incoherence < m_CSLBoundaryIncoherence[i])
+          {
+            m_CSLBoundaryIncoherence[i] = incoherence;
           }
         }
       }
@@ -417,19 +532,63 @@ void FindCSLBoundaries::execute()
   float angtol = m_AngleTolerance;
   float axistol = static_cast<float>(m_AxisTolerance * M_PI / 180.0f);
 
+  // Collect the unique (ordered) feature pairs of the faces; meshes typically have far fewer pairs than faces
+  std::vector<uint64_t> pairKeys;
+  pairKeys.reserve(numTriangles);
+  for(int64_t i = 0; i < numTriangles; i++)
+  {
+    if(m_SurfaceMeshFaceLabels[2 * i] > 0 && m_SurfaceMeshFaceLabels[2 * i + 1] > 0)
+    {
+      pairKeys.push_back(MakePairKey(m_SurfaceMeshFaceLabels[2 * i], m_SurfaceMeshFaceLabels[2 * i + 1]));
+    }
+  }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_sort(pairKeys.begin(), pairKeys.end());
+  }
+  else
+#endif
+  {
+    std::sort(pairKeys.begin(), pairKeys.end());
+  }
+  pairKeys.erase(std::unique(pairKeys.begin(), pairKeys.end()), pairKeys.end());
+  std::vector<CSLPairMatches> pairMatches(pairKeys.size());
+
+  if(getCancel())
+  {
+    return;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pairKeys.size()),
+                      FindCSLPairMatchesImpl(cslindex, angtol, axistol, pairKeys, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, pairMatches), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindCSLPairMatchesImpl serial(cslindex, angtol, axistol, pairKeys, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, pairMatches);
+    serial.generate(0, pairKeys.size());
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel)
   {
     tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateCSLBoundaryImpl(cslindex, angtol, axistol, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceMeshCSLBoundary,
-                                               m_SurfaceMeshCSLBoundaryIncoherence),
+                      CalculateCSLBoundaryImpl(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, pairKeys, pairMatches, m_SurfaceMeshCSLBoundary, m_SurfaceMeshCSLBoundaryIncoherence),
                       tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateCSLBoundaryImpl serial(cslindex, angtol, axistol, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceMeshCSLBoundary,
-                                    m_SurfaceMeshCSLBoundaryIncoherence);
+    CalculateCSLBoundaryImpl serial(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, pairKeys, pairMatches, m_SurfaceMeshCSLBoundary, m_SurfaceMeshCSLBoundaryIncoherence);
     serial.generate(0, numTriangles);
   }
 
@@ -36,8 +36,8 @@
 #include "MicReader.h"
 
 #include <algorithm>
+#include <limits>
 
-#include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -46,6 +46,8 @@
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
 
+#include "DREAM3DReview/DREAM3DReviewFilters/util/TextParsing.hpp"
+
 #include "MicConstants.h"
 
 #ifdef _MSC_VER
@@ -301,7 +303,6 @@ int MicReader::readHeaderOnly()
   m_PhaseVector.clear();
 
   m_CurrentPhase = MicPhase::New();
-  m_PhaseVector.push_back(m_CurrentPhase);
 
   QFileInfo fi(getFileName());
 
@@ -316,7 +317,7 @@ int MicReader::readHeaderOnly()
     name = parentPath + QDir::separator() + name + ".config";
   }
 
-  QFile inHeader(getFileName());
+  QFile inHeader(name);
   if(!inHeader.open(QIODevice::ReadOnly | QIODevice::Text))
   {
     QString msg = QString("HEDM .config file could not be opened: ") + name;
@@ -426,122 +427,43 @@ int MicReader::readFile()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int MicReader::readMicFile()
+int MicReader::readPhaseInfo()
 {
+  m_PhaseVector.clear();
 
-  QFile in(getFileName());
-  if(!in.open(QIODevice::ReadOnly | QIODevice::Text))
+  // Read the .config file
+  int err = readHeaderOnly();
+  if(err < 0)
   {
-    QString msg = QObject::tr("Mic file could not be opened: %1").arg(getFileName());
-    setErrorMessage(msg);
-    setErrorCode(-113);
-    return -113;
+    return err;
   }
 
-  // Delete any currently existing pointers
-  deletePointers();
-  // Initialize new pointers
-  size_t totalDataRows = 0;
-  size_t totalPossibleDataRows = 0;
-  //  size_t featuresRead = 0;
-  float origEdgeLength;
-  float xMax = 0, yMax = 0;
-  float xMin = 1000000000, yMin = 1000000000;
-  float xMinUM, yMinUM;
-  int32_t counter = 0;
-  bool ok = false;
-  QByteArray buf;
-
-  // Read the First line in the file which is the edge length
-  buf = in.readLine();
-  origEdgeLength = buf.toFloat(&ok);
-
-  // Read the first line of actual data which we then derive the actual number of data rows
-  buf = in.readLine();
-  parseDataLine(buf, 0);
-
-  int level = m_Level[0];
-  float newEdgeLength = origEdgeLength / powf(2.0, float(level));
-  totalPossibleDataRows = static_cast<size_t>(6.0f * powf(4.0f, float(level)));
-
-  // Reinitialize the pointers that hold the data to the proper size
-  initPointers(totalPossibleDataRows);
-
-  // Reparse the first data line to get those values into the new arrays
-  parseDataLine(buf, 0);
+  // Read the .dat file
+  return readDatFile();
+}
 
-  buf = in.readLine();
-  ++counter;
-  for(size_t i = 1; i < totalPossibleDataRows; ++i)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::readMicFile()
+{
+  MicSlice slice;
+  QString msg;
+  int err = ReadMicSlice(getFileName(), false, slice, msg);
+  if(err < 0)
   {
-    parseDataLine(buf, i);
-    buf = in.readLine();
-
-    ++counter;
-    if(in.atEnd())
-    {
-      break;
-    }
+    setErrorMessage(msg);
+    setErrorCode(err);
+    return err;
   }
-  totalDataRows = counter;
 
-  std::vector<float> EA1(totalDataRows, 0.0);
-  std::vector<float> EA2(totalDataRows, 0.0);
-  std::vector<float> EA3(totalDataRows, 0.0);
-  std::vector<float> confidence(totalDataRows, 0.0);
-  std::vector<int> phase(totalDataRows, 0);
-  std::vector<int> up(totalDataRows, 0);
-  std::vector<float> xVal(totalDataRows, 0.0);
-  std::vector<float> yVal(totalDataRows, 0.0);
-  float constant = static_cast<float>(1.0f / (2.0 * sqrt(3.0)));
-  float x, y;
-  for(size_t i = 0; i < totalDataRows; ++i)
-  {
-    if(m_Up[i] == 1)
-    {
-      x = m_X[i] + (newEdgeLength / 2.0f);
-      y = m_Y[i] + (constant * newEdgeLength);
-    }
-    if(m_Up[i] == 2)
-    {
-      x = m_X[i] + (newEdgeLength / 2.0f);
-      y = m_Y[i] - (constant * newEdgeLength);
-    }
-    if(x > xMax)
-    {
-      xMax = x;
-    }
-    if(y > yMax)
-    {
-      yMax = y;
-    }
-    if(x < xMin)
-    {
-      xMin = x;
-    }
-    if(y < yMin)
-    {
-      yMin = y;
-    }
-    EA1[i] = m_Euler1[i];
-    EA2[i] = m_Euler2[i];
-    EA3[i] = m_Euler3[i];
-    confidence[i] = m_Conf[i];
-    phase[i] = m_Phase[i];
-    up[i] = m_Up[i];
-    xVal[i] = m_X[i];
-    yVal[i] = m_Y[i];
-  }
-  xMin = xMin - (2.0 * newEdgeLength);
-  xMax = xMax + (2.0 * newEdgeLength);
-  yMin = yMin - (2.0 * newEdgeLength);
-  yMax = yMax + (2.0 * newEdgeLength);
-  xDim = int((xMax - xMin) / newEdgeLength) + 1;
-  yDim = int((yMax - yMin) / newEdgeLength) + 1;
+  float newEdgeLength = slice.edgeLength;
+  xDim = int((slice.xMax - slice.xMin) / newEdgeLength) + 1;
+  yDim = int((slice.yMax - slice.yMin) / newEdgeLength) + 1;
   xRes = newEdgeLength * 1000.0f;
   yRes = newEdgeLength * 1000.0f;
-  xMinUM = xMin * 1000.0f;
-  yMinUM = xMin * 1000.0f;
+  float xMinUM = slice.xMin * 1000.0f;
+  float yMinUM = slice.yMin * 1000.0f;
 
   EbsdHeaderEntry::Pointer xDimHeader = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::XDim, xDim);
   m_HeaderMap[Mic::XDim] = xDimHeader;
@@ -560,51 +482,139 @@ int MicReader::readMicFile()
   // Resize pointers
   initPointers(xDim * yDim);
 
-  float xA = 0.0f, xB = 0.0f, xC = 0.0f, yA = 0.0f, yB = 0.0f, yC = 0.0f;
-  int point = 0;
-  float root3over2 = sqrtf(3.0f) / 2.0f;
-  int check1 = 0, check2 = 0, check3 = 0;
-  for(size_t i = 0; i < totalDataRows; ++i)
+  RasterizeMicSlice(slice, slice.xMin, slice.yMin, static_cast<size_t>(xDim), static_cast<size_t>(yDim), [&](size_t point, size_t j, size_t k, const MicTriangle& triangle) {
+    m_Euler1[point] = triangle.euler[0];
+    m_Euler2[point] = triangle.euler[1];
+    m_Euler3[point] = triangle.euler[2];
+    m_Conf[point] = triangle.conf;
+    m_Phase[point] = triangle.phase;
+    m_X[point] = float(j) * xRes + xMinUM;
+    m_Y[point] = float(k) * yRes + yMinUM;
+  });
+
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::ReadMicSlice(const QString& fileName, bool boundsOnly, MicSlice& slice, QString& errorMessage)
+{
+  slice = MicSlice();
+
+  QFile in(fileName);
+  if(!in.open(QIODevice::ReadOnly))
   {
-    xA = xVal[i] - xMin;
-    xB = xA + newEdgeLength;
-    xC = xA + (newEdgeLength / 2.0f);
-    if(up[i] == 1)
-    {
-      yA = yVal[i] - yMin;
-      yB = yA;
-      yC = yA + (root3over2 * newEdgeLength);
-    }
-    if(up[i] == 2)
+    errorMessage = QObject::tr("Mic file could not be opened: %1").arg(fileName);
+    return -113;
+  }
+
+  qint64 fileSize = in.size();
+  QByteArray contents;
+  uchar* mapped = in.map(0, fileSize);
+  const char* data = reinterpret_cast<const char*>(mapped);
+  if(nullptr == mapped)
+  {
+    contents = in.readAll();
+    data = contents.constData();
+  }
+  const char* end = data + fileSize;
+
+  /* The first line holds the edge length of the level 0 triangles. Each following line holds
+   * x, y, z, up, level, good, phi1, phi, phi2 and the confidence, followed by columns that are
+   * not used here.
+   */
+  int err = 0;
+  float origEdgeLength = 0.0f;
+  const char* pos = data;
+  if(!TextParsing::ParseFloat(pos, end, origEdgeLength) || origEdgeLength <= 0.0f)
+  {
+    errorMessage = QObject::tr("Unable to parse the edge length from the first line of Mic file %1").arg(fileName);
+    err = -114;
+  }
+
+  float constant = static_cast<float>(1.0f / (2.0 * sqrt(3.0)));
+  float xMax = std::numeric_limits<float>::lowest();
+  float yMax = std::numeric_limits<float>::lowest();
+  float xMin = std::numeric_limits<float>::max();
+  float yMin = std::numeric_limits<float>::max();
+  int firstLevel = -1;
+  const char* lineEnd = TextParsing::FindLineEnd(data, end);
+  while(err >= 0 && lineEnd < end)
+  {
+    const char* lineStart = lineEnd + 1;
+    lineEnd = TextParsing::FindLineEnd(lineStart, end);
+    pos = TextParsing::SkipWhitespace(lineStart, lineEnd);
+    if(pos == lineEnd)
     {
-      yB = yVal[i] - yMin;
-      yC = yB;
-      yA = yB - (root3over2 * newEdgeLength);
+      continue;
     }
-    for(int j = int(xA / newEdgeLength); j < int(xB / newEdgeLength) + 1; j++)
+
+    float values[10] = {0.0f};
+    for(size_t c = 0; c < 10 && err >= 0; c++)
     {
-      for(int k = int(yA / newEdgeLength); k < int(yC / newEdgeLength) + 1; k++)
+      if(!TextParsing::ParseFloat(pos, lineEnd, values[c]))
       {
-        x = float(j) * newEdgeLength;
-        y = float(k) * newEdgeLength;
-        check1 = static_cast<int>((x - xB) * (yA - yB) - (xA - xB) * (y - yB));
-        check2 = static_cast<int>((x - xC) * (yB - yC) - (xB - xC) * (y - yC));
-        check3 = static_cast<int>((x - xA) * (yC - yA) - (xC - xA) * (y - yA));
-        if((check1 <= 0 && check2 <= 0 && check3 <= 0) || (check1 >= 0 && check2 >= 0 && check3 >= 0))
-        {
-          point = (k * xDim) + j;
-          m_Euler1[point] = EA1[i];
-          m_Euler2[point] = EA2[i];
-          m_Euler3[point] = EA3[i];
-          m_Conf[point] = confidence[i];
-          m_Phase[point] = phase[i];
-          m_X[point] = float(j) * xRes + xMinUM;
-          m_Y[point] = float(k) * yRes + yMinUM;
-        }
+        errorMessage = QObject::tr("Unable to parse line %1 of Mic file %2: %3")
+                           .arg(TextParsing::LineNumber(data, lineStart))
+                           .arg(fileName)
+                           .arg(QString::fromLatin1(lineStart, static_cast<int>(lineEnd - lineStart)).simplified());
+        err = -114;
       }
     }
+    if(err < 0)
+    {
+      break;
+    }
+
+    MicTriangle triangle;
+    triangle.x = values[0];
+    triangle.y = values[1];
+    triangle.up = static_cast<int>(values[3]);
+    triangle.euler[0] = values[6];
+    triangle.euler[1] = values[7];
+    triangle.euler[2] = values[8];
+    triangle.conf = values[9];
+    triangle.phase = (values[5] > 0.0f) ? 1 : 0;
+    if(firstLevel < 0)
+    {
+      // all triangles of a file are refined to the level of the first one
+      firstLevel = static_cast<int>(values[4]);
+      slice.edgeLength = origEdgeLength / powf(2.0, float(firstLevel));
+    }
+
+    // grid bounds follow the triangle centroids
+    float x = triangle.x + (slice.edgeLength / 2.0f);
+    float y = (triangle.up == 1) ? triangle.y + (constant * slice.edgeLength) : triangle.y - (constant * slice.edgeLength);
+    xMin = std::min(xMin, x);
+    xMax = std::max(xMax, x);
+    yMin = std::min(yMin, y);
+    yMax = std::max(yMax, y);
+    if(!boundsOnly)
+    {
+      slice.triangles.push_back(triangle);
+    }
   }
 
+  if(nullptr != mapped)
+  {
+    in.unmap(mapped);
+  }
+  if(err >= 0 && firstLevel < 0)
+  {
+    errorMessage = QObject::tr("Mic file %1 does not contain any data").arg(fileName);
+    err = -115;
+  }
+  if(err < 0)
+  {
+    slice = MicSlice();
+    return err;
+  }
+
+  slice.xMin = xMin - (2.0f * slice.edgeLength);
+  slice.xMax = xMax + (2.0f * slice.edgeLength);
+  slice.yMin = yMin - (2.0f * slice.edgeLength);
+  slice.yMax = yMax + (2.0f * slice.edgeLength);
   return 0;
 }
 
@@ -654,59 +664,6 @@ void MicReader::parseHeaderLine(QByteArray& line)
 #endif
 }
 
-// -----------------------------------------------------------------------------
-//  Read the data part of the Mic file
-// -----------------------------------------------------------------------------
-void MicReader::parseDataLine(QByteArray& line, size_t i)
-{
-  /* When reading the data there should be at least 8 cols of data. There may even
-   * be 10 columns of data. The column names should be the following:
-   * phi1
-   * phi
-   * phi2
-   * x pos
-   * y pos
-   * image quality
-   * confidence index
-   * phase
-   * SEM Signal
-   * Fit of Solution
-   *
-   * Some HEDM Mic files do NOT have all 10 columns. Assume these are lacking the last
-   * 2 columns and all the other columns are the same as above.
-   */
-  float p1 = 0.0f, p = 0.0f, p2 = 0.0f, x = -1.0f, y = -1.0f, z = -1.0f, conf = -1.0f, junk1, junk2, junk3;
-  int up = 0, level = 0, good = 0, junk4, junk5, junk6, junk7, junk8, junk9;
-  size_t offset = 0;
-  size_t featuresRead = 0;
-  featuresRead = sscanf(line.data(), "%f %f %f %d %d %d %f %f %f %f %f %f %f %d %d %d %d %d %d", &x, &y, &z, &up, &level, &good, &p1, &p, &p2, &conf, &junk1, &junk2, &junk3, &junk4, &junk5, &junk6,
-                        &junk7, &junk8, &junk9);
-  if(featuresRead != 19)
-  {
-    qDebug() << "MicReader Error: Not enough columns were read for row " << i;
-  }
-  offset = i;
-
-  if(good > 0)
-  {
-    good = 1;
-  }
-  else
-  {
-    good = 0;
-  }
-
-  m_Euler1[offset] = p1;
-  m_Euler2[offset] = p;
-  m_Euler3[offset] = p2;
-  m_Conf[offset] = conf;
-  m_Phase[offset] = good;
-  m_Level[offset] = level;
-  m_Up[offset] = up;
-  m_X[offset] = x;
-  m_Y[offset] = y;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -35,6 +35,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <QtCore/QString>
 
 #include "EbsdLib/EbsdConstants.h"
@@ -168,6 +172,98 @@ public:
    */
   int readHeaderOnly() override;
 
+  /**
+   * @brief Reads the .config header and the .dat phase information that go with the .Mic file,
+   * without reading the .Mic data itself
+   * @return Zero/Positive on Success - Negative on error.
+   */
+  int readPhaseInfo();
+
+  /**
+   * @brief The MicTriangle struct holds the values of one data row of a .Mic file. (x, y) is the left
+   * corner of the horizontal edge of an equilateral triangle that points up (up == 1) or down
+   */
+  struct MicTriangle
+  {
+    float x;
+    float y;
+    int up;
+    float euler[3];
+    float conf;
+    int phase;
+  };
+
+  /**
+   * @brief The MicSlice struct holds the triangles of a .Mic file, their edge length and the bounds of
+   * the grid that covers them (the triangle centroids padded by two edge lengths), all in mm
+   */
+  struct MicSlice
+  {
+    float edgeLength = 0.0f;
+    float xMin = 0.0f;
+    float xMax = 0.0f;
+    float yMin = 0.0f;
+    float yMax = 0.0f;
+    std::vector<MicTriangle> triangles;
+  };
+
+  /**
+   * @brief ReadMicSlice Reads the triangles of a .Mic file. Unlike readFile(), this does not touch any
+   * instance state, so that several files can be read concurrently.
+   * @param fileName The .Mic file to read
+   * @param boundsOnly Only compute the edge length and grid bounds, without keeping the triangles
+   * @param slice Receives the triangles and grid bounds
+   * @param errorMessage Receives the error message on failure
+   * @return Zero on Success - Negative on error.
+   */
+  static int ReadMicSlice(const QString& fileName, bool boundsOnly, MicSlice& slice, QString& errorMessage);
+
+  /**
+   * @brief RasterizeMicSlice Assigns the grid points that fall inside (or on the edges of) each triangle
+   * of the slice, scanning the one or two grid rows that each triangle spans and solving for the span
+   * of columns inside it on each row. Later triangles overwrite earlier ones where they overlap.
+   * @param slice The triangles to rasterize
+   * @param xMin X coordinate of grid point (0, 0), in mm
+   * @param yMin Y coordinate of grid point (0, 0), in mm
+   * @param xDim Number of grid points along x; the grid spacing is the edge length of the slice
+   * @param yDim Number of grid points along y
+   * @param writePoint Called as writePoint(point, column, row, triangle) for every covered grid point
+   */
+  template <typename WritePointFunctor>
+  static void RasterizeMicSlice(const MicSlice& slice, float xMin, float yMin, size_t xDim, size_t yDim, WritePointFunctor writePoint)
+  {
+    // in grid units the triangles have unit edges; points within k_Tolerance of an edge count as inside
+    const double k_Tolerance = 1.0e-4;
+    const double height = std::sqrt(3.0) / 2.0;
+    const double slope = 1.0 / std::sqrt(3.0);
+    double edgeLength = static_cast<double>(slice.edgeLength);
+    for(const MicTriangle& triangle : slice.triangles)
+    {
+      double x0 = (static_cast<double>(triangle.x) - xMin) / edgeLength;
+      double y0 = (static_cast<double>(triangle.y) - yMin) / edgeLength;
+      double direction = (triangle.up == 1) ? 1.0 : -1.0;
+      double yApex = y0 + direction * height;
+      int64_t rowStart = static_cast<int64_t>(std::ceil(std::min(y0, yApex) - k_Tolerance));
+      int64_t rowEnd = static_cast<int64_t>(std::floor(std::max(y0, yApex) + k_Tolerance));
+      rowStart = std::max<int64_t>(rowStart, 0);
+      rowEnd = std::min<int64_t>(rowEnd, static_cast<int64_t>(yDim) - 1);
+      for(int64_t row = rowStart; row <= rowEnd; row++)
+      {
+        // the triangle narrows linearly from the full edge at y0 to the apex
+        double distance = std::min(std::fabs(static_cast<double>(row) - y0), height);
+        double left = x0 + distance * slope;
+        double right = x0 + 1.0 - distance * slope;
+        int64_t columnStart = std::max<int64_t>(static_cast<int64_t>(std::ceil(left - k_Tolerance)), 0);
+        int64_t columnEnd = std::min<int64_t>(static_cast<int64_t>(std::floor(right + k_Tolerance)), static_cast<int64_t>(xDim) - 1);
+        size_t rowOffset = static_cast<size_t>(row) * xDim;
+        for(int64_t column = columnStart; column <= columnEnd; column++)
+        {
+          writePoint(rowOffset + static_cast<size_t>(column), static_cast<size_t>(column), static_cast<size_t>(row), triangle);
+        }
+      }
+    }
+  }
+
   int getXDimension() override;
   int getYDimension() override;
   void setXDimension(int xD) override;
@@ -197,11 +293,6 @@ private:
    */
   void parseHeaderLine(QByteArray& line);
 
-  /** @brief Parses the data from a line of data from the HEDM .Mic file
-   * @param line The line of data to parse
-   */
-  void parseDataLine(QByteArray& line, size_t i);
-
   /**
    * @brief initPointers
    * @param numElements
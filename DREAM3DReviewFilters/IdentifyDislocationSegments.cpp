@@ -36,11 +36,23 @@
 
 #include "IdentifyDislocationSegments.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <random>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
@@ -61,6 +73,130 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID32 = 32,
 };
 
+namespace
+{
+/**
+ * @brief FindSegmentRoot Returns the root of the set holding an edge, halving the path on the way. Edges only
+ * ever point to a lower edge of the same set, so the root is the lowest edge of the set.
+ */
+int64_t FindSegmentRoot(std::atomic<int64_t>* parents, int64_t edge)
+{
+  int64_t parent = parents[edge].load();
+  while(parent != edge)
+  {
+    int64_t grandparent = parents[parent].load();
+    if(grandparent != parent)
+    {
+      parents[edge].compare_exchange_weak(parent, grandparent);
+    }
+    edge = grandparent;
+    parent = parents[edge].load();
+  }
+  return edge;
+}
+
+/**
+ * @brief The LinkSegmentEdgesImpl class joins the sets of each edge and the edges sharing a vertex with it
+ * whose Burgers vectors and slip plane normals are parallel within the tolerance. The sets are joined with
+ * a lock-free union-find that links the higher root below the lower one.
+ */
+class LinkSegmentEdgesImpl
+{
+  const MeshIndexType* m_Edges;
+  DynamicListArray<uint16_t, MeshIndexType>* m_EdgesContainingVert;
+  const float* m_BurgersVectors;
+  const float* m_SlipPlaneNormals;
+  float m_AngleTolerance;
+  std::atomic<int64_t>* m_Parents;
+
+public:
+  LinkSegmentEdgesImpl(const MeshIndexType* edges, DynamicListArray<uint16_t, MeshIndexType>* edgesContainingVert, const float* burgersVectors, const float* slipPlaneNormals, float angleTolerance,
+                       std::atomic<int64_t>* parents)
+  : m_Edges(edges)
+  , m_EdgesContainingVert(edgesContainingVert)
+  , m_BurgersVectors(burgersVectors)
+  , m_SlipPlaneNormals(slipPlaneNormals)
+  , m_AngleTolerance(angleTolerance)
+  , m_Parents(parents)
+  {
+  }
+  virtual ~LinkSegmentEdgesImpl() = default;
+
+  bool isParallel(float angle) const
+  {
+    return angle < m_AngleTolerance || (SIMPLib::Constants::k_Pi - angle) < m_AngleTolerance;
+  }
+
+  void unite(int64_t edge1, int64_t edge2) const
+  {
+    while(true)
+    {
+      edge1 = FindSegmentRoot(m_Parents, edge1);
+      edge2 = FindSegmentRoot(m_Parents, edge2);
+      if(edge1 == edge2)
+      {
+        return;
+      }
+      if(edge1 < edge2)
+      {
+        std::swap(edge1, edge2);
+      }
+      // another thread may have linked edge1 in the meantime, in which case the roots are looked up again
+      int64_t expected = edge1;
+      if(m_Parents[edge1].compare_exchange_strong(expected, edge2))
+      {
+        return;
+      }
+    }
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    float refBV[3], refSPN[3];
+    float neighBV[3], neighSPN[3];
+    for(size_t i = start; i < end; i++)
+    {
+      refBV[0] = m_BurgersVectors[3 * i + 0];
+      refBV[1] = m_BurgersVectors[3 * i + 1];
+      refBV[2] = m_BurgersVectors[3 * i + 2];
+      refSPN[0] = m_SlipPlaneNormals[3 * i + 0];
+      refSPN[1] = m_SlipPlaneNormals[3 * i + 1];
+      refSPN[2] = m_SlipPlaneNormals[3 * i + 2];
+      for(int iter = 0; iter < 2; iter++)
+      {
+        uint16_t eCount = m_EdgesContainingVert->getNumberOfElements(m_Edges[2 * i + iter]);
+        MeshIndexType* data = m_EdgesContainingVert->getElementListPointer(m_Edges[2 * i + iter]);
+        for(uint16_t j = 0; j < eCount; j++)
+        {
+          // every pair of edges is tested from its lower edge only
+          if(data[j] <= i)
+          {
+            continue;
+          }
+          neighBV[0] = m_BurgersVectors[3 * data[j] + 0];
+          neighBV[1] = m_BurgersVectors[3 * data[j] + 1];
+          neighBV[2] = m_BurgersVectors[3 * data[j] + 2];
+          neighSPN[0] = m_SlipPlaneNormals[3 * data[j] + 0];
+          neighSPN[1] = m_SlipPlaneNormals[3 * data[j] + 1];
+          neighSPN[2] = m_SlipPlaneNormals[3 * data[j] + 2];
+          if(isParallel(GeometryMath::AngleBetweenVectors(refBV, neighBV)) && isParallel(GeometryMath::AngleBetweenVectors(refSPN, neighSPN)))
+          {
+            unite(static_cast<int64_t>(i), static_cast<int64_t>(data[j]));
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -70,6 +206,8 @@ IdentifyDislocationSegments::IdentifyDislocationSegments()
 , m_SlipPlaneNormalsArrayPath(SIMPL::Defaults::EdgeDataContainerName, SIMPL::Defaults::EdgeAttributeMatrixName, SIMPL::EdgeData::SlipPlaneNormals)
 , m_DislocationIdsArrayName(SIMPL::EdgeData::DislocationIds)
 , m_ActiveArrayName(SIMPL::FeatureData::Active)
+, m_UseSeed(false)
+, m_SeedValue(0)
 {
 }
 
@@ -84,6 +222,9 @@ IdentifyDislocationSegments::~IdentifyDislocationSegments() = default;
 void IdentifyDislocationSegments::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
+  QStringList linkedProps("SeedValue");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Seed for Shuffling Ids", UseSeed, FilterParameter::Parameter, IdentifyDislocationSegments, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Seed Value", SeedValue, FilterParameter::Parameter, IdentifyDislocationSegments));
   parameters.push_back(SeparatorFilterParameter::New("Edge Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req;
@@ -115,6 +256,8 @@ void IdentifyDislocationSegments::readFilterParameters(AbstractFilterParametersR
   setDislocationIdsArrayName(reader->readString("DislocationIdsArrayName", getDislocationIdsArrayName()));
   setSlipPlaneNormalsArrayPath(reader->readDataArrayPath("SlipPlaneNormalsArrayPath", getSlipPlaneNormalsArrayPath()));
   setBurgersVectorsArrayPath(reader->readDataArrayPath("BurgersVectorsArrayPath", getBurgersVectorsArrayPath()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
 
   reader->closeFilterGroup();
 }
@@ -247,107 +390,91 @@ void IdentifyDislocationSegments::execute()
 
   DynamicListArray<uint16_t, MeshIndexType>::Pointer edgesContainingVert = edgeGeom->getElementsContainingVert();
 
-  int dnum = 0;
-  qint32 size = 0;
-  std::vector<size_t> tDims(1, dnum);
-  int64_t initialEdgesListSize = 100;
-  QVector<int64_t> edgeslist(initialEdgesListSize, -1);
-  float refBV[3], refSPN[3];
-  float neighBV[3], neighSPN[3];
-  float angleBV, angleSPN;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Two edges belong to the same dislocation if a chain of vertex sharing edges with parallel Burgers vectors
+  // and slip plane normals connects them, so the dislocations are the sets of a union-find over those pairs
+  std::vector<std::atomic<int64_t>> parents(numEdges);
+  for(size_t i = 0; i < numEdges; i++)
+  {
+    parents[i].store(static_cast<int64_t>(i));
+  }
   float angleTol = 1.0 * SIMPLib::Constants::k_Pi / 180.0f;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numEdges), LinkSegmentEdgesImpl(edge, edgesContainingVert.get(), m_BurgersVectors, m_SlipPlaneNormals, angleTol, parents.data()),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    LinkSegmentEdgesImpl serial(edge, edgesContainingVert.get(), m_BurgersVectors, m_SlipPlaneNormals, angleTol, parents.data());
+    serial.compute(0, numEdges);
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // The root of each set is its lowest edge, so numbering the roots in edge order gives every dislocation
+  // the Id it would get from flood filling the edges in order
+  int32_t dnum = 0;
   for(size_t i = 0; i < numEdges; i++)
   {
-    size = 0;
-    if(m_DislocationIds[i] == 0)
+    int64_t root = FindSegmentRoot(parents.data(), static_cast<int64_t>(i));
+    if(root == static_cast<int64_t>(i))
     {
       dnum++;
       m_DislocationIds[i] = dnum;
-      edgeslist[size] = i;
-      size++;
-      tDims[0] = dnum + 1;
-      edgeFeatureAttrMat->resizeAttributeArrays(tDims);
-      updateEdgeFeatureInstancePointers();
-      m_Active[dnum] = true;
-      while(size > 0)
-      {
-        int64_t currentEdge = edgeslist[size - 1];
-        refBV[0] = m_BurgersVectors[3 * currentEdge + 0];
-        refBV[1] = m_BurgersVectors[3 * currentEdge + 1];
-        refBV[2] = m_BurgersVectors[3 * currentEdge + 2];
-        refSPN[0] = m_SlipPlaneNormals[3 * currentEdge + 0];
-        refSPN[1] = m_SlipPlaneNormals[3 * currentEdge + 1];
-        refSPN[2] = m_SlipPlaneNormals[3 * currentEdge + 2];
-        size -= 1;
-        for(int iter = 0; iter < 2; iter++)
-        {
-          uint16_t eCount = edgesContainingVert->getNumberOfElements(edge[2 * currentEdge + iter]);
-          MeshIndexType* data = edgesContainingVert->getElementListPointer(edge[2 * currentEdge + iter]);
-          for(uint16_t j = 0; j < eCount; j++)
-          {
-            if(m_DislocationIds[data[j]] == 0)
-            {
-              neighBV[0] = m_BurgersVectors[3 * data[j] + 0];
-              neighBV[1] = m_BurgersVectors[3 * data[j] + 1];
-              neighBV[2] = m_BurgersVectors[3 * data[j] + 2];
-              neighSPN[0] = m_SlipPlaneNormals[3 * data[j] + 0];
-              neighSPN[1] = m_SlipPlaneNormals[3 * data[j] + 1];
-              neighSPN[2] = m_SlipPlaneNormals[3 * data[j] + 2];
-              angleBV = GeometryMath::AngleBetweenVectors(refBV, neighBV);
-              angleSPN = GeometryMath::AngleBetweenVectors(refSPN, neighSPN);
-              if((angleBV < angleTol || (SIMPLib::Constants::k_Pi - angleBV) < angleTol) && (angleSPN < angleTol || (SIMPLib::Constants::k_Pi - angleSPN) < angleTol))
-              {
-                m_DislocationIds[data[j]] = dnum;
-                edgeslist[size] = data[j];
-                size++;
-                if(size >= edgeslist.size())
-                {
-                  size = edgeslist.size();
-                  edgeslist.resize(size + initialEdgesListSize);
-                  for(qint32 j = size; j < edgeslist.size(); ++j)
-                  {
-                    edgeslist[j] = -1;
-                  }
-                }
-              }
-            }
-          }
-        }
-      }
+    }
+    else
+    {
+      m_DislocationIds[i] = m_DislocationIds[root];
     }
   }
 
+  std::vector<size_t> tDims(1, static_cast<size_t>(dnum) + 1);
+  edgeFeatureAttrMat->resizeAttributeArrays(tDims);
+  updateEdgeFeatureInstancePointers();
+  m_ActivePtr.lock()->initializeWithValue(true);
+
+  if(dnum < 2)
+  {
+    return;
+  }
+
   // Generate all the numbers up front
   const int rangeMin = 1;
-  const int rangeMax = dnum - 1;
+  const int rangeMax = dnum;
 
-  std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-  std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
   std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  generator.seed(seed);
+  if(m_UseSeed)
+  {
+    seed = static_cast<std::mt19937_64::result_type>(m_SeedValue);
+  }
+  std::mt19937_64 generator(seed); // Standard mersenne_twister_engine
   std::uniform_int_distribution<int32_t> distribution(rangeMin, rangeMax);
 
-  DataArray<int32_t>::Pointer rndNumbers = DataArray<int32_t>::CreateArray(dnum, "New FeatureIds", true);
+  DataArray<int32_t>::Pointer rndNumbers = DataArray<int32_t>::CreateArray(dnum + 1, "New FeatureIds", true);
   int32_t* gid = rndNumbers->getPointer(0);
   gid[0] = 0;
-  QSet<int32_t> featureIdSet;
-  featureIdSet.insert(0);
-  for(int32_t i = 1; i < dnum; ++i)
+  for(int32_t i = 1; i <= dnum; ++i)
   {
     gid[i] = i; // numberGenerator();
-    featureIdSet.insert(gid[i]);
   }
 
   qint32 r;
   qint32 temp;
   //--- Shuffle elements by randomly exchanging each with one other.
-  for(qint32 i = 1; i < dnum; i++)
+  for(qint32 i = 1; i <= dnum; i++)
   {
     r = distribution(generator); // Random remaining position.
-    if(r >= dnum)
-    {
-      continue;
-    }
     temp = gid[i];
     gid[i] = gid[r];
     gid[r] = temp;
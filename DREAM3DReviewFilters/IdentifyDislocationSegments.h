@@ -65,6 +65,8 @@ class DREAM3DReview_EXPORT IdentifyDislocationSegments : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath SlipPlaneNormalsArrayPath READ getSlipPlaneNormalsArrayPath WRITE setSlipPlaneNormalsArrayPath)
   PYB11_PROPERTY(QString DislocationIdsArrayName READ getDislocationIdsArrayName WRITE setDislocationIdsArrayName)
   PYB11_PROPERTY(QString ActiveArrayName READ getActiveArrayName WRITE setActiveArrayName)
+  PYB11_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+  PYB11_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
 public:
   SIMPL_SHARED_POINTERS(IdentifyDislocationSegments)
   SIMPL_FILTER_NEW_MACRO(IdentifyDislocationSegments)
@@ -91,6 +93,12 @@ public:
   SIMPL_FILTER_PARAMETER(QString, ActiveArrayName)
   Q_PROPERTY(QString ActiveArrayName READ getActiveArrayName WRITE setActiveArrayName)
 
+  SIMPL_FILTER_PARAMETER(bool, UseSeed)
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  SIMPL_FILTER_PARAMETER(int, SeedValue)
+  Q_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
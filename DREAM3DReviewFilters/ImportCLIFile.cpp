@@ -13,7 +13,19 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ImportCLIFile.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #include <QtCore/QFileInfo>
+#include <QtCore/QtEndian>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
 
@@ -24,8 +36,308 @@
 #include "SIMPLib/Geometry/EdgeGeom.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/TextParsing.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+namespace
+{
+// binary CLI command indices, see the Common Layer Interface specification
+const uint16_t k_StartLayerLong = 127;
+const uint16_t k_StartLayerShort = 128;
+const uint16_t k_StartPolyLineShort = 129;
+const uint16_t k_StartPolyLineLong = 130;
+const uint16_t k_StartHatchesShort = 131;
+const uint16_t k_StartHatchesLong = 132;
+
+// the ASCII header of a binary CLI file is expected within the first bytes of the file
+const qint64 k_HeaderPeekSize = 64 * 1024;
+
+/**
+ * @brief ReadBinaryValue Reads a little endian value of type T and advances pos
+ * @return false if the data ends before the value
+ */
+template <typename T>
+bool ReadBinaryValue(const char* data, size_t size, size_t& pos, T& value)
+{
+  if(pos + sizeof(T) > size)
+  {
+    return false;
+  }
+  value = qFromLittleEndian<T>(reinterpret_cast<const uchar*>(data + pos));
+  pos += sizeof(T);
+  return true;
+}
+
+/**
+ * @brief ReadBinaryInteger Reads a command parameter, which is a 32 bit signed integer in the long
+ * format and a 16 bit unsigned integer in the short format
+ */
+bool ReadBinaryInteger(const char* data, size_t size, size_t& pos, bool longFormat, int64_t& value)
+{
+  if(longFormat)
+  {
+    int32_t longValue = 0;
+    bool ok = ReadBinaryValue(data, size, pos, longValue);
+    value = longValue;
+    return ok;
+  }
+  uint16_t shortValue = 0;
+  bool ok = ReadBinaryValue(data, size, pos, shortValue);
+  value = shortValue;
+  return ok;
+}
+
+/**
+ * @brief BinaryCoordinatesFit Returns whether count coordinates fit in the bytes left after pos, without
+ * forming count * coordinate size, which can overflow for a corrupt count
+ */
+bool BinaryCoordinatesFit(size_t size, size_t pos, bool longFormat, int64_t count)
+{
+  size_t valueSize = longFormat ? sizeof(float) : sizeof(uint16_t);
+  return count >= 0 && pos <= size && static_cast<uint64_t>(count) <= (size - pos) / valueSize;
+}
+
+/**
+ * @brief ReadBinaryCoordinates Reads count coordinates, which are 32 bit floats in the long format
+ * and 16 bit unsigned integers in the short format
+ */
+bool ReadBinaryCoordinates(const char* data, size_t size, size_t& pos, bool longFormat, int64_t count, float* coords)
+{
+  if(!BinaryCoordinatesFit(size, pos, longFormat, count))
+  {
+    return false;
+  }
+  for(int64_t i = 0; i < count; i++)
+  {
+    if(longFormat)
+    {
+      uint32_t bits = 0;
+      ReadBinaryValue(data, size, pos, bits);
+      std::memcpy(coords + i, &bits, sizeof(float));
+    }
+    else
+    {
+      uint16_t shortValue = 0;
+      ReadBinaryValue(data, size, pos, shortValue);
+      coords[i] = static_cast<float>(shortValue);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief The CLILayerSegment struct describes the part of an ASCII CLI file that holds one layer
+ */
+struct CLILayerSegment
+{
+  enum ErrorType
+  {
+    NoError = 0,
+    PolylineError,
+    PolylineCountError,
+    PolylineCoordinateError,
+    HatchError,
+    HatchCountError,
+    HatchCoordinateError
+  };
+
+  size_t begin = 0;
+  size_t end = 0;
+  int32_t layer = 0;
+  float layerHeight = 0.0f;
+  int64_t numVertices = 0;
+  int64_t numEdges = 0;
+  int32_t numFeatures = 0;
+  int64_t vertexOffset = 0;
+  int64_t edgeOffset = 0;
+  int32_t featureOffset = 0;
+  int32_t error = NoError;
+  size_t errorPosition = 0;
+};
+
+QString ErrorMessage(int32_t error, int32_t line, const QString& text)
+{
+  switch(error)
+  {
+  case CLILayerSegment::PolylineError:
+    return QObject::tr("Unable to parse polyline from CLI file line %1: %2").arg(line).arg(text);
+  case CLILayerSegment::PolylineCountError:
+    return QObject::tr("Polyline at line %1 does not contain an even number of elements: %2").arg(line).arg(text);
+  case CLILayerSegment::PolylineCoordinateError:
+    return QObject::tr("Unable to parse polyline coordinate from CLI file line %1: %2").arg(line).arg(text);
+  case CLILayerSegment::HatchError:
+    return QObject::tr("Unable to parse hatch from CLI file line %1: %2").arg(line).arg(text);
+  case CLILayerSegment::HatchCountError:
+    return QObject::tr("Hatch at line %1 does not contain an even number of elements: %2").arg(line).arg(text);
+  default:
+    return QObject::tr("Unable to parse hatch coordinate from CLI file line %1: %2").arg(line).arg(text);
+  }
+}
+
+/**
+ * @brief The ParseCLILayersImpl class parses the polylines and hatches of a range of layer segments.
+ * Without fill, it only counts the vertices, edges and features of each segment; with fill, it parses
+ * the coordinates into the output arrays at the offsets stored in each segment.
+ */
+class ParseCLILayersImpl
+{
+public:
+  ParseCLILayersImpl(AbstractFilter* filter, const char* data, std::vector<CLILayerSegment>& segments, bool fill, float* vertices, int64_t* edges, int32_t* layerIds, int32_t* featureIds)
+  : m_Filter(filter)
+  , m_Data(data)
+  , m_Segments(segments)
+  , m_Fill(fill)
+  , m_Vertices(vertices)
+  , m_Edges(edges)
+  , m_LayerIds(layerIds)
+  , m_FeatureIds(featureIds)
+  {
+  }
+  virtual ~ParseCLILayersImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      parseSegment(m_Segments[s]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  const char* m_Data;
+  std::vector<CLILayerSegment>& m_Segments;
+  bool m_Fill;
+  float* m_Vertices;
+  int64_t* m_Edges;
+  int32_t* m_LayerIds;
+  int32_t* m_FeatureIds;
+
+  void parseSegment(CLILayerSegment& segment) const
+  {
+    int64_t vertex = segment.vertexOffset;
+    int64_t edge = segment.edgeOffset;
+    int32_t feature = segment.featureOffset;
+    if(!m_Fill)
+    {
+      segment.numVertices = 0;
+      segment.numEdges = 0;
+      segment.numFeatures = 0;
+    }
+
+    const char* end = m_Data + segment.end;
+    for(const char* lineStart = m_Data + segment.begin; lineStart < end;)
+    {
+      const char* lineEnd = TextParsing::FindLineEnd(lineStart, end);
+      const char* pos = TextParsing::SkipWhitespace(lineStart, lineEnd);
+      bool polyline = TextParsing::StartsWith(pos, lineEnd, "$$POLYLINE") || TextParsing::StartsWith(pos, lineEnd, "$POLYLINE");
+      bool hatches = !polyline && (TextParsing::StartsWith(pos, lineEnd, "$$HATCHES") || TextParsing::StartsWith(pos, lineEnd, "$HATCHES"));
+      if(!polyline && !hatches)
+      {
+        lineStart = lineEnd + 1;
+        continue;
+      }
+
+      const char* slash = static_cast<const char*>(std::memchr(pos, '/', static_cast<size_t>(lineEnd - pos)));
+      if(nullptr == slash || nullptr != std::memchr(slash + 1, '/', static_cast<size_t>(lineEnd - slash - 1)))
+      {
+        setError(segment, polyline ? CLILayerSegment::PolylineError : CLILayerSegment::HatchError, lineStart);
+        return;
+      }
+      int64_t tokens = std::count(slash + 1, lineEnd, ',') + 1;
+
+      // polylines are id, direction, count, x1, y1, ..., xn, yn, where the last point repeats the first;
+      // hatches are id, count, x1, y1, x2, y2, ... with two points per hatch
+      int64_t skipTokens = polyline ? 3 : 2;
+      int64_t numCoords = tokens - skipTokens;
+      if(numCoords <= 0)
+      {
+        lineStart = lineEnd + 1;
+        continue;
+      }
+      if(numCoords % (polyline ? 2 : 4) != 0)
+      {
+        setError(segment, polyline ? CLILayerSegment::PolylineCountError : CLILayerSegment::HatchCountError, lineStart);
+        return;
+      }
+      int64_t numVerts = polyline ? (numCoords / 2 - 1) : (numCoords / 2);
+      int64_t numEdges = polyline ? numVerts : (numVerts / 2);
+
+      if(!m_Fill)
+      {
+        segment.numFeatures++;
+        segment.numVertices += numVerts;
+        segment.numEdges += numEdges;
+        lineStart = lineEnd + 1;
+        continue;
+      }
+
+      feature++;
+      pos = slash + 1;
+      for(int64_t i = 0; i < skipTokens; i++)
+      {
+        pos = static_cast<const char*>(std::memchr(pos, ',', static_cast<size_t>(lineEnd - pos))) + 1;
+      }
+      float* coords = m_Vertices + 3 * vertex;
+      for(int64_t i = 0; i < numCoords; i++)
+      {
+        float value = 0.0f;
+        bool ok = TextParsing::ParseFloat(pos, lineEnd, value);
+        pos = TextParsing::SkipWhitespace(pos, lineEnd);
+        ok = ok && ((i == numCoords - 1) ? (pos == lineEnd) : (*pos == ','));
+        if(!ok)
+        {
+          setError(segment, polyline ? CLILayerSegment::PolylineCoordinateError : CLILayerSegment::HatchCoordinateError, lineStart);
+          return;
+        }
+        pos++;
+        // the closing point of a polyline is dropped
+        if(i / 2 < numVerts)
+        {
+          coords[(i / 2) * 3 + (i % 2)] = value;
+          coords[(i / 2) * 3 + 2] = segment.layerHeight;
+        }
+      }
+
+      for(int64_t i = 0; i < numEdges; i++, edge++)
+      {
+        if(polyline)
+        {
+          m_Edges[2 * edge] = vertex + i;
+          m_Edges[2 * edge + 1] = (i == numEdges - 1) ? vertex : vertex + i + 1;
+        }
+        else
+        {
+          m_Edges[2 * edge] = vertex + 2 * i;
+          m_Edges[2 * edge + 1] = vertex + 2 * i + 1;
+        }
+        m_LayerIds[edge] = segment.layer;
+        m_FeatureIds[edge] = feature;
+      }
+      vertex += numVerts;
+      lineStart = lineEnd + 1;
+    }
+  }
+
+  void setError(CLILayerSegment& segment, int32_t error, const char* lineStart) const
+  {
+    segment.error = error;
+    segment.errorPosition = static_cast<size_t>(lineStart - m_Data);
+  }
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -156,173 +468,75 @@ void ImportCLIFile::execute()
 
   QFile stream;
   stream.setFileName(getCLIFile());
-  if(!stream.open(QIODevice::ReadOnly | QIODevice::Text))
+  if(!stream.open(QIODevice::ReadOnly))
   {
     QString ss = QObject::tr("Input CLI file could not be opened: %1").arg(getCLIFile());
     setErrorCondition(-100, ss);
     return;
   }
 
-  QByteArray buf;
-  QList<QByteArray> tokens;
-  bool ok = false;
+  // the whole file is mapped (or read at once if mapping fails) and parsed in place
+  qint64 fileSize = stream.size();
+  QByteArray contents;
+  uchar* mapped = stream.map(0, fileSize);
+  const char* data = reinterpret_cast<const char*>(mapped);
+  if(nullptr == mapped)
+  {
+    contents = stream.readAll();
+    data = contents.constData();
+  }
+
   float units = 1.0f;
   std::vector<float> tmpVertices;
   std::vector<int64_t> tmpEdges;
   std::vector<int32_t> tmpLayerIds;
   std::vector<int32_t> tmpFeatureIds;
-  float layerHeight = 0.0f;
-  int32_t lines = 1;
-  int32_t layer = 0;
-  int32_t features = 0;
-  int64_t vertexCounter = 0;
 
-  while(!stream.atEnd())
+  // binary CLI files announce themselves with $$BINARY in the ASCII header, and their geometry
+  // section starts directly after $$HEADEREND
+  QByteArray head = QByteArray::fromRawData(data, static_cast<int32_t>(std::min(fileSize, k_HeaderPeekSize)));
+  int32_t headerEnd = head.indexOf("$$HEADEREND");
+  bool binary = (headerEnd >= 0 && head.left(headerEnd).contains("$$BINARY"));
+
+  int32_t err = 0;
+  if(binary)
   {
-    buf = stream.readLine();
-    buf = buf.trimmed();
-    buf = buf.simplified();
-    if(buf.startsWith("$$UNITS"))
+    QList<QByteArray> headerLines = head.left(headerEnd).split('\n');
+    for(auto&& line : headerLines)
     {
-      tokens = buf.split('/');
-      if(tokens.size() != 2)
-      {
-        QString ss = QObject::tr("Unable to parse units from CLI file line %1: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-        setErrorCondition(-1, ss);
-        return;
-      }
-      units = tokens.at(1).toFloat(&ok);
-      if(!ok)
-      {
-        QString ss = QObject::tr("Unable to parse units from CLI file line %1: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-        setErrorCondition(-1, ss);
-        return;
-      }
-    }
-    else if(buf.startsWith("$$LAYER"))
-    {
-      layer++;
-      tokens = buf.split('/');
-      if(tokens.size() != 2)
-      {
-        QString ss = QObject::tr("Unable to parse layer height from CLI file line %1: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-        setErrorCondition(-1, ss);
-        return;
-      }
-      layerHeight = tokens.at(1).toFloat(&ok);
-      if(!ok)
-      {
-        QString ss = QObject::tr("Unable to parse layer height from CLI file line %1: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-        setErrorCondition(-1, ss);
-        return;
-      }
-    }
-    else if(buf.startsWith("$$POLYLINE") || buf.startsWith("$POLYLINE"))
-    {
-      tokens = buf.split('/');
-      if(tokens.size() != 2)
-      {
-        QString ss = QObject::tr("Unable to parse polyline from CLI file line %1: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-        setErrorCondition(-1, ss);
-        return;
-      }
-      tokens = tokens.at(1).split(',');
-      if((tokens.size() - 3) > 0)
+      QByteArray buf = line.simplified();
+      if(buf.startsWith("$$UNITS"))
       {
-        features++;
-        if((tokens.size() - 3) % 2 != 0)
+        QList<QByteArray> tokens = buf.split('/');
+        bool ok = false;
+        units = (tokens.size() == 2) ? tokens.at(1).toFloat(&ok) : 0.0f;
+        if(!ok)
         {
-          QString ss = QObject::tr("Polyline at line %1 does not contain an even number of elements: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
+          QString ss = QObject::tr("Unable to parse units from CLI file header: %1").arg(QString::fromStdString(buf.toStdString()));
           setErrorCondition(-1, ss);
-          return;
-        }
-        for(auto i = 3; i < (tokens.size() - 2); i++)
-        {
-          float val = tokens.at(i).toFloat(&ok);
-          if(!ok)
-          {
-            QString ss = QObject::tr("Unable to parse polyline coordinate from CLI file line %1: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-            setErrorCondition(-1, ss);
-            return;
-          }
-          tmpVertices.push_back(val);
-          if(i % 2 == 0)
-          {
-            tmpVertices.push_back(layerHeight);
-          }
-        }
-        int64_t numVerts = ((tokens.size() - 3) / 2) - 1;
-        int32_t edgeCounter = 0;
-        for(auto i = vertexCounter; i < (vertexCounter + numVerts); i++)
-        {
-          tmpEdges.push_back(i);
-          tmpEdges.push_back(i + 1);
-          edgeCounter++;
-        }
-        tmpEdges.pop_back();
-        tmpEdges.push_back(vertexCounter);
-        vertexCounter += numVerts;
-        for(auto i = 0; i < edgeCounter; i++)
-        {
-          tmpLayerIds.push_back(layer);
-          tmpFeatureIds.push_back(features);
+          err = -1;
         }
       }
     }
-    else if(buf.startsWith("$$HATCHES") || buf.startsWith("$HATCHES"))
+
+    if(err >= 0)
     {
-      tokens = buf.split('/');
-      if(tokens.size() != 2)
-      {
-        QString ss = QObject::tr("Unable to parse hatch from CLI file line %1: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-        setErrorCondition(-1, ss);
-        return;
-      }
-      tokens = tokens.at(1).split(',');
-      if((tokens.size() - 2) > 0)
-      {
-        features++;
-        if((tokens.size() - 2) % 4 != 0)
-        {
-          QString ss = QObject::tr("Hatch at line %1 does not contain an even number of elements: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-          setErrorCondition(-1, ss);
-          return;
-        }
-        for(auto i = 2; i < tokens.size(); i += 4)
-        {
-          for(auto j = 0; j < 4; j++)
-          {
-            float val = tokens.at(i + j).toFloat(&ok);
-            if(!ok)
-            {
-              QString ss = QObject::tr("Unable to parse hatch coordinate from CLI file line %1: %2").arg(lines).arg(QString::fromStdString(buf.toStdString()));
-              setErrorCondition(-1, ss);
-              return;
-            }
-            tmpVertices.push_back(val);
-            if(j % 2 != 0)
-            {
-              tmpVertices.push_back(layerHeight);
-            }
-          }
-        }
-        int64_t numVerts = ((tokens.size() - 2) / 2);
-        int32_t edgeCounter = 0;
-        for(auto i = vertexCounter; i < (vertexCounter + numVerts); i += 2)
-        {
-          tmpEdges.push_back(i);
-          tmpEdges.push_back(i + 1);
-          edgeCounter++;
-        }
-        vertexCounter += numVerts;
-        for(auto i = 0; i < edgeCounter; i++)
-        {
-          tmpLayerIds.push_back(layer);
-          tmpFeatureIds.push_back(features);
-        }
-      }
+      size_t offset = static_cast<size_t>(headerEnd) + std::strlen("$$HEADEREND");
+      err = readBinaryGeometry(data + offset, static_cast<size_t>(fileSize) - offset, tmpVertices, tmpEdges, tmpLayerIds, tmpFeatureIds);
     }
-    lines++;
+  }
+  else
+  {
+    err = readAsciiGeometry(data, static_cast<size_t>(fileSize), units, tmpVertices, tmpEdges, tmpLayerIds, tmpFeatureIds);
+  }
+
+  if(nullptr != mapped)
+  {
+    stream.unmap(mapped);
+  }
+  if(err < 0 || getCancel())
+  {
+    return;
   }
 
   tmpVertices.shrink_to_fit();
@@ -354,6 +568,226 @@ void ImportCLIFile::execute()
   notifyStatusMessage("Complete");
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ImportCLIFile::readAsciiGeometry(const char* data, size_t size, float& units, std::vector<float>& vertices, std::vector<int64_t>& edges, std::vector<int32_t>& layerIds,
+                                         std::vector<int32_t>& featureIds)
+{
+  // first pass: split the file into layers at the $$LAYER lines; everything before the first
+  // $$LAYER belongs to layer 0
+  std::vector<CLILayerSegment> segments(1);
+  segments[0].begin = 0;
+  const char* end = data + size;
+  for(const char* lineStart = data; lineStart < end;)
+  {
+    const char* lineEnd = TextParsing::FindLineEnd(lineStart, end);
+    const char* pos = TextParsing::SkipWhitespace(lineStart, lineEnd);
+    if(TextParsing::StartsWith(pos, lineEnd, "$$LAYER") || TextParsing::StartsWith(pos, lineEnd, "$$UNITS"))
+    {
+      bool isLayer = TextParsing::StartsWith(pos, lineEnd, "$$LAYER");
+      const char* slash = static_cast<const char*>(std::memchr(pos, '/', lineEnd - pos));
+      float value = 0.0f;
+      const char* valuePos = (nullptr != slash) ? slash + 1 : lineEnd;
+      if(nullptr == slash || !TextParsing::ParseFloat(valuePos, lineEnd, value) || TextParsing::SkipWhitespace(valuePos, lineEnd) != lineEnd)
+      {
+        QString ss = QObject::tr("Unable to parse %1 from CLI file line %2: %3")
+                         .arg(isLayer ? "layer height" : "units")
+                         .arg(TextParsing::LineNumber(data, lineStart))
+                         .arg(QString::fromLatin1(lineStart, static_cast<int32_t>(lineEnd - lineStart)).simplified());
+        setErrorCondition(-1, ss);
+        return -1;
+      }
+      if(isLayer)
+      {
+        segments.back().end = static_cast<size_t>(lineStart - data);
+        CLILayerSegment segment;
+        segment.begin = static_cast<size_t>(lineEnd - data);
+        segment.layer = segments.back().layer + 1;
+        segment.layerHeight = value;
+        segments.push_back(segment);
+      }
+      else
+      {
+        units = value;
+      }
+    }
+    lineStart = lineEnd + 1;
+  }
+  segments.back().end = size;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // second pass: count the vertices, edges and features of every layer, so that each layer can be
+  // parsed straight into its own part of the output arrays
+  for(int32_t pass = 0; pass < 2; pass++)
+  {
+    ParseCLILayersImpl impl(this, data, segments, (pass == 1), vertices.data(), edges.data(), layerIds.data(), featureIds.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, segments.size()), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.compute(0, segments.size());
+    }
+
+    if(getCancel())
+    {
+      return 0;
+    }
+
+    for(auto&& segment : segments)
+    {
+      if(segment.error != CLILayerSegment::NoError)
+      {
+        const char* lineStart = data + segment.errorPosition;
+        const char* lineEnd = TextParsing::FindLineEnd(lineStart, end);
+        QString ss = ErrorMessage(segment.error, TextParsing::LineNumber(data, lineStart), QString::fromLatin1(lineStart, static_cast<int32_t>(lineEnd - lineStart)).simplified());
+        setErrorCondition(-1, ss);
+        return -1;
+      }
+    }
+
+    if(pass == 0)
+    {
+      int64_t numVertices = 0;
+      int64_t numEdges = 0;
+      int32_t numFeatures = 0;
+      for(auto&& segment : segments)
+      {
+        segment.vertexOffset = numVertices;
+        segment.edgeOffset = numEdges;
+        segment.featureOffset = numFeatures;
+        numVertices += segment.numVertices;
+        numEdges += segment.numEdges;
+        numFeatures += segment.numFeatures;
+      }
+      vertices.resize(3 * numVertices);
+      edges.resize(2 * numEdges);
+      layerIds.resize(numEdges);
+      featureIds.resize(numEdges);
+    }
+  }
+
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ImportCLIFile::readBinaryGeometry(const char* data, size_t size, std::vector<float>& vertices, std::vector<int64_t>& edges, std::vector<int32_t>& layerIds, std::vector<int32_t>& featureIds)
+{
+  size_t pos = 0;
+  float layerHeight = 0.0f;
+  int32_t layer = 0;
+  int32_t features = 0;
+  int64_t vertexCounter = 0;
+  std::vector<float> coords;
+
+  // a trailing byte (e.g. a line feed) that cannot hold another command is ignored
+  while(pos + sizeof(uint16_t) <= size)
+  {
+    uint16_t command = 0;
+    ReadBinaryValue(data, size, pos, command);
+    bool longFormat = (command == k_StartLayerLong || command == k_StartPolyLineLong || command == k_StartHatchesLong);
+    bool ok = true;
+
+    if(command == k_StartLayerLong || command == k_StartLayerShort)
+    {
+      layer++;
+      ok = ReadBinaryCoordinates(data, size, pos, longFormat, 1, &layerHeight);
+    }
+    else if(command == k_StartPolyLineLong || command == k_StartPolyLineShort)
+    {
+      int64_t id = 0, direction = 0, numPoints = 0;
+      ok = ReadBinaryInteger(data, size, pos, longFormat, id) && ReadBinaryInteger(data, size, pos, longFormat, direction) && ReadBinaryInteger(data, size, pos, longFormat, numPoints) && numPoints >= 0;
+      if(ok && !BinaryCoordinatesFit(size, pos, longFormat, 2 * numPoints))
+      {
+        QString ss = QObject::tr("Binary CLI command %1 at byte %2 of the geometry section declares %3 coordinates, more than the remaining data holds").arg(command).arg(pos).arg(2 * numPoints);
+        setErrorCondition(-2, ss);
+        return -2;
+      }
+      if(ok)
+      {
+        coords.resize(2 * numPoints);
+        ok = ReadBinaryCoordinates(data, size, pos, longFormat, 2 * numPoints, coords.data());
+      }
+      // as in the ASCII format, the last point closes the polyline onto the first one
+      if(ok && numPoints > 1)
+      {
+        features++;
+        int64_t numVerts = numPoints - 1;
+        for(int64_t i = 0; i < numVerts; i++)
+        {
+          vertices.push_back(coords[2 * i + 0]);
+          vertices.push_back(coords[2 * i + 1]);
+          vertices.push_back(layerHeight);
+          edges.push_back(vertexCounter + i);
+          edges.push_back((i + 1 < numVerts) ? (vertexCounter + i + 1) : vertexCounter);
+          layerIds.push_back(layer);
+          featureIds.push_back(features);
+        }
+        vertexCounter += numVerts;
+      }
+    }
+    else if(command == k_StartHatchesLong || command == k_StartHatchesShort)
+    {
+      int64_t id = 0, numHatches = 0;
+      ok = ReadBinaryInteger(data, size, pos, longFormat, id) && ReadBinaryInteger(data, size, pos, longFormat, numHatches) && numHatches >= 0;
+      if(ok && !BinaryCoordinatesFit(size, pos, longFormat, 4 * numHatches))
+      {
+        QString ss = QObject::tr("Binary CLI command %1 at byte %2 of the geometry section declares %3 coordinates, more than the remaining data holds").arg(command).arg(pos).arg(4 * numHatches);
+        setErrorCondition(-2, ss);
+        return -2;
+      }
+      if(ok)
+      {
+        coords.resize(4 * numHatches);
+        ok = ReadBinaryCoordinates(data, size, pos, longFormat, 4 * numHatches, coords.data());
+      }
+      if(ok && numHatches > 0)
+      {
+        features++;
+        for(int64_t i = 0; i < 2 * numHatches; i++)
+        {
+          vertices.push_back(coords[2 * i + 0]);
+          vertices.push_back(coords[2 * i + 1]);
+          vertices.push_back(layerHeight);
+        }
+        for(int64_t i = 0; i < numHatches; i++)
+        {
+          edges.push_back(vertexCounter + 2 * i);
+          edges.push_back(vertexCounter + 2 * i + 1);
+          layerIds.push_back(layer);
+          featureIds.push_back(features);
+        }
+        vertexCounter += 2 * numHatches;
+      }
+    }
+    else
+    {
+      QString ss = QObject::tr("Unknown binary CLI command %1 at byte %2 of the geometry section").arg(command).arg(pos - sizeof(uint16_t));
+      setErrorCondition(-1, ss);
+      return -1;
+    }
+
+    if(!ok)
+    {
+      QString ss = QObject::tr("Binary CLI command %1 is truncated or malformed at byte %2 of the geometry section").arg(command).arg(pos);
+      setErrorCondition(-1, ss);
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -14,6 +14,10 @@
 #ifndef _importclifile_h_
 #define _importclifile_h_
 
+#include <vector>
+
+#include <QtCore/QFile>
+
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
@@ -146,6 +150,25 @@ protected:
   */
   void initialize();
 
+  /**
+   * @brief readAsciiGeometry Parses an ASCII CLI file in place. The file is split into its layers,
+   * which are then counted and parsed straight into the output arrays concurrently
+   * @param data Contents of the CLI file
+   * @param size Number of bytes in data
+   * @param units Receives the units scale factor from the header
+   * @return Integer error code
+   */
+  int32_t readAsciiGeometry(const char* data, size_t size, float& units, std::vector<float>& vertices, std::vector<int64_t>& edges, std::vector<int32_t>& layerIds, std::vector<int32_t>& featureIds);
+
+  /**
+   * @brief readBinaryGeometry Parses the binary geometry section of a CLI file, which directly
+   * follows $$HEADEREND. Both the long (32 bit) and short (16 bit) command formats are supported.
+   * @param data Start of the binary geometry section
+   * @param size Number of bytes in the binary geometry section
+   * @return Integer error code
+   */
+  int32_t readBinaryGeometry(const char* data, size_t size, std::vector<float>& vertices, std::vector<int64_t>& edges, std::vector<int32_t>& layerIds, std::vector<int32_t>& featureIds);
+
 private:
   ImportCLIFile(const ImportCLIFile&) = delete;  // Copy Constructor Not Implemented
   ImportCLIFile(ImportCLIFile&&) = delete;       // Move Constructor Not Implemented
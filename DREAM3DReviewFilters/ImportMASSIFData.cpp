@@ -10,10 +10,13 @@
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/StringOperations.h"
 
+#include "H5Support/H5Lite.h"
 #include "H5Support/H5ScopedSentinel.h"
 #include "H5Support/H5Utilities.h"
 #include "H5Support/QH5Utilities.h"
@@ -26,6 +29,7 @@ enum createdPathID : RenameDataPath::DataID_t
 {
   AttributeMatrixID20 = 20,
   AttributeMatrixID21 = 21,
+  StepAttributeMatrixID = 100, // one Attribute Matrix per step when importing a range of steps
 };
 
 namespace Detail
@@ -34,15 +38,76 @@ namespace Detail
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-IDataArray::Pointer readH5Dataset(hid_t locId, const QString& datasetPath, const std::vector<size_t>& tDims, const std::vector<size_t>& cDims)
+herr_t readH5Hyperslab(hid_t locId, const QString& datasetPath, const std::vector<size_t>& tDims, const std::vector<hsize_t>& start, const std::vector<hsize_t>& stride, T* data)
+{
+  hid_t datasetId = H5Dopen(locId, datasetPath.toLatin1().data(), H5P_DEFAULT);
+  if(datasetId < 0)
+  {
+    return -1;
+  }
+  hid_t fileSpaceId = H5Dget_space(datasetId);
+  int32_t rank = (fileSpaceId < 0) ? -1 : H5Sget_simple_extent_ndims(fileSpaceId);
+  if(rank < static_cast<int32_t>(tDims.size()))
+  {
+    H5Sclose(fileSpaceId);
+    H5Dclose(datasetId);
+    return -1;
+  }
+
+  // the tuple dimensions are stored slowest first (z, y, x), followed by the full component dimensions
+  std::vector<hsize_t> offset(rank, 0);
+  std::vector<hsize_t> step(rank, 1);
+  std::vector<hsize_t> count(rank, 0);
+  H5Sget_simple_extent_dims(fileSpaceId, count.data(), nullptr);
+  for(size_t i = 0; i < tDims.size(); i++)
+  {
+    offset[i] = start[i];
+    step[i] = stride[i];
+    count[i] = tDims[tDims.size() - 1 - i];
+  }
+
+  herr_t err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, offset.data(), step.data(), count.data(), nullptr);
+  hid_t memSpaceId = H5Screate_simple(rank, count.data(), nullptr);
+  if(err >= 0 && memSpaceId >= 0)
+  {
+    err = H5Dread(datasetId, H5Lite::HDFTypeForPrimType(static_cast<T>(0)), memSpaceId, fileSpaceId, H5P_DEFAULT, data);
+  }
+  else
+  {
+    err = -1;
+  }
+
+  if(memSpaceId >= 0)
+  {
+    H5Sclose(memSpaceId);
+  }
+  H5Sclose(fileSpaceId);
+  H5Dclose(datasetId);
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+IDataArray::Pointer readH5Dataset(hid_t locId, const QString& datasetPath, const std::vector<size_t>& tDims, const std::vector<size_t>& cDims, const std::vector<hsize_t>& start,
+                                  const std::vector<hsize_t>& stride)
 {
   herr_t err = -1;
   IDataArray::Pointer ptr;
 
   ptr = DataArray<T>::CreateArray(tDims, cDims, datasetPath, true);
 
+  // without a hyperslab the whole dataset is read; either way the data goes straight into the array
   T* data = (T*)(ptr->getVoidPointer(0));
-  err = QH5Lite::readPointerDataset(locId, datasetPath, data);
+  if(start.empty())
+  {
+    err = QH5Lite::readPointerDataset(locId, datasetPath, data);
+  }
+  else
+  {
+    err = readH5Hyperslab<T>(locId, datasetPath, tDims, start, stride, data);
+  }
   if(err < 0)
   {
     qDebug() << "readH5Data read error: " << __FILE__ << "(" << __LINE__ << ")";
@@ -58,7 +123,21 @@ IDataArray::Pointer readH5Dataset(hid_t locId, const QString& datasetPath, const
 ImportMASSIFData::ImportMASSIFData()
 : m_FilePrefix("Step-")
 , m_StepNumber(2)
+, m_ImportStepRange(false)
+, m_EndStepNumber(2)
+, m_StepIncrement(1)
+, m_ImportSubvolume(false)
 {
+  m_SubvolumeMinIndex[0] = 0;
+  m_SubvolumeMinIndex[1] = 0;
+  m_SubvolumeMinIndex[2] = 0;
+  m_SubvolumeMaxIndex[0] = 0;
+  m_SubvolumeMaxIndex[1] = 0;
+  m_SubvolumeMaxIndex[2] = 0;
+  m_SubvolumeStride[0] = 1;
+  m_SubvolumeStride[1] = 1;
+  m_SubvolumeStride[2] = 1;
+
   initialize();
 }
 
@@ -96,6 +175,21 @@ void ImportMASSIFData::setupFilterParameters()
     parameters.push_back(SIMPL_NEW_INTEGER_FP("Step Value", StepNumber, FilterParameter::Parameter, ImportMASSIFData));
   }
 
+  {
+    QStringList linkedProps = {"EndStepNumber", "StepIncrement"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Import Range of Steps", ImportStepRange, FilterParameter::Parameter, ImportMASSIFData, linkedProps));
+    parameters.push_back(SIMPL_NEW_INTEGER_FP("Last Step Value", EndStepNumber, FilterParameter::Parameter, ImportMASSIFData));
+    parameters.push_back(SIMPL_NEW_INTEGER_FP("Step Increment", StepIncrement, FilterParameter::Parameter, ImportMASSIFData));
+  }
+
+  {
+    QStringList linkedProps = {"SubvolumeMinIndex", "SubvolumeMaxIndex", "SubvolumeStride"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Import Subvolume", ImportSubvolume, FilterParameter::Parameter, ImportMASSIFData, linkedProps));
+    parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Minimum Voxel", SubvolumeMinIndex, FilterParameter::Parameter, ImportMASSIFData));
+    parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Maximum Voxel", SubvolumeMaxIndex, FilterParameter::Parameter, ImportMASSIFData));
+    parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Stride", SubvolumeStride, FilterParameter::Parameter, ImportMASSIFData));
+  }
+
   setFilterParameters(parameters);
 }
 
@@ -130,6 +224,22 @@ void ImportMASSIFData::dataCheck()
     return;
   }
 
+  if(m_ImportStepRange)
+  {
+    if(m_EndStepNumber < m_StepNumber || m_EndStepNumber > MASSIFUtilitiesConstants::ImportMassifData::MaxStepNumber)
+    {
+      QString ss = tr("The last step number must lie between the first step number and %1").arg(MASSIFUtilitiesConstants::ImportMassifData::MaxStepNumber);
+      setErrorCondition(-3011, ss);
+      return;
+    }
+    if(m_StepIncrement < 1)
+    {
+      QString ss = tr("The step increment must be at least 1");
+      setErrorCondition(-3012, ss);
+      return;
+    }
+  }
+
   if(m_FilePrefix.isEmpty())
   {
     QString ss = tr("The file prefix is empty.  Are you sure you meant to do this?");
@@ -169,17 +279,28 @@ void ImportMASSIFData::dataCheck()
   image->setSpacing(FloatVec3Type(res[0], res[1], res[2]));
   image->setOrigin(FloatVec3Type(origin[0], origin[1], origin[2]));
   image->setDimensions(SizeVec3Type(geoDims[0], geoDims[1], geoDims[2]));
+  m_HyperslabStart.clear();
+  m_HyperslabStride.clear();
+  if(m_ImportSubvolume && applySubvolume(image) < 0)
+  {
+    return;
+  }
   dc->setGeometry(image);
   if(getErrorCode() < 0)
   {
     return;
   }
+  SizeVec3Type imageDims = image->getDimensions();
+  std::vector<size_t> geometryDims = {imageDims[0], imageDims[1], imageDims[2]};
 
-  int err = 0;
-  AttributeMatrix::Pointer am = dc->createNonPrereqAttributeMatrix(this, MASSIFUtilitiesConstants::ImportMassifData::MassifAM, geoDims, AttributeMatrix::Type::Cell, AttributeMatrixID21);
-  if(getErrorCode() < 0 || err < 0)
+  // the geometry is shared by all steps, so only the arrays are read per step
+  std::vector<int32_t> steps(1, m_StepNumber);
+  if(m_ImportStepRange)
   {
-    return;
+    for(int32_t step = m_StepNumber + m_StepIncrement; step <= m_EndStepNumber; step += m_StepIncrement)
+    {
+      steps.push_back(step);
+    }
   }
 
   hid_t fileId = H5Utilities::openFile(m_MassifInputFilePath.toStdString(), true);
@@ -189,29 +310,95 @@ void ImportMASSIFData::dataCheck()
     setErrorCondition(-3003, ss);
     return;
   }
+  H5ScopedFileSentinel fileSentinel(&fileId, true);
 
-  QVector<QString> hdf5ArrayPaths = createHDF5DatasetPaths();
-
-  for(const auto& hdf5ArrayPath : hdf5ArrayPaths)
+  for(size_t i = 0; i < steps.size(); i++)
   {
-    QString parentPath = QH5Utilities::getParentPath(hdf5ArrayPath);
+    if(!getInPreflight())
+    {
+      if(getCancel())
+      {
+        return;
+      }
+      notifyStatusMessage(tr("Reading step %1 of %2").arg(i + 1).arg(steps.size()));
+    }
 
-    hid_t parentId = QH5Utilities::openHDF5Object(fileId, parentPath);
-    H5ScopedGroupSentinel sentinel(&parentId, false);
-    // Read dataset into DREAM.3D structure
-    QString objectName = QH5Utilities::getObjectNameFromPath(hdf5ArrayPath);
-    std::vector<size_t> geometryDims = {geoDims[0], geoDims[1], geoDims[2]};
-    IDataArray::Pointer dPtr = readIDataArray(parentId, objectName, geometryDims, getInPreflight());
-    if(dPtr == IDataArray::NullPointer())
+    // a single step keeps the default Attribute Matrix; a range of steps gets one Attribute Matrix per step
+    QString paddedStep = m_FilePrefix + StringOperations::GenerateIndexString(steps[i], MASSIFUtilitiesConstants::ImportMassifData::MaxStepNumber);
+    QString amName = m_ImportStepRange ? paddedStep : MASSIFUtilitiesConstants::ImportMassifData::MassifAM;
+    RenameDataPath::DataID_t amId = m_ImportStepRange ? static_cast<RenameDataPath::DataID_t>(StepAttributeMatrixID + i) : AttributeMatrixID21;
+    AttributeMatrix::Pointer am = dc->createNonPrereqAttributeMatrix(this, amName, geometryDims, AttributeMatrix::Type::Cell, amId);
+    if(getErrorCode() < 0)
     {
-      QString ss = tr("Could not read dataset '%1' at path '%2'").arg(objectName).arg(parentPath);
-      setErrorCondition(-3003, ss);
       return;
     }
-    am->insertOrAssign(dPtr);
+
+    QVector<QString> hdf5ArrayPaths = createHDF5DatasetPaths(paddedStep);
+
+    for(const auto& hdf5ArrayPath : hdf5ArrayPaths)
+    {
+      QString parentPath = QH5Utilities::getParentPath(hdf5ArrayPath);
+
+      hid_t parentId = QH5Utilities::openHDF5Object(fileId, parentPath);
+      H5ScopedGroupSentinel sentinel(&parentId, false);
+      // Read dataset into DREAM.3D structure
+      QString objectName = QH5Utilities::getObjectNameFromPath(hdf5ArrayPath);
+      IDataArray::Pointer dPtr = readIDataArray(parentId, objectName, geometryDims, getInPreflight());
+      if(dPtr == IDataArray::NullPointer())
+      {
+        QString ss = tr("Could not read dataset '%1' at path '%2'").arg(objectName).arg(parentPath);
+        setErrorCondition(-3003, ss);
+        return;
+      }
+      am->insertOrAssign(dPtr);
+    }
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ImportMASSIFData::applySubvolume(ImageGeom::Pointer image)
+{
+  SizeVec3Type volumeDims = image->getDimensions();
+  FloatVec3Type spacing = image->getSpacing();
+  FloatVec3Type origin = image->getOrigin();
+  size_t subvolumeDims[3] = {0, 0, 0};
+
+  for(size_t i = 0; i < 3; i++)
+  {
+    if(m_SubvolumeMinIndex[i] < 0 || m_SubvolumeMinIndex[i] > m_SubvolumeMaxIndex[i] || static_cast<size_t>(m_SubvolumeMaxIndex[i]) >= volumeDims[i])
+    {
+      QString ss = QObject::tr("The subvolume bounds (%1, %2) along axis %3 must satisfy 0 <= minimum <= maximum < %4")
+                       .arg(m_SubvolumeMinIndex[i])
+                       .arg(m_SubvolumeMaxIndex[i])
+                       .arg(i)
+                       .arg(volumeDims[i]);
+      setErrorCondition(-3013, ss);
+      return getErrorCode();
+    }
+    if(m_SubvolumeStride[i] < 1)
+    {
+      QString ss = QObject::tr("The subvolume stride along axis %1 must be at least 1").arg(i);
+      setErrorCondition(-3014, ss);
+      return getErrorCode();
+    }
+    subvolumeDims[i] = static_cast<size_t>((m_SubvolumeMaxIndex[i] - m_SubvolumeMinIndex[i]) / m_SubvolumeStride[i] + 1);
+    origin[i] += m_SubvolumeMinIndex[i] * spacing[i];
+    spacing[i] *= m_SubvolumeStride[i];
+  }
+
+  // the datasets store z slowest, so the hyperslab runs (z, y, x)
+  m_HyperslabStart = {static_cast<hsize_t>(m_SubvolumeMinIndex[2]), static_cast<hsize_t>(m_SubvolumeMinIndex[1]), static_cast<hsize_t>(m_SubvolumeMinIndex[0])};
+  m_HyperslabStride = {static_cast<hsize_t>(m_SubvolumeStride[2]), static_cast<hsize_t>(m_SubvolumeStride[1]), static_cast<hsize_t>(m_SubvolumeStride[0])};
+
+  image->setDimensions(subvolumeDims);
+  image->setSpacing(spacing);
+  image->setOrigin(origin);
+
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -238,10 +425,10 @@ QVector<DataArrayPath> ImportMASSIFData::createDataArrayPaths()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-QVector<QString> ImportMASSIFData::createHDF5DatasetPaths()
+QVector<QString> ImportMASSIFData::createHDF5DatasetPaths(const QString& paddedStep)
 {
   QVector<QString> arrayPaths;
-  QString parentPath = "/" + MASSIFUtilitiesConstants::ImportMassifData::DCGrpName + "/" + m_PaddedStep + "/" + MASSIFUtilitiesConstants::ImportMassifData::Datapoint;
+  QString parentPath = "/" + MASSIFUtilitiesConstants::ImportMassifData::DCGrpName + "/" + paddedStep + "/" + MASSIFUtilitiesConstants::ImportMassifData::Datapoint;
 
   arrayPaths.push_back(parentPath + "/" + MASSIFUtilitiesConstants::ImportMassifData::DFieldsGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::DField);
 
@@ -319,6 +506,7 @@ void ImportMASSIFData::getDataContainerGeometry(std::vector<size_t>& tDims, Floa
   }
 
   H5ScopedFileSentinel sentinel(&fileId, true);
+  tDims.resize(3);
 
   QString totalPath = MASSIFUtilitiesConstants::ImportMassifData::DCGrpName;
   hid_t gid = QH5Utilities::openHDF5Object(fileId, MASSIFUtilitiesConstants::ImportMassifData::DCGrpName);
@@ -508,7 +696,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
     {
       if(!metaDataOnly)
       {
-        ptr = Detail::readH5Dataset<bool>(gid, name, tDims, cDims);
+        ptr = Detail::readH5Dataset<bool>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
       }
       else
       {
@@ -529,7 +717,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<uint8_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<uint8_t>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -540,7 +728,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<uint16_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<uint16_t>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -551,7 +739,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<uint32_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<uint32_t>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -562,7 +750,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<uint64_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<uint64_t>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -573,7 +761,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<int8_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<int8_t>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -584,7 +772,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<int16_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<int16_t>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -595,7 +783,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<int32_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<int32_t>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -606,7 +794,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<int64_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<int64_t>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -624,7 +812,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<float>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<float>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -635,7 +823,7 @@ IDataArray::Pointer ImportMASSIFData::readIDataArray(hid_t gid, const QString& n
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<double>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<double>(gid, name, tDims, cDims, m_HyperslabStart, m_HyperslabStride);
         }
         else
         {
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <vector>
+
 #include "SIMPLib/Common/SIMPLArray.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/SIMPLib.h"
 
 #include "DREAM3DReview/DREAM3DReviewDLLExport.h"
@@ -21,6 +25,13 @@ class DREAM3DReview_EXPORT ImportMASSIFData : public AbstractFilter
   PYB11_PROPERTY(QString MassifInputFilePath READ getMassifInputFilePath WRITE setMassifInputFilePath)
   PYB11_PROPERTY(QString FilePrefix READ getFilePrefix WRITE setFilePrefix)
   PYB11_PROPERTY(int StepNumber READ getStepNumber WRITE setStepNumber)
+  PYB11_PROPERTY(bool ImportStepRange READ getImportStepRange WRITE setImportStepRange)
+  PYB11_PROPERTY(int EndStepNumber READ getEndStepNumber WRITE setEndStepNumber)
+  PYB11_PROPERTY(int StepIncrement READ getStepIncrement WRITE setStepIncrement)
+  PYB11_PROPERTY(bool ImportSubvolume READ getImportSubvolume WRITE setImportSubvolume)
+  PYB11_PROPERTY(IntVec3Type SubvolumeMinIndex READ getSubvolumeMinIndex WRITE setSubvolumeMinIndex)
+  PYB11_PROPERTY(IntVec3Type SubvolumeMaxIndex READ getSubvolumeMaxIndex WRITE setSubvolumeMaxIndex)
+  PYB11_PROPERTY(IntVec3Type SubvolumeStride READ getSubvolumeStride WRITE setSubvolumeStride)
 
 public:
   SIMPL_SHARED_POINTERS(ImportMASSIFData)
@@ -38,6 +49,27 @@ public:
   SIMPL_FILTER_PARAMETER(int, StepNumber)
   Q_PROPERTY(int StepNumber READ getStepNumber WRITE setStepNumber)
 
+  SIMPL_FILTER_PARAMETER(bool, ImportStepRange)
+  Q_PROPERTY(bool ImportStepRange READ getImportStepRange WRITE setImportStepRange)
+
+  SIMPL_FILTER_PARAMETER(int, EndStepNumber)
+  Q_PROPERTY(int EndStepNumber READ getEndStepNumber WRITE setEndStepNumber)
+
+  SIMPL_FILTER_PARAMETER(int, StepIncrement)
+  Q_PROPERTY(int StepIncrement READ getStepIncrement WRITE setStepIncrement)
+
+  SIMPL_FILTER_PARAMETER(bool, ImportSubvolume)
+  Q_PROPERTY(bool ImportSubvolume READ getImportSubvolume WRITE setImportSubvolume)
+
+  SIMPL_FILTER_PARAMETER(IntVec3Type, SubvolumeMinIndex)
+  Q_PROPERTY(IntVec3Type SubvolumeMinIndex READ getSubvolumeMinIndex WRITE setSubvolumeMinIndex)
+
+  SIMPL_FILTER_PARAMETER(IntVec3Type, SubvolumeMaxIndex)
+  Q_PROPERTY(IntVec3Type SubvolumeMaxIndex READ getSubvolumeMaxIndex WRITE setSubvolumeMaxIndex)
+
+  SIMPL_FILTER_PARAMETER(IntVec3Type, SubvolumeStride)
+  Q_PROPERTY(IntVec3Type SubvolumeStride READ getSubvolumeStride WRITE setSubvolumeStride)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -136,6 +168,8 @@ protected:
 
 private:
   QString m_PaddedStep = "";
+  std::vector<hsize_t> m_HyperslabStart;
+  std::vector<hsize_t> m_HyperslabStride;
 
   DEFINE_DATAARRAY_WEAKPTR(float, DField)
   DEFINE_DATAARRAY_WEAKPTR(float, EField)
@@ -149,9 +183,18 @@ private:
 
   /**
    * @brief createHDF5DatasetPaths
+   * @param paddedStep Name of the step group, e.g. Step-000002
    * @return
    */
-  QVector<QString> createHDF5DatasetPaths();
+  QVector<QString> createHDF5DatasetPaths(const QString& paddedStep);
+
+  /**
+   * @brief applySubvolume Validates the subvolume parameters against the dimensions of the geometry,
+   * sets the geometry to the subvolume and prepares the hyperslab used to read the arrays
+   * @param image Geometry holding the dimensions of the complete volume
+   * @return Integer error code
+   */
+  int32_t applySubvolume(ImageGeom::Pointer image);
 
   /**
    * @brief getDataContainerGeometry
@@ -162,7 +205,7 @@ private:
   void getDataContainerGeometry(std::vector<size_t>& tDims, FloatVec3Type& origin, FloatVec3Type& spacing);
 
   /**
-   * @brief readIDataArray
+   * @brief readIDataArray Reads a dataset, restricted to the subvolume hyperslab when one is set
    * @param gid
    * @param name
    * @param metaDataOnly
@@ -0,0 +1,421 @@
+/* ============================================================================
+* Software developed by US federal government employees (including military personnel)
+* as part of their official duties is not subject to copyright protection and is
+* considered “public domain” (see 17 USC Section 105). Public domain software can be used
+* by anyone for any purpose, and cannot be released under a copyright license
+* (including typical open source software licenses).
+*
+* This source code file was originally written by United States DoD employees. The
+* original source code files are released into the Public Domain.
+*
+* Subsequent changes to the codes by others may elect to add a copyright and license
+* for those changes.
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ImportTDMSFile.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <QtCore/QFileInfo>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/PreflightUpdatedValueFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
+
+#include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewVersion.h"
+
+/* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
+enum createdPathID : RenameDataPath::DataID_t
+{
+  AttributeMatrixID21 = 21,
+
+  DataContainerID = 1
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ImportTDMSFile::ImportTDMSFile()
+: m_InputFile("")
+, m_TDMSGroupName("")
+, m_ChannelNames("")
+, m_DataContainerName("TDMSDataContainer")
+, m_AttributeMatrixName("ChannelData")
+, m_Proxy(nullptr)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ImportTDMSFile::~ImportTDMSFile() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportTDMSFile::setupFilterParameters()
+{
+  FilterParameterVectorType parameters;
+  parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Input TDMS File", InputFile, FilterParameter::Parameter, ImportTDMSFile, "*.tdms", "TDMS"));
+  parameters.push_back(SIMPL_NEW_PREFLIGHTUPDATEDVALUE_FP("File Information", FileInformation, FilterParameter::Parameter, ImportTDMSFile));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Group", TDMSGroupName, FilterParameter::Parameter, ImportTDMSFile));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Channels (Comma Separated)", ChannelNames, FilterParameter::Parameter, ImportTDMSFile));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ImportTDMSFile));
+  parameters.push_back(SeparatorFilterParameter::New("Channel Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Attribute Matrix", AttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ImportTDMSFile));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportTDMSFile::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setInputFile(reader->readString("InputFile", getInputFile()));
+  setTDMSGroupName(reader->readString("TDMSGroupName", getTDMSGroupName()));
+  setChannelNames(reader->readString("ChannelNames", getChannelNames()));
+  setDataContainerName(reader->readString("DataContainerName", getDataContainerName()));
+  setAttributeMatrixName(reader->readString("AttributeMatrixName", getAttributeMatrixName()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportTDMSFile::initialize()
+{
+  m_FileInformation.clear();
+  m_ChannelPaths.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ImportTDMSFile::getFileInformation()
+{
+  return m_FileInformation;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ImportTDMSFile::readFileMetaData()
+{
+  QFileInfo fi(getInputFile());
+  if(nullptr != m_Proxy && m_ProxyFile == fi.absoluteFilePath() && m_ProxyLastModified == fi.lastModified())
+  {
+    return 0;
+  }
+
+  m_Proxy.reset();
+  try
+  {
+    TDMSFileProxy::Pointer proxy = TDMSFileProxy::New(getInputFile().toStdString());
+    proxy->readMetaData();
+    m_Proxy = proxy;
+  } catch(const std::exception& e)
+  {
+    QString ss = QObject::tr("Error reading the meta data of the TDMS file: %1").arg(e.what());
+    setErrorCondition(-11002, ss);
+    return getErrorCode();
+  }
+
+  m_ProxyFile = fi.absoluteFilePath();
+  m_ProxyLastModified = fi.lastModified();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportTDMSFile::dataCheck()
+{
+  clearErrorCode();
+  clearWarningCode();
+  initialize();
+
+  QFileInfo fi(getInputFile());
+
+  if(getInputFile().isEmpty())
+  {
+    QString ss = QObject::tr("The input TDMS file must be set");
+    setErrorCondition(-387, ss);
+    return;
+  }
+  if(!fi.exists())
+  {
+    QString ss = QObject::tr("The input TDMS file does not exist");
+    setErrorCondition(-388, ss);
+    return;
+  }
+
+  if(readFileMetaData() < 0)
+  {
+    return;
+  }
+
+  // group the channels by the group whose path prefixes theirs, keeping the order of the file
+  std::unordered_map<std::string, TDMSObject::Pointer> objects = m_Proxy->objects();
+  std::vector<std::string> paths = m_Proxy->objectPaths();
+  std::vector<TDMSObject::Pointer> groups;
+  std::vector<std::vector<TDMSObject::Pointer>> groupChannels;
+
+  for(const auto& path : paths)
+  {
+    if(objects[path]->objectType() == TDMSObject::Type::Group)
+    {
+      groups.push_back(objects[path]);
+      groupChannels.emplace_back();
+    }
+  }
+  for(const auto& path : paths)
+  {
+    if(objects[path]->objectType() != TDMSObject::Type::Channel)
+    {
+      continue;
+    }
+    for(size_t i = 0; i < groups.size(); i++)
+    {
+      std::string groupPath = groups[i]->path() + "/";
+      if(path.compare(0, groupPath.size(), groupPath) == 0)
+      {
+        groupChannels[i].push_back(objects[path]);
+        break;
+      }
+    }
+  }
+
+  QStringList groupNames;
+  QStringList info;
+  for(size_t i = 0; i < groups.size(); i++)
+  {
+    QString groupName = QString::fromStdString(groups[i]->baseName());
+    groupNames << groupName;
+    info << QObject::tr("Group '%1'").arg(groupName);
+    for(const auto& channel : groupChannels[i])
+    {
+      size_t numValues = (nullptr != channel->data()) ? channel->data()->getNumberOfTuples() : 0;
+      QString typeName = (nullptr != channel->dataType()) ? QString::fromStdString(channel->dataType()->name()) : QString("No Data");
+      info << QObject::tr("    %1 (%2, %3 values)").arg(QString::fromStdString(channel->baseName())).arg(typeName).arg(numValues);
+    }
+  }
+  m_FileInformation = info.join("\n");
+
+  // an empty group name selects the only group, if there is just one
+  int32_t groupIndex = -1;
+  if(getTDMSGroupName().isEmpty())
+  {
+    if(groups.size() != 1)
+    {
+      QString ss = QObject::tr("The TDMS file contains %1 groups (%2); the group to import must be set").arg(groups.size()).arg(groupNames.join(", "));
+      setErrorCondition(-11003, ss);
+      return;
+    }
+    groupIndex = 0;
+  }
+  else
+  {
+    groupIndex = groupNames.indexOf(getTDMSGroupName());
+    if(groupIndex < 0)
+    {
+      QString ss = QObject::tr("The group '%1' does not exist in the TDMS file; available groups are: %2").arg(getTDMSGroupName()).arg(groupNames.join(", "));
+      setErrorCondition(-11004, ss);
+      return;
+    }
+  }
+
+  // an empty channel list selects every channel of the group that holds data
+  std::vector<TDMSObject::Pointer>& channels = groupChannels[groupIndex];
+  std::vector<TDMSObject::Pointer> selected;
+  QStringList channelNames = getChannelNames().split(',', QString::SkipEmptyParts);
+  if(channelNames.isEmpty())
+  {
+    std::copy_if(std::begin(channels), std::end(channels), std::back_inserter(selected), [](const TDMSObject::Pointer& channel) { return nullptr != channel->data(); });
+  }
+  for(const auto& channelName : channelNames)
+  {
+    std::string name = channelName.trimmed().toStdString();
+    auto iter = std::find_if(std::begin(channels), std::end(channels), [&name](const TDMSObject::Pointer& channel) { return channel->baseName() == name; });
+    if(iter == std::end(channels))
+    {
+      QString ss = QObject::tr("The channel '%1' does not exist in group '%2'").arg(channelName.trimmed()).arg(groupNames[groupIndex]);
+      setErrorCondition(-11005, ss);
+      return;
+    }
+    if(nullptr == (*iter)->data())
+    {
+      QString ss = QObject::tr("The channel '%1' in group '%2' does not hold any data").arg(channelName.trimmed()).arg(groupNames[groupIndex]);
+      setErrorCondition(-11006, ss);
+      return;
+    }
+    if(std::find(std::begin(selected), std::end(selected), *iter) == std::end(selected))
+    {
+      selected.push_back(*iter);
+    }
+  }
+
+  if(selected.empty())
+  {
+    QString ss = QObject::tr("The group '%1' does not contain any channels with data").arg(groupNames[groupIndex]);
+    setErrorCondition(-11007, ss);
+    return;
+  }
+
+  size_t numTuples = selected[0]->data()->getNumberOfTuples();
+  for(const auto& channel : selected)
+  {
+    if(channel->data()->getNumberOfTuples() != numTuples)
+    {
+      QString ss = QObject::tr("All imported channels must have the same number of values; channel '%1' has %2 values and channel '%3' has %4 values")
+                       .arg(QString::fromStdString(selected[0]->baseName()))
+                       .arg(numTuples)
+                       .arg(QString::fromStdString(channel->baseName()))
+                       .arg(channel->data()->getNumberOfTuples());
+      setErrorCondition(-11008, ss);
+      return;
+    }
+  }
+
+  DataContainer::Pointer dc = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getDataContainerName(), DataContainerID);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  std::vector<size_t> tDims(1, numTuples);
+  AttributeMatrix::Pointer am = dc->createNonPrereqAttributeMatrix(this, getAttributeMatrixName(), tDims, AttributeMatrix::Type::Generic, AttributeMatrixID21);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  // the arrays generated from the meta data are only allocated when the channels are read
+  for(const auto& channel : selected)
+  {
+    am->insertOrAssign(channel->data());
+    m_ChannelPaths.push_back(channel->path());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportTDMSFile::preflight()
+{
+  // These are the REQUIRED lines of CODE to make sure the filter behaves correctly
+  setInPreflight(true);              // Set the fact that we are preflighting.
+  emit preflightAboutToExecute();    // Emit this signal so that other widgets can do one file update
+  emit updateFilterParameters(this); // Emit this signal to have the widgets push their values down to the filter
+  dataCheck();                       // Run our DataCheck to make sure everthing is setup correctly
+  emit preflightExecuted();          // We are done preflighting this filter
+  setInPreflight(false);             // Inform the system this filter is NOT in preflight mode anymore.
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportTDMSFile::execute()
+{
+  clearErrorCode();
+  clearWarningCode();
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  notifyStatusMessage(QObject::tr("Reading %1 channels").arg(m_ChannelPaths.size()));
+
+  try
+  {
+    m_Proxy->readRawData(m_ChannelPaths);
+  } catch(const std::exception& e)
+  {
+    QString ss = QObject::tr("Error reading the channel data of the TDMS file: %1").arg(e.what());
+    setErrorCondition(-11009, ss);
+  }
+
+  // the imported arrays now belong to the data container array; the next run reads the file again
+  m_Proxy.reset();
+
+  notifyStatusMessage("Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer ImportTDMSFile::newFilterInstance(bool copyFilterParameters) const
+{
+  ImportTDMSFile::Pointer filter = ImportTDMSFile::New();
+  if(copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ImportTDMSFile::getCompiledLibraryName() const
+{
+  return DREAM3DReviewConstants::DREAM3DReviewBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ImportTDMSFile::getBrandingString() const
+{
+  return "DREAM3DReview";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ImportTDMSFile::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << DREAM3DReview::Version::Major() << "." << DREAM3DReview::Version::Minor() << "." << DREAM3DReview::Version::Patch();
+  return version;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ImportTDMSFile::getGroupName() const
+{
+  return SIMPL::FilterGroups::IOFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ImportTDMSFile::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::InputFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ImportTDMSFile::getHumanLabel() const
+{
+  return "Import TDMS File";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QUuid ImportTDMSFile::getUuid()
+{
+  return QUuid("{d935e83a-600e-4eba-a6f3-f52bb55cc236}");
+}
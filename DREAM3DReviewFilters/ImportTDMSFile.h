@@ -0,0 +1,189 @@
+/* ============================================================================
+* Software developed by US federal government employees (including military personnel)
+* as part of their official duties is not subject to copyright protection and is
+* considered “public domain” (see 17 USC Section 105). Public domain software can be used
+* by anyone for any purpose, and cannot be released under a copyright license
+* (including typical open source software licenses).
+*
+* This source code file was originally written by United States DoD employees. The
+* original source code files are released into the Public Domain.
+*
+* Subsequent changes to the codes by others may elect to add a copyright and license
+* for those changes.
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QDateTime>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "DREAM3DReview/TDMSSupport/TDMSFileProxy.h"
+
+#include "DREAM3DReview/DREAM3DReviewDLLExport.h"
+
+/**
+ * @brief The ImportTDMSFile class. See [Filter documentation](@ref importtdmsfile) for details.
+ */
+class DREAM3DReview_EXPORT ImportTDMSFile : public AbstractFilter
+{
+  Q_OBJECT
+  PYB11_CREATE_BINDINGS(ImportTDMSFile SUPERCLASS AbstractFilter)
+  PYB11_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
+  PYB11_PROPERTY(QString TDMSGroupName READ getTDMSGroupName WRITE setTDMSGroupName)
+  PYB11_PROPERTY(QString ChannelNames READ getChannelNames WRITE setChannelNames)
+  PYB11_PROPERTY(QString DataContainerName READ getDataContainerName WRITE setDataContainerName)
+  PYB11_PROPERTY(QString AttributeMatrixName READ getAttributeMatrixName WRITE setAttributeMatrixName)
+
+public:
+  SIMPL_SHARED_POINTERS(ImportTDMSFile)
+  SIMPL_FILTER_NEW_MACRO(ImportTDMSFile)
+  SIMPL_TYPE_MACRO_SUPER_OVERRIDE(ImportTDMSFile, AbstractFilter)
+
+  ~ImportTDMSFile() override;
+
+  SIMPL_FILTER_PARAMETER(QString, InputFile)
+  Q_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
+
+  SIMPL_FILTER_PARAMETER(QString, TDMSGroupName)
+  Q_PROPERTY(QString TDMSGroupName READ getTDMSGroupName WRITE setTDMSGroupName)
+
+  SIMPL_FILTER_PARAMETER(QString, ChannelNames)
+  Q_PROPERTY(QString ChannelNames READ getChannelNames WRITE setChannelNames)
+
+  SIMPL_FILTER_PARAMETER(QString, DataContainerName)
+  Q_PROPERTY(QString DataContainerName READ getDataContainerName WRITE setDataContainerName)
+
+  SIMPL_FILTER_PARAMETER(QString, AttributeMatrixName)
+  Q_PROPERTY(QString AttributeMatrixName READ getAttributeMatrixName WRITE setAttributeMatrixName)
+
+  /**
+   * @brief getFileInformation Returns the groups and channels found in the meta data of the input file
+   * @return Listing of the groups and channels
+   */
+  QString getFileInformation();
+  Q_PROPERTY(QString FileInformation READ getFileInformation)
+
+  /**
+   * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+   */
+  const QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+  */
+  const QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  const QString getFilterVersion() const override;
+
+  /**
+   * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+   */
+  AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+  /**
+   * @brief getGroupName Reimplemented from @see AbstractFilter class
+   */
+  const QString getGroupName() const override;
+
+  /**
+   * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+   */
+  const QString getSubGroupName() const override;
+
+  /**
+   * @brief getUuid Return the unique identifier for this filter.
+   * @return A QUuid object.
+   */
+  const QUuid getUuid() override;
+
+  /**
+   * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+   */
+  const QString getHumanLabel() const override;
+
+  /**
+   * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void setupFilterParameters() override;
+
+  /**
+   * @brief readFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
+
+  /**
+   * @brief execute Reimplemented from @see AbstractFilter class
+   */
+  void execute() override;
+
+  /**
+  * @brief preflight Reimplemented from @see AbstractFilter class
+  */
+  void preflight() override;
+
+signals:
+  /**
+   * @brief updateFilterParameters Emitted when the Filter requests all the latest Filter parameters
+   * be pushed from a user-facing control (such as a widget)
+   * @param filter Filter instance pointer
+   */
+  void updateFilterParameters(AbstractFilter* filter);
+
+  /**
+   * @brief parametersChanged Emitted when any Filter parameter is changed internally
+   */
+  void parametersChanged();
+
+  /**
+   * @brief preflightAboutToExecute Emitted just before calling dataCheck()
+   */
+  void preflightAboutToExecute();
+
+  /**
+   * @brief preflightExecuted Emitted just after calling dataCheck()
+   */
+  void preflightExecuted();
+
+protected:
+  ImportTDMSFile();
+
+  /**
+   * @brief readFileMetaData Reads the meta data of the input file, reusing the meta data read during
+   * a previous preflight if the file has not changed since
+   * @return Integer error code
+   */
+  int32_t readFileMetaData();
+
+  /**
+   * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
+   */
+  void dataCheck();
+
+  /**
+   * @brief Initializes all the private instance variables.
+   */
+  void initialize();
+
+private:
+  TDMSFileProxy::Pointer m_Proxy;
+  QString m_ProxyFile;
+  QDateTime m_ProxyLastModified;
+  QString m_FileInformation;
+  std::vector<std::string> m_ChannelPaths;
+
+public:
+  ImportTDMSFile(const ImportTDMSFile&) = delete;            // Copy Constructor Not Implemented
+  ImportTDMSFile(ImportTDMSFile&&) = delete;                 // Move Constructor Not Implemented
+  ImportTDMSFile& operator=(const ImportTDMSFile&) = delete; // Copy Assignment Not Implemented
+  ImportTDMSFile& operator=(ImportTDMSFile&&) = delete;      // Move Assignment Not Implemented
+};
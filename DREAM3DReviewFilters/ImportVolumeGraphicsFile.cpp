@@ -13,29 +13,87 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ImportVolumeGraphicsFile.h"
 
+#include <algorithm>
+
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/ScopedFileMonitor.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/CTSubvolumeReader.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+/**
+ * @brief The FlipSlicesImpl class reverses the x and y axes of a range of z-slices in place. Flipping
+ * both in-plane axes maps the in-slice index i to (sliceSize - 1 - i), so each slice is simply reversed.
+ */
+class FlipSlicesImpl
+{
+public:
+  FlipSlicesImpl(float* data, size_t sliceSize)
+  : m_Data(data)
+  , m_SliceSize(sliceSize)
+  {
+  }
+  virtual ~FlipSlicesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t z = start; z < end; z++)
+    {
+      float* slice = m_Data + z * m_SliceSize;
+      std::reverse(slice, slice + m_SliceSize);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_Data;
+  size_t m_SliceSize;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 ImportVolumeGraphicsFile::ImportVolumeGraphicsFile()
 : m_InputFile("")
 , m_InputHeaderFile("")
+, m_ImportSubvolume(false)
+, m_AverageSubvolumeBins(false)
 , m_DataContainerName("ImageDataContainer")
 , m_CellAttributeMatrixName("CellData")
 , m_DensityArrayName("Density")
 {
+  m_SubvolumeMinIndex[0] = 0;
+  m_SubvolumeMinIndex[1] = 0;
+  m_SubvolumeMinIndex[2] = 0;
+  m_SubvolumeMaxIndex[0] = 0;
+  m_SubvolumeMaxIndex[1] = 0;
+  m_SubvolumeMaxIndex[2] = 0;
+  m_SubvolumeStride[0] = 1;
+  m_SubvolumeStride[1] = 1;
+  m_SubvolumeStride[2] = 1;
 }
 
 // -----------------------------------------------------------------------------
@@ -51,6 +109,16 @@ void ImportVolumeGraphicsFile::setupFilterParameters()
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Input CT File", InputFile, FilterParameter::Parameter, ImportVolumeGraphicsFile, "*.vol", "Voxel data"));
   parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Input Header File", InputHeaderFile, FilterParameter::Parameter, ImportVolumeGraphicsFile, "*.vgi", "NSI header"));
+  QStringList linkedProps;
+  linkedProps << "SubvolumeMinIndex"
+              << "SubvolumeMaxIndex"
+              << "SubvolumeStride"
+              << "AverageSubvolumeBins";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Import Subvolume", ImportSubvolume, FilterParameter::Parameter, ImportVolumeGraphicsFile, linkedProps));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Minimum Voxel", SubvolumeMinIndex, FilterParameter::Parameter, ImportVolumeGraphicsFile));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Maximum Voxel", SubvolumeMaxIndex, FilterParameter::Parameter, ImportVolumeGraphicsFile));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Stride", SubvolumeStride, FilterParameter::Parameter, ImportVolumeGraphicsFile));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Average Voxels Within Stride", AverageSubvolumeBins, FilterParameter::Parameter, ImportVolumeGraphicsFile));
   parameters.push_back(SIMPL_NEW_STRING_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ImportVolumeGraphicsFile));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Attribute Matrix", CellAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ImportVolumeGraphicsFile));
@@ -66,6 +134,11 @@ void ImportVolumeGraphicsFile::readFilterParameters(AbstractFilterParametersRead
   reader->openFilterGroup(this, index);
   setInputFile(reader->readString("InputFile", getInputFile()));
   setInputHeaderFile(reader->readString("InputHeaderFile", getInputHeaderFile()));
+  setImportSubvolume(reader->readValue("ImportSubvolume", getImportSubvolume()));
+  setSubvolumeMinIndex(reader->readIntVec3("SubvolumeMinIndex", getSubvolumeMinIndex()));
+  setSubvolumeMaxIndex(reader->readIntVec3("SubvolumeMaxIndex", getSubvolumeMaxIndex()));
+  setSubvolumeStride(reader->readIntVec3("SubvolumeStride", getSubvolumeStride()));
+  setAverageSubvolumeBins(reader->readValue("AverageSubvolumeBins", getAverageSubvolumeBins()));
   setDataContainerName(reader->readString("DataContainerName", getDataContainerName()));
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setDensityArrayName(reader->readString("DensityArrayName", getDensityArrayName()));
@@ -149,6 +222,17 @@ void ImportVolumeGraphicsFile::dataCheck()
     return;
   }
 
+  m_VolumeDimensions = image->getDimensions();
+
+  if(getImportSubvolume())
+  {
+    err = ApplyCTSubvolume(this, image, getSubvolumeMinIndex(), getSubvolumeMaxIndex(), getSubvolumeStride());
+    if(err < 0)
+    {
+      return;
+    }
+  }
+
   DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getDataContainerName());
 
   if(getErrorCode() < 0)
@@ -238,39 +322,74 @@ int32_t ImportVolumeGraphicsFile::readBinaryCTFile(size_t dims[3])
 
   float* ptr = m_DensityPtr.lock()->getPointer(0);
 
-  size_t index = 0;
-  size_t totalPoints = dims[0] * dims[1] * dims[2];
-  int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
-  int64_t prog = 1;
-  int64_t progressInt = 0;
-  int64_t counter = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  for(size_t z = 0; z < dims[2]; z++)
+  // read blocks of whole slices straight into the destination array, then flip x/y in place on each slice
+  size_t sliceSize = dims[0] * dims[1];
+  size_t slicesPerBlock = std::max(static_cast<size_t>(1), static_cast<size_t>(64 * 1024 * 1024) / (sliceSize * sizeof(float)));
+
+  for(size_t z = 0; z < dims[2]; z += slicesPerBlock)
   {
-    for(size_t y = 0; y < dims[1]; y++)
+    if(getCancel())
     {
-      for(size_t x = 0; x < dims[0]; x++)
-      {
-        // Compute the proper index into the final storage array
-        index = (dims[0] * dims[1] * z) + (dims[0] * (dims[1] - y - 1)) + (dims[0] - x - 1);
-        fread(ptr + index, sizeof(float), 1, f);
+      return error;
+    }
 
-        // Check for progress
-        if(counter > prog)
-        {
-          progressInt = static_cast<int64_t>((static_cast<float>(counter) / totalPoints) * 100.0f);
-          QString ss = QObject::tr("Reading Data || %1% Completed").arg(progressInt);
-          notifyStatusMessage(ss);
-          prog = prog + progIncrement;
-        }
-        counter++;
-      }
+    size_t numSlices = std::min(slicesPerBlock, dims[2] - z);
+    size_t numValues = numSlices * sliceSize;
+    if(fread(ptr + z * sliceSize, sizeof(float), numValues, f) != numValues)
+    {
+      QString ss = QObject::tr("Error reading binary input file: %1").arg(getInputFile());
+      setErrorCondition(-100, ss);
+      return getErrorCode();
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(z, z + numSlices), FlipSlicesImpl(ptr, sliceSize), tbb::auto_partitioner());
     }
+    else
+#endif
+    {
+      FlipSlicesImpl serial(ptr, sliceSize);
+      serial.compute(z, z + numSlices);
+    }
+
+    int64_t progressInt = static_cast<int64_t>((static_cast<float>(z + numSlices) / dims[2]) * 100.0f);
+    QString ss = QObject::tr("Reading Data || %1% Completed").arg(progressInt);
+    notifyStatusMessage(ss);
   }
 
   return error;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ImportVolumeGraphicsFile::readBinaryCTSubvolume(size_t dims[3])
+{
+  QFileInfo fi(getInputFile());
+  size_t filesize = static_cast<size_t>(fi.size());
+  size_t allocatedBytes = m_VolumeDimensions[0] * m_VolumeDimensions[1] * m_VolumeDimensions[2] * sizeof(float);
+
+  if(sanityCheckFileSizeVersusAllocatedSize(allocatedBytes, filesize) < 0)
+  {
+    QString ss = QObject::tr("Binary file size is smaller than the number of bytes in the volume");
+    setErrorCondition(-100, ss);
+    return getErrorCode();
+  }
+
+  std::vector<QString> fileNames(1, getInputFile());
+  std::vector<size_t> zOffsets(1, 0);
+
+  float* ptr = m_DensityPtr.lock()->getPointer(0);
+  return ReadCTSubvolume(this, fileNames, zOffsets, m_VolumeDimensions, getSubvolumeMinIndex(), getSubvolumeMaxIndex(), getSubvolumeStride(), getAverageSubvolumeBins(), ptr, dims);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -401,7 +520,14 @@ void ImportVolumeGraphicsFile::execute()
 
   SizeVec3Type dims = image->getDimensions();
 
-  err = readBinaryCTFile(dims.data());
+  if(getImportSubvolume())
+  {
+    err = readBinaryCTSubvolume(dims.data());
+  }
+  else
+  {
+    err = readBinaryCTFile(dims.data());
+  }
 
   if(err < 0)
   {
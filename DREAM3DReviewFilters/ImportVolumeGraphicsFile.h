@@ -17,6 +17,7 @@
 #include <QtCore/QFile>
 
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/SIMPLib.h"
@@ -41,6 +42,21 @@ public:
   SIMPL_FILTER_PARAMETER(QString, InputHeaderFile)
   Q_PROPERTY(QString InputHeaderFile READ getInputHeaderFile WRITE setInputHeaderFile)
 
+  SIMPL_FILTER_PARAMETER(bool, ImportSubvolume)
+  Q_PROPERTY(bool ImportSubvolume READ getImportSubvolume WRITE setImportSubvolume)
+
+  SIMPL_FILTER_PARAMETER(IntVec3Type, SubvolumeMinIndex)
+  Q_PROPERTY(IntVec3Type SubvolumeMinIndex READ getSubvolumeMinIndex WRITE setSubvolumeMinIndex)
+
+  SIMPL_FILTER_PARAMETER(IntVec3Type, SubvolumeMaxIndex)
+  Q_PROPERTY(IntVec3Type SubvolumeMaxIndex READ getSubvolumeMaxIndex WRITE setSubvolumeMaxIndex)
+
+  SIMPL_FILTER_PARAMETER(IntVec3Type, SubvolumeStride)
+  Q_PROPERTY(IntVec3Type SubvolumeStride READ getSubvolumeStride WRITE setSubvolumeStride)
+
+  SIMPL_FILTER_PARAMETER(bool, AverageSubvolumeBins)
+  Q_PROPERTY(bool AverageSubvolumeBins READ getAverageSubvolumeBins WRITE setAverageSubvolumeBins)
+
   SIMPL_FILTER_PARAMETER(QString, DataContainerName)
   Q_PROPERTY(QString DataContainerName READ getDataContainerName WRITE setDataContainerName)
 
@@ -156,6 +172,14 @@ protected:
    */
   int32_t readBinaryCTFile(size_t dims[3]);
 
+  /**
+   * @brief readBinaryCTSubvolume Reads the selected subvolume of the raw binary CT data, seeking to
+   * the rows that intersect it and optionally averaging the voxels of each stride bin
+   * @param dims Dimensions of the imported subvolume
+   * @return Integer error code
+   */
+  int32_t readBinaryCTSubvolume(size_t dims[3]);
+
   /**
    * @brief readHeaderMetaData Reads the number of voxels and voxel extents
    * from the NSI header file
@@ -175,6 +199,7 @@ protected:
 private:
   QFile m_InHeaderStream;
   QFile m_InStream;
+  SizeVec3Type m_VolumeDimensions;
 
   DEFINE_DATAARRAY_VARIABLE(float, Density)
 
@@ -36,6 +36,16 @@
 
 #include "LocalDislocationDensityCalculator.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -47,9 +57,9 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/EdgeGeom.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
-#include "SIMPLib/Math/GeometryMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "DREAM3DReview/DREAM3DReviewFilters/util/DislocationLengthTracer.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -62,6 +72,79 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+// Edges are traced in fixed size chunks, independent of the number of threads, and a batch of chunks is
+// traced before its contributions are summed
+const size_t k_EdgesPerChunk = 1024;
+const size_t k_ChunksPerBatch = 64;
+
+/**
+ * @brief The LengthContribution struct is the length an edge of the given slip system adds to a cell
+ */
+struct LengthContribution
+{
+  size_t point;
+  int32_t system;
+  float length;
+};
+
+/**
+ * @brief The AccumulateEdgeLengthsImpl class traces the edges of a range of chunks through the grid. Each chunk
+ * records the lengths it adds to the cells in edge order, so summing the chunks in order reproduces the serial
+ * sums for any number of threads.
+ */
+class AccumulateEdgeLengthsImpl
+{
+  const DislocationLengthTracer& m_Tracer;
+  const float* m_Nodes;
+  const MeshIndexType* m_Edges;
+  const std::vector<int32_t>& m_Systems;
+  size_t m_FirstEdge;
+  size_t m_EndEdge;
+  std::vector<std::vector<LengthContribution>>& m_Contributions;
+
+public:
+  AccumulateEdgeLengthsImpl(const DislocationLengthTracer& tracer, const float* nodes, const MeshIndexType* edges, const std::vector<int32_t>& systems, size_t firstEdge, size_t endEdge,
+                            std::vector<std::vector<LengthContribution>>& contributions)
+  : m_Tracer(tracer)
+  , m_Nodes(nodes)
+  , m_Edges(edges)
+  , m_Systems(systems)
+  , m_FirstEdge(firstEdge)
+  , m_EndEdge(endEdge)
+  , m_Contributions(contributions)
+  {
+  }
+  virtual ~AccumulateEdgeLengthsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      std::vector<LengthContribution>& contributions = m_Contributions[chunk];
+      contributions.clear();
+      size_t edgeStart = m_FirstEdge + chunk * k_EdgesPerChunk;
+      size_t edgeEnd = std::min(edgeStart + k_EdgesPerChunk, m_EndEdge);
+      for(size_t i = edgeStart; i < edgeEnd; i++)
+      {
+        const float* point1 = m_Nodes + 3 * m_Edges[2 * i + 0];
+        const float* point2 = m_Nodes + 3 * m_Edges[2 * i + 1];
+        int32_t system = m_Systems[i];
+        m_Tracer.trace(point1, point2, [&](size_t point, float length) { contributions.push_back({point, system, length}); });
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -321,10 +404,6 @@ void LocalDislocationDensityCalculator::execute()
   halfCellSize[0] = (m_CellSize[0] / 2.0f);
   halfCellSize[1] = (m_CellSize[1] / 2.0f);
   halfCellSize[2] = (m_CellSize[2] / 2.0f);
-  FloatVec3Type quarterCellSize;
-  quarterCellSize[0] = (m_CellSize[0] / 4.0f);
-  quarterCellSize[1] = (m_CellSize[1] / 4.0f);
-  quarterCellSize[2] = (m_CellSize[2] / 4.0f);
 
   vdc->getGeometryAs<ImageGeom>()->setOrigin(std::make_tuple(xMin, yMin, zMin));
   size_t dcDims[3];
@@ -345,94 +424,60 @@ void LocalDislocationDensityCalculator::execute()
   FloatArrayType::Pointer m_IndividualSystemLengthsPtr = FloatArrayType::CreateArray(12 * m_OutputArrayPtr.lock()->getNumberOfTuples(), "INDIVIDUAL_SYSTEM_LENGTHS_INTERNAL_USE_ONLY", true);
   float* m_IndividualSystemLengths = m_IndividualSystemLengthsPtr->getPointer(0);
 
-  float point1[3], point2[3], corner1[3], corner2[3];
-  size_t xCellMin, xCellMax;
-  size_t yCellMin, yCellMax;
-  size_t zCellMin, zCellMax;
-  float x1, y1, z1, x2, y2, z2;
-  size_t zStride, yStride, point;
-  float length;
-  int32_t system = 0;
+  // the slip system only depends on the edge, so it is determined once per edge
+  std::vector<int32_t> systems(numEdges);
   for(size_t i = 0; i < numEdges; i++)
   {
-    point1[0] = nodes[3 * edge[2 * i + 0] + 0];
-    point1[1] = nodes[3 * edge[2 * i + 0] + 1];
-    point1[2] = nodes[3 * edge[2 * i + 0] + 2];
-    point2[0] = nodes[3 * edge[2 * i + 1] + 0];
-    point2[1] = nodes[3 * edge[2 * i + 1] + 1];
-    point2[2] = nodes[3 * edge[2 * i + 1] + 2];
-    x1 = (point1[0] - xMin);
-    y1 = (point1[1] - yMin);
-    z1 = (point1[2] - zMin);
-    x2 = (point2[0] - xMin);
-    y2 = (point2[1] - yMin);
-    z2 = (point2[2] - zMin);
-    if(x1 > x2)
-    {
-      xCellMin = size_t(x2 / quarterCellSize[0]), xCellMax = size_t(x1 / quarterCellSize[0]);
-    }
-    else
-    {
-      xCellMin = size_t(x1 / quarterCellSize[0]), xCellMax = size_t(x2 / quarterCellSize[0]);
-    }
-    if(y1 > y2)
-    {
-      yCellMin = size_t(y2 / quarterCellSize[1]), yCellMax = size_t(y1 / quarterCellSize[1]);
-    }
-    else
+    systems[i] = determine_slip_system(i);
+  }
+
+  m_OutputArrayPtr.lock()->initializeWithZeros();
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  float origin[3] = {xMin, yMin, zMin};
+  DislocationLengthTracer tracer(origin, halfCellSize.data(), dcDims);
+
+  std::vector<std::vector<LengthContribution>> contributions(k_ChunksPerBatch);
+  for(size_t batchStart = 0; batchStart < numEdges; batchStart += k_EdgesPerChunk * k_ChunksPerBatch)
+  {
+    if(getCancel())
     {
-      yCellMin = size_t(y1 / quarterCellSize[1]), yCellMax = size_t(y2 / quarterCellSize[1]);
+      return;
     }
-    if(z1 > z2)
+
+    size_t batchEnd = std::min(batchStart + k_EdgesPerChunk * k_ChunksPerBatch, static_cast<size_t>(numEdges));
+    size_t numChunks = (batchEnd - batchStart + k_EdgesPerChunk - 1) / k_EdgesPerChunk;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      zCellMin = size_t(z2 / quarterCellSize[2]), zCellMax = size_t(z1 / quarterCellSize[2]);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), AccumulateEdgeLengthsImpl(tracer, nodes, edge, systems, batchStart, batchEnd, contributions), tbb::simple_partitioner());
     }
     else
+#endif
     {
-      zCellMin = size_t(z1 / quarterCellSize[2]), zCellMax = size_t(z2 / quarterCellSize[2]);
+      AccumulateEdgeLengthsImpl serial(tracer, nodes, edge, systems, batchStart, batchEnd, contributions);
+      serial.compute(0, numChunks);
     }
-    xCellMin = (xCellMin - 1) / 2;
-    yCellMin = (yCellMin - 1) / 2;
-    zCellMin = (zCellMin - 1) / 2;
-    xCellMax = ((xCellMax - 1) / 2) + 1;
-    yCellMax = ((yCellMax - 1) / 2) + 1;
-    zCellMax = ((zCellMax - 1) / 2) + 1;
-    if(xCellMax >= tDims[0])
-    {
-      xCellMax = tDims[0] - 1;
-    }
-    if(yCellMax >= tDims[1])
-    {
-      yCellMax = tDims[1] - 1;
-    }
-    if(zCellMax >= tDims[2])
-    {
-      zCellMax = tDims[2] - 1;
-    }
-    for(size_t j = zCellMin; j <= zCellMax; j++)
+
+    for(size_t c = 0; c < numChunks; c++)
     {
-      zStride = j * tDims[0] * tDims[1];
-      corner1[2] = (j * halfCellSize[2]) - halfCellSize[2] + quarterCellSize[2] + zMin;
-      corner2[2] = (j * halfCellSize[2]) + halfCellSize[2] + quarterCellSize[2] + zMin;
-      for(size_t k = yCellMin; k <= yCellMax; k++)
+      for(const LengthContribution& contribution : contributions[c])
       {
-        yStride = k * tDims[0];
-        corner1[1] = (k * halfCellSize[1]) - halfCellSize[1] + quarterCellSize[1] + yMin;
-        corner2[1] = (k * halfCellSize[1]) + halfCellSize[1] + quarterCellSize[1] + yMin;
-        for(size_t l = xCellMin; l <= xCellMax; l++)
+        m_OutputArray[contribution.point] += contribution.length;
+        // edges that match none of the 12 slip systems only count towards the total density
+        if(contribution.system < 12)
         {
-          corner1[0] = (l * halfCellSize[0]) - halfCellSize[0] + quarterCellSize[0] + xMin;
-          corner2[0] = (l * halfCellSize[0]) + halfCellSize[0] + quarterCellSize[0] + xMin;
-          length = GeometryMath::LengthOfRayInBox(point1, point2, corner1, corner2);
-          point = (zStride + yStride + l);
-          m_OutputArray[point] += length;
-          system = determine_slip_system(i);
-          m_IndividualSystemLengths[12 * point + system] += length;
+          m_IndividualSystemLengths[12 * contribution.point + contribution.system] += contribution.length;
         }
       }
     }
   }
 
+  size_t zStride, yStride, point;
   float cellVolume = m_CellSize[0] * m_CellSize[1] * m_CellSize[2];
   for(size_t j = 0; j < tDims[2]; j++)
   {
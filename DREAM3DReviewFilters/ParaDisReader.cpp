@@ -35,11 +35,18 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ParaDisReader.h"
 
-#include <QtCore/QtDebug>
-#include <fstream>
+#include <cstring>
+#include <limits>
 
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
@@ -50,6 +57,7 @@
 #include "SIMPLib/Geometry/EdgeGeom.h"
 #include "SIMPLib/Math/MatrixMath.h"
 
+#include "DREAM3DReview/DREAM3DReviewFilters/util/TextParsing.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -67,6 +75,281 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+/**
+ * @brief The ParaDisNodeIdMap class maps the (domain, index) tags of the ParaDiS nodes to vertex indices. It is an
+ * open addressing hash table whose capacity is fixed from the node count in the file header, so that it never
+ * needs to grow; the caller must not insert more than numNodes keys.
+ */
+class ParaDisNodeIdMap
+{
+public:
+  explicit ParaDisNodeIdMap(size_t numNodes)
+  {
+    size_t capacity = 16;
+    while(capacity < 2 * numNodes)
+    {
+      capacity <<= 1;
+    }
+    m_Mask = capacity - 1;
+    m_Keys.resize(capacity, 0);
+    m_Values.resize(capacity, -1);
+  }
+
+  static uint64_t Key(int64_t domain, int64_t index)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(domain)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(index));
+  }
+
+  /**
+   * @brief find Returns the vertex index of key, or -1 if key has not been inserted
+   */
+  int32_t find(uint64_t key) const
+  {
+    size_t slot = Hash(key) & m_Mask;
+    while(m_Values[slot] >= 0 && m_Keys[slot] != key)
+    {
+      slot = (slot + 1) & m_Mask;
+    }
+    return m_Values[slot];
+  }
+
+  /**
+   * @brief insert Assigns value to key if key has not been inserted yet
+   * @return The vertex index of key after the insertion
+   */
+  int32_t insert(uint64_t key, int32_t value)
+  {
+    size_t slot = Hash(key) & m_Mask;
+    while(m_Values[slot] >= 0)
+    {
+      if(m_Keys[slot] == key)
+      {
+        return m_Values[slot];
+      }
+      slot = (slot + 1) & m_Mask;
+    }
+    m_Keys[slot] = key;
+    m_Values[slot] = value;
+    return value;
+  }
+
+private:
+  size_t m_Mask = 0;
+  std::vector<uint64_t> m_Keys;
+  std::vector<int32_t> m_Values;
+
+  static size_t Hash(uint64_t key)
+  {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+  }
+};
+
+/**
+ * @brief The ParaDisNode struct records where the lines of a node start in the file, along with the
+ * vertex index of the node and the index of its first edge
+ */
+struct ParaDisNode
+{
+  const char* line = nullptr;
+  int32_t index = -1;
+  int32_t numArms = 0;
+  size_t edgeOffset = 0;
+  const char* errorLine = nullptr;
+};
+
+/**
+ * @brief NextLine Returns the start of the line following the one holding pos, or end if there is none
+ */
+const char* NextLine(const char* pos, const char* end)
+{
+  const char* lineEnd = TextParsing::FindLineEnd(pos, end);
+  return (lineEnd < end) ? lineEnd + 1 : end;
+}
+
+/**
+ * @brief ParseNodeTag Parses a "domain,index" node tag starting at pos and advances pos past it
+ * @return false if no node tag starts at pos
+ */
+bool ParseNodeTag(const char*& pos, const char* end, uint64_t& key)
+{
+  int64_t domain = 0;
+  int64_t index = 0;
+  const char* p = pos;
+  if(!TextParsing::ParseInteger(p, end, domain) || p >= end || *p != ',')
+  {
+    return false;
+  }
+  p++;
+  if(!TextParsing::ParseInteger(p, end, index))
+  {
+    return false;
+  }
+  key = ParaDisNodeIdMap::Key(domain, index);
+  pos = p;
+  return true;
+}
+
+/**
+ * @brief IsKeywordLine Returns whether the first token of the line starting at pos is keyword
+ */
+bool IsKeywordLine(const char* pos, const char* lineEnd, const char* keyword)
+{
+  pos = TextParsing::SkipWhitespace(pos, lineEnd);
+  if(!TextParsing::StartsWith(pos, lineEnd, keyword))
+  {
+    return false;
+  }
+  pos += std::strlen(keyword);
+  return pos == lineEnd || *pos == ' ' || *pos == '\t' || *pos == '\r';
+}
+
+/**
+ * @brief FindKeywordLine Returns the start of the first line at or after pos whose first token is keyword, or nullptr
+ */
+const char* FindKeywordLine(const char* pos, const char* end, const char* keyword)
+{
+  while(pos < end)
+  {
+    const char* lineEnd = TextParsing::FindLineEnd(pos, end);
+    if(IsKeywordLine(pos, lineEnd, keyword))
+    {
+      return pos;
+    }
+    pos = NextLine(pos, end);
+  }
+  return nullptr;
+}
+
+/**
+ * @brief The ParseParaDisNodesImpl class parses the node and arm lines of a range of nodes, whose lines and
+ * edge offsets were located by a first pass over the file. Each node writes its vertex, its arm count and
+ * constraint, and the edges to its higher indexed neighbors, so that nodes can be parsed in any order.
+ */
+class ParseParaDisNodesImpl
+{
+public:
+  ParseParaDisNodesImpl(AbstractFilter* filter, const char* end, std::vector<ParaDisNode>& nodes, const ParaDisNodeIdMap& nodeIds, int32_t fileVersion, float burgersVec, float* vertex,
+                        int32_t* numberOfArms, int32_t* nodeConstraints, MeshIndexType* edge, float* burgersVectors, float* slipPlaneNormals)
+  : m_Filter(filter)
+  , m_End(end)
+  , m_Nodes(nodes)
+  , m_NodeIds(nodeIds)
+  , m_FileVersion(fileVersion)
+  , m_BurgersVec(burgersVec)
+  , m_Vertex(vertex)
+  , m_NumberOfArms(numberOfArms)
+  , m_NodeConstraints(nodeConstraints)
+  , m_Edge(edge)
+  , m_BurgersVectors(burgersVectors)
+  , m_SlipPlaneNormals(slipPlaneNormals)
+  {
+  }
+  virtual ~ParseParaDisNodesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t n = start; n < end; n++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      parseNode(m_Nodes[n]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  const char* m_End;
+  std::vector<ParaDisNode>& m_Nodes;
+  const ParaDisNodeIdMap& m_NodeIds;
+  int32_t m_FileVersion;
+  float m_BurgersVec;
+  float* m_Vertex;
+  int32_t* m_NumberOfArms;
+  int32_t* m_NodeConstraints;
+  MeshIndexType* m_Edge;
+  float* m_BurgersVectors;
+  float* m_SlipPlaneNormals;
+
+  void parseNode(ParaDisNode& node) const
+  {
+    const char* pos = node.line;
+    uint64_t key = 0;
+    float coords[3] = {0.0f, 0.0f, 0.0f};
+    int64_t constraint = 0;
+    ParseNodeTag(pos, m_End, key);
+    bool ok = TextParsing::ParseFloat(pos, m_End, coords[0]) && TextParsing::ParseFloat(pos, m_End, coords[1]) && TextParsing::ParseFloat(pos, m_End, coords[2]);
+    ok = ok && TextParsing::SkipToken(pos, m_End) && TextParsing::ParseInteger(pos, m_End, constraint);
+    if(!ok)
+    {
+      node.errorLine = node.line;
+      return;
+    }
+    for(size_t i = 0; i < 3; i++)
+    {
+      m_Vertex[3 * node.index + i] = coords[i] * m_BurgersVec;
+    }
+    m_NumberOfArms[node.index] = node.numArms;
+    m_NodeConstraints[node.index] = static_cast<int32_t>(constraint);
+
+    const char* line = NextLine(node.line, m_End);
+    if(m_FileVersion >= 5)
+    {
+      line = NextLine(line, m_End);
+    }
+    size_t edgeIndex = node.edgeOffset;
+    for(int32_t k = 0; k < node.numArms; k++)
+    {
+      const char* normalLine = NextLine(line, m_End);
+      pos = line;
+      ParseNodeTag(pos, m_End, key);
+      int32_t neighborNode = m_NodeIds.find(key);
+      if(neighborNode > node.index)
+      {
+        float burgVec[3] = {0.0f, 0.0f, 0.0f};
+        float spNorm[3] = {0.0f, 0.0f, 0.0f};
+        if(!TextParsing::ParseFloat(pos, m_End, burgVec[0]) || !TextParsing::ParseFloat(pos, m_End, burgVec[1]) || !TextParsing::ParseFloat(pos, m_End, burgVec[2]))
+        {
+          node.errorLine = line;
+          return;
+        }
+        pos = normalLine;
+        if(!TextParsing::ParseFloat(pos, m_End, spNorm[0]) || !TextParsing::ParseFloat(pos, m_End, spNorm[1]) || !TextParsing::ParseFloat(pos, m_End, spNorm[2]))
+        {
+          node.errorLine = normalLine;
+          return;
+        }
+        MatrixMath::Normalize3x1(spNorm);
+        m_Edge[2 * edgeIndex + 0] = static_cast<MeshIndexType>(node.index);
+        m_Edge[2 * edgeIndex + 1] = static_cast<MeshIndexType>(neighborNode);
+        for(size_t i = 0; i < 3; i++)
+        {
+          m_BurgersVectors[3 * edgeIndex + i] = burgVec[i];
+          m_SlipPlaneNormals[3 * edgeIndex + i] = spNorm[i];
+        }
+        edgeIndex++;
+      }
+      line = NextLine(normalLine, m_End);
+    }
+  }
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -174,6 +457,10 @@ void ParaDisReader::initialize()
   {
     m_InStream.close();
   }
+  m_FileContents.clear();
+  m_FileData = nullptr;
+  m_FileEnd = nullptr;
+  m_Position = nullptr;
   m_NumVerts = -1;
   m_NumEdges = -1;
   m_FileVersion = 0;
@@ -315,25 +602,40 @@ void ParaDisReader::execute()
   }
 
   m_InStream.setFileName(getInputFile());
-  if(!m_InStream.open(QIODevice::ReadOnly | QIODevice::Text))
+  if(!m_InStream.open(QIODevice::ReadOnly))
   {
     QString ss = QObject::tr("ParaDisReader Input file could not be opened: %1").arg(getInputFile());
     setErrorCondition(-100, ss);
     return;
   }
 
+  // the file is parsed in place, straight from a memory map when the platform allows it
+  qint64 fileSize = m_InStream.size();
+  uchar* mapped = m_InStream.map(0, fileSize);
+  m_FileData = reinterpret_cast<const char*>(mapped);
+  if(nullptr == mapped)
+  {
+    m_FileContents = m_InStream.readAll();
+    m_FileData = m_FileContents.constData();
+  }
+  m_FileEnd = m_FileData + fileSize;
+  m_Position = m_FileData;
+
   err = readHeader();
-  if(err < 0)
+  if(err >= 0)
   {
-    m_InStream.close();
-    return;
+    err = readFile();
   }
-  err = readFile();
-  m_InStream.close();
-  if(err < 0)
+
+  if(nullptr != mapped)
   {
-    return;
+    m_InStream.unmap(mapped);
   }
+  m_FileContents.clear();
+  m_FileData = nullptr;
+  m_FileEnd = nullptr;
+  m_Position = nullptr;
+  m_InStream.close();
 }
 
 //-----------------------------------------------------------------------------
@@ -350,95 +652,66 @@ int ParaDisReader::readHeader()
 
   int error = 0;
 
-  QByteArray buf;
-  QList<QByteArray> tokens; /* vector to store the split data */
-
-  bool ok = false;
-  // Process the header information
-  // bool done = false;
   // read Version line
-  buf = m_InStream.readLine();
-  buf = buf.trimmed();
-  buf = buf.simplified();
-  tokens = buf.split(' ');
-  m_FileVersion = tokens[2].toInt(&ok, 10);
-
-  int keepgoing = 1;
-  // read until get to minCoordinates line
-  while(keepgoing == 1)
-  {
-    buf = m_InStream.readLine();
-    buf = buf.trimmed();
-    buf = buf.simplified();
-    tokens = buf.split(' ');
-    QString word(tokens.at(0));
-    if(word.compare("minCoordinates") == 0)
-    {
-      for(int32_t i = 0; i < 3; i++)
-      {
-        buf = m_InStream.readLine();
-        buf = buf.trimmed();
-        buf = buf.simplified();
-        tokens = buf.split(' ');
-        m_DomainBounds[i] = tokens[0].toFloat(&ok) * burgersVec;
-      }
-      keepgoing = 0;
-    }
+  const char* pos = m_Position;
+  int64_t value = 0;
+  if(!TextParsing::SkipToken(pos, m_FileEnd) || !TextParsing::SkipToken(pos, m_FileEnd) || !TextParsing::ParseInteger(pos, m_FileEnd, value))
+  {
+    ss = QObject::tr("Unable to parse the file version from the first line of the ParaDis file");
+    setErrorCondition(-101, ss);
+    return -101;
   }
-  keepgoing = 1;
-  // read until get to maxCoordinates line
-  while(keepgoing == 1)
+  m_FileVersion = static_cast<int>(value);
+  m_Position = NextLine(m_Position, m_FileEnd);
+
+  // read until get to minCoordinates and maxCoordinates lines
+  const char* keywords[2] = {"minCoordinates", "maxCoordinates"};
+  for(int32_t b = 0; b < 2; b++)
   {
-    buf = m_InStream.readLine();
-    buf = buf.trimmed();
-    buf = buf.simplified();
-    tokens = buf.split(' ');
-    QString word(tokens.at(0));
-    if(word.compare("maxCoordinates") == 0)
+    const char* line = FindKeywordLine(m_Position, m_FileEnd, keywords[b]);
+    if(nullptr == line)
+    {
+      ss = QObject::tr("Unable to find %1 in the ParaDis file header").arg(keywords[b]);
+      setErrorCondition(-102, ss);
+      return -102;
+    }
+    for(int32_t i = 0; i < 3; i++)
     {
-      for(int32_t i = 3; i < 6; i++)
+      line = NextLine(line, m_FileEnd);
+      pos = line;
+      float coord = 0.0f;
+      if(!TextParsing::ParseFloat(pos, m_FileEnd, coord))
       {
-        buf = m_InStream.readLine();
-        buf = buf.trimmed();
-        buf = buf.simplified();
-        tokens = buf.split(' ');
-        m_DomainBounds[i] = tokens[0].toFloat(&ok) * burgersVec;
+        ss = QObject::tr("Unable to parse %1 from ParaDis file line %2").arg(keywords[b]).arg(TextParsing::LineNumber(m_FileData, line));
+        setErrorCondition(-102, ss);
+        return -102;
       }
-      keepgoing = 0;
+      m_DomainBounds[3 * b + i] = coord * burgersVec;
     }
+    m_Position = NextLine(line, m_FileEnd);
   }
-  keepgoing = 1;
+
   // read until get to nodeCount line
-  while(keepgoing == 1)
-  {
-    buf = m_InStream.readLine();
-    buf = buf.trimmed();
-    buf = buf.simplified();
-    tokens = buf.split(' ');
-    QString word(tokens.at(0));
-    if(word.compare("nodeCount") == 0)
-    {
-      m_NumVerts = tokens[2].toInt(&ok, 10);
-      keepgoing = 0;
-    }
+  const char* line = FindKeywordLine(m_Position, m_FileEnd, "nodeCount");
+  pos = line;
+  if(nullptr == line || !TextParsing::SkipToken(pos, m_FileEnd) || !TextParsing::SkipToken(pos, m_FileEnd) || !TextParsing::ParseInteger(pos, m_FileEnd, value) || value < 0 ||
+     value > std::numeric_limits<int32_t>::max())
+  {
+    ss = QObject::tr("Unable to parse nodeCount from the ParaDis file header");
+    setErrorCondition(-103, ss);
+    return -103;
   }
-  keepgoing = 1;
-  // read until get to nodalData line
-  while(keepgoing == 1)
+  m_NumVerts = static_cast<int>(value);
+
+  // read until get to nodalData line, which is followed by two comment lines
+  line = FindKeywordLine(NextLine(line, m_FileEnd), m_FileEnd, "nodalData");
+  if(nullptr == line)
   {
-    buf = m_InStream.readLine();
-    buf = buf.trimmed();
-    buf = buf.simplified();
-    tokens = buf.split(' ');
-    QString word(tokens.at(0));
-    if(word.compare("nodalData") == 0)
-    {
-      // read nodal Data lines
-      buf = m_InStream.readLine();
-      buf = m_InStream.readLine();
-      keepgoing = 0;
-    }
+    ss = QObject::tr("Unable to find nodalData in the ParaDis file");
+    setErrorCondition(-104, ss);
+    return -104;
   }
+  m_Position = NextLine(NextLine(NextLine(line, m_FileEnd), m_FileEnd), m_FileEnd);
 
   EdgeGeom::Pointer edgeGeom = m->getGeometryAs<EdgeGeom>();
   edgeGeom->resizeVertexList(m_NumVerts);
@@ -458,150 +731,148 @@ int ParaDisReader::readFile()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getEdgeDataContainerName());
   AttributeMatrix::Pointer edgeAttrMat = m->getAttributeMatrix(getEdgeAttributeMatrixName());
 
-  QByteArray buf;
-  QList<QByteArray> tokens;    /* vector to store the split data */
-  QList<QByteArray> subTokens; /* vector to store the split data */
-
   EdgeGeom::Pointer edgeGeom = m->getGeometryAs<EdgeGeom>();
-  edgeGeom->resizeVertexList(m_NumVerts);
-
   float* vertex = edgeGeom->getVertexPointer(0);
-  m_NumVerts = edgeGeom->getNumberOfVertices();
-
-  bool ok = false;
-
-  int nodeNum = 0;
-  int neighborNode = 0;
-  m_NumEdges = 0;
-  int nodeCounter = 0;
-  uint64_t* ptr64;
-
-  QMap<int64_t, int32_t> vertNumbers;
-  struct
-  {
-    int32_t n1;
-    int32_t n2;
-  } uniqueNodeId;
-
-  QVector<int> firstNodes;
-  QVector<int> secondNodes;
-  QVector<float> burgerXs;
-  QVector<float> burgerYs;
-  QVector<float> burgerZs;
-  float burgVec[3];
-  QVector<float> spnXs;
-  QVector<float> spnYs;
-  QVector<float> spnZs;
-  float spNorm[3];
 
   // convert user input Burgers Vector to microns from angstroms
   float burgersVec = m_BurgersVector / 10000.0f;
 
+  // first pass: assign vertex indices to the node tags in order of first appearance, whether as a node
+  // or as a neighbor, and count the edges, which run from each node to its higher indexed neighbors
+  notifyStatusMessage("Indexing nodes");
+  ParaDisNodeIdMap nodeIds(static_cast<size_t>(m_NumVerts));
+  std::vector<ParaDisNode> nodes(static_cast<size_t>(m_NumVerts));
+  int32_t nodeCounter = 0;
+  size_t numEdges = 0;
+  const char* line = m_Position;
   for(int j = 0; j < m_NumVerts; j++)
   {
-    buf = m_InStream.readLine();
-    buf = buf.trimmed();
-    buf = buf.simplified();
-    tokens = buf.split(' ');
-    subTokens = tokens[0].split(',');
-    uniqueNodeId.n1 = subTokens[0].toInt(&ok, 10);
-    uniqueNodeId.n2 = subTokens[1].toInt(&ok, 10);
-    ptr64 = reinterpret_cast<uint64_t*>(&uniqueNodeId);
-    nodeNum = vertNumbers.value(*ptr64, -1);
-    if(nodeNum == -1)
+    if(getCancel())
     {
-      nodeNum = nodeCounter;
-      vertex[3 * nodeNum + 0] = tokens[1].toFloat(&ok) * burgersVec;
-      vertex[3 * nodeNum + 1] = tokens[2].toFloat(&ok) * burgersVec;
-      vertex[3 * nodeNum + 2] = tokens[3].toFloat(&ok) * burgersVec;
-      m_NumberOfArms[nodeNum] = tokens[4].toInt(&ok, 10);
-      m_NodeConstraints[nodeNum] = tokens[5].toInt(&ok, 10);
-      vertNumbers.insert(*ptr64, nodeNum);
-      nodeCounter++;
+      return 0;
     }
-    else
+
+    const char* errorLine = nullptr;
+    bool tooManyNodes = false;
+    ParaDisNode& node = nodes[j];
+    node.line = line;
+    node.edgeOffset = numEdges;
+
+    const char* pos = line;
+    uint64_t key = 0;
+    int64_t numArms = 0;
+    bool ok = (line < m_FileEnd) && ParseNodeTag(pos, m_FileEnd, key);
+    ok = ok && TextParsing::SkipToken(pos, m_FileEnd) && TextParsing::SkipToken(pos, m_FileEnd) && TextParsing::SkipToken(pos, m_FileEnd);
+    ok = ok && TextParsing::ParseInteger(pos, m_FileEnd, numArms) && numArms >= 0 && numArms <= std::numeric_limits<int32_t>::max();
+    if(ok)
     {
-      vertex[3 * nodeNum + 0] = tokens[1].toFloat(&ok) * burgersVec;
-      vertex[3 * nodeNum + 1] = tokens[2].toFloat(&ok) * burgersVec;
-      vertex[3 * nodeNum + 2] = tokens[3].toFloat(&ok) * burgersVec;
-      m_NumberOfArms[nodeNum] = tokens[4].toInt(&ok, 10);
-      m_NodeConstraints[nodeNum] = tokens[5].toInt(&ok, 10);
+      node.numArms = static_cast<int32_t>(numArms);
+      node.index = nodeIds.find(key);
+      if(node.index < 0)
+      {
+        tooManyNodes = (nodeCounter >= m_NumVerts);
+        node.index = tooManyNodes ? -1 : nodeIds.insert(key, nodeCounter++);
+      }
+      ok = !tooManyNodes;
     }
+    errorLine = ok ? nullptr : line;
+
+    line = NextLine(line, m_FileEnd);
     if(m_FileVersion >= 5)
     {
-      buf = m_InStream.readLine();
+      line = NextLine(line, m_FileEnd);
     }
-    for(int k = 0; k < m_NumberOfArms[nodeNum]; k++)
+    for(int32_t k = 0; k < node.numArms && ok; k++)
     {
-      buf = m_InStream.readLine();
-      buf = buf.trimmed();
-      buf = buf.simplified();
-      tokens = buf.split(' ');
-      subTokens = tokens[0].split(',');
-      uniqueNodeId.n1 = subTokens[0].toInt(&ok, 10);
-      uniqueNodeId.n2 = subTokens[1].toInt(&ok, 10);
-      ptr64 = reinterpret_cast<uint64_t*>(&uniqueNodeId);
-      neighborNode = vertNumbers.value(*ptr64, -1);
-      if(neighborNode == -1)
+      pos = line;
+      ok = (line < m_FileEnd) && ParseNodeTag(pos, m_FileEnd, key);
+      int32_t neighborNode = ok ? nodeIds.find(key) : -1;
+      if(ok && neighborNode < 0)
       {
-        neighborNode = nodeCounter;
-        vertNumbers.insert(*ptr64, neighborNode);
-        nodeCounter++;
+        tooManyNodes = (nodeCounter >= m_NumVerts);
+        ok = !tooManyNodes;
+        neighborNode = ok ? nodeIds.insert(key, nodeCounter++) : -1;
       }
-      if(neighborNode > nodeNum)
+      if(!ok)
       {
-        m_NumEdges++;
-        firstNodes.push_back(nodeNum);
-        secondNodes.push_back(neighborNode);
-        burgVec[0] = tokens[1].toFloat(&ok);
-        burgVec[1] = tokens[2].toFloat(&ok);
-        burgVec[2] = tokens[3].toFloat(&ok);
-        // burgVec[0] = tokens[1].toFloat(&ok) * burgersVec;
-        // burgVec[1] = tokens[2].toFloat(&ok) * burgersVec;
-        // burgVec[2] = tokens[3].toFloat(&ok) * burgersVec;
-        burgerXs.push_back(burgVec[0]);
-        burgerYs.push_back(burgVec[1]);
-        burgerZs.push_back(burgVec[2]);
+        errorLine = line;
+        break;
       }
-      buf = m_InStream.readLine();
-      buf = buf.trimmed();
-      buf = buf.simplified();
-      tokens = buf.split(' ');
-      if(neighborNode > nodeNum)
+      if(neighborNode > node.index)
       {
-        spNorm[0] = tokens[0].toFloat(&ok);
-        spNorm[1] = tokens[1].toFloat(&ok);
-        spNorm[2] = tokens[2].toFloat(&ok);
-        MatrixMath::Normalize3x1(spNorm);
-        spnXs.push_back(spNorm[0]);
-        spnYs.push_back(spNorm[1]);
-        spnZs.push_back(spNorm[2]);
+        numEdges++;
+      }
+      line = NextLine(NextLine(line, m_FileEnd), m_FileEnd);
+    }
+
+    if(nullptr != errorLine)
+    {
+      QString ss;
+      if(errorLine >= m_FileEnd)
+      {
+        ss = QObject::tr("The ParaDis file ended after %1 of %2 nodes").arg(j).arg(m_NumVerts);
       }
+      else if(tooManyNodes)
+      {
+        ss = QObject::tr("The ParaDis file references more than the %1 nodes given by nodeCount at line %2").arg(m_NumVerts).arg(TextParsing::LineNumber(m_FileData, errorLine));
+      }
+      else
+      {
+        const char* lineEnd = TextParsing::FindLineEnd(errorLine, m_FileEnd);
+        ss = QObject::tr("Unable to parse ParaDis file line %1: %2")
+                 .arg(TextParsing::LineNumber(m_FileData, errorLine))
+                 .arg(QString::fromLatin1(errorLine, static_cast<int32_t>(lineEnd - errorLine)).simplified());
+      }
+      setErrorCondition(-105, ss);
+      return -105;
     }
   }
+  m_NumEdges = static_cast<int>(numEdges);
 
   edgeGeom->resizeEdgeList(m_NumEdges);
   MeshIndexType* edge = edgeGeom->getEdgePointer(0);
 
-  // Resize the edge attribute matrix to the number of vertices
+  // Resize the edge attribute matrix to the number of edges
   std::vector<size_t> tDims(1, m_NumEdges);
   edgeAttrMat->resizeAttributeArrays(tDims);
   updateEdgeInstancePointers();
 
-  for(int i = 0; i < m_NumEdges; i++)
+  // second pass: parse the values of every node straight into the pre-sized arrays
+  notifyStatusMessage("Reading nodes");
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  ParseParaDisNodesImpl impl(this, m_FileEnd, nodes, nodeIds, m_FileVersion, burgersVec, vertex, m_NumberOfArms, m_NodeConstraints, edge, m_BurgersVectors, m_SlipPlaneNormals);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nodes.size()), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
   {
-    edge[2 * i + 0] = firstNodes[i];
-    edge[2 * i + 1] = secondNodes[i];
-    m_BurgersVectors[3 * i + 0] = burgerXs[i];
-    m_BurgersVectors[3 * i + 1] = burgerYs[i];
-    m_BurgersVectors[3 * i + 2] = burgerZs[i];
-    m_SlipPlaneNormals[3 * i + 0] = spnXs[i];
-    m_SlipPlaneNormals[3 * i + 1] = spnYs[i];
-    m_SlipPlaneNormals[3 * i + 2] = spnZs[i];
+    impl.compute(0, nodes.size());
   }
 
-  tokens.clear();
-  m_InStream.close();
+  if(getCancel())
+  {
+    return 0;
+  }
+
+  for(const auto& node : nodes)
+  {
+    if(nullptr != node.errorLine)
+    {
+      const char* lineEnd = TextParsing::FindLineEnd(node.errorLine, m_FileEnd);
+      QString ss = QObject::tr("Unable to parse ParaDis file line %1: %2")
+                       .arg(TextParsing::LineNumber(m_FileData, node.errorLine))
+                       .arg(QString::fromLatin1(node.errorLine, static_cast<int32_t>(lineEnd - node.errorLine)).simplified());
+      setErrorCondition(-105, ss);
+      return -105;
+    }
+  }
 
   return 0;
 }
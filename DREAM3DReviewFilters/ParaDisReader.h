@@ -175,14 +175,16 @@ protected:
   ParaDisReader();
 
   /**
-   * @brief readHeader
-   * @return
+   * @brief readHeader Reads the file version, domain bounds and node count from the header of the
+   * input file, which is held in memory from m_Position on
+   * @return Integer error code
    */
   virtual int readHeader();
 
   /**
-   * @brief readFile
-   * @return
+   * @brief readFile Reads the nodal data in two passes: the first assigns vertex indices to the node tags
+   * and counts the edges, and the second parses the node and arm values into the pre-sized arrays
+   * @return Integer error code
    */
   virtual int readFile();
 
@@ -213,6 +215,10 @@ private:
   DEFINE_DATAARRAY_VARIABLE(float, SlipPlaneNormals)
   DEFINE_DATAARRAY_VARIABLE(float, DomainBounds)
   QFile m_InStream;
+  QByteArray m_FileContents;
+  const char* m_FileData = nullptr;
+  const char* m_FileEnd = nullptr;
+  const char* m_Position = nullptr;
 
   int m_NumVerts;
   int m_NumEdges;
@@ -35,16 +35,27 @@
 
 #include "PottsModel.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <chrono>
-#include <deque>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <random>
 #include <utility>
-#include <utility>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
 
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
@@ -63,12 +74,50 @@ using Neighborhood = std::vector<std::array<int8_t, 3>>;
 
 const double BOLTZMANN = 1.38064852e-23;
 
+// the 26 connected 3D neighborhood is the largest one used
+const size_t k_MaxNeighbors = 26;
+
+// a site is on the low face, in the interior or on the high face along each axis
+const size_t k_NumBoundaryClasses = 27;
+
+// marks lattice sites that are not on the boundary list of the rejection free solver
+const size_t k_Inactive = std::numeric_limits<size_t>::max();
+
+// maps the upper 53 bits of a random number onto [0, 1)
+const double k_UnitScale = 1.0 / 9007199254740992.0;
+
 enum class Dimension : uint8_t
 {
   Two,
   Three
 };
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t SplitMix64(uint64_t x)
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+// -----------------------------------------------------------------------------
+// Counter based random numbers: the value only depends on the stream and the counter, so a
+// lattice site draws the same numbers no matter which thread visits it
+// -----------------------------------------------------------------------------
+uint64_t CounterRandom(uint64_t stream, uint64_t counter)
+{
+  return SplitMix64(stream ^ SplitMix64(counter));
+}
+
+/**
+ * @brief The SpinLattice class performs Metropolis sweeps over the lattice sites. The sites are split
+ * into sublattices (colors) whose sites are not neighbors of each other, so all sites of one color can
+ * attempt their flips at the same time. The neighbor offsets of every boundary class of sites are
+ * computed up front, which resolves the periodic boundaries once instead of for every flip attempt.
+ */
 class SpinLattice
 {
 public:
@@ -84,123 +133,189 @@ public:
 
   virtual ~SpinLattice()= default;
 
-  void attempt_flip(size_t index)
+  /**
+   * @brief attempt_flips Attempts to flip every site of one row of a color
+   * @param color Color of the sites
+   * @param row Row among the rows that hold sites of the color
+   * @param iteration Monte Carlo step, which selects the random number stream
+   * @return Number of accepted flips
+   */
+  size_t attempt_flips(size_t color, size_t row, uint64_t iteration) const
   {
-    int32_t spin = fIds_[index];
-    std::deque<size_t> neighbors = valid_neighbor_query(index);
-
-    auto same = std::count_if(std::begin(neighbors), std::end(neighbors), [&](size_t& idx) { return spin == fIds_[idx]; });
-
-    if(same == neighbors.size())
+    if(mask_ != nullptr)
     {
-      return;
+      return attempt_row_flips<true>(color, row, iteration);
     }
+    return attempt_row_flips<false>(color, row, iteration);
+  }
 
-    size_t rand_neighbor = random_neighbor(neighbors);
-    int32_t candidate = fIds_[rand_neighbor];
-
-    if(candidate == 0)
+  /**
+   * @brief color_order Returns the order in which the colors are swept during a Monte Carlo step
+   */
+  std::vector<size_t> color_order(uint64_t iteration) const
+  {
+    std::vector<size_t> order(num_colors());
+    std::iota(order.begin(), order.end(), 0);
+    uint64_t stream = SplitMix64(seed_ ^ SplitMix64(iteration));
+    for(size_t i = order.size(); i > 1; i--)
     {
-      return;
+      size_t j = static_cast<size_t>(CounterRandom(stream, i) % i);
+      std::swap(order[i - 1], order[j]);
     }
+    return order;
+  }
 
-    if(spin != candidate)
+  /**
+   * @brief valid_neighbors Writes the indices of the valid neighbors of a site into neighbors
+   * @return Number of valid neighbors
+   */
+  size_t valid_neighbors(size_t index, std::array<size_t, k_MaxNeighbors>& neighbors) const
+  {
+    size_t x = index % dims_[0];
+    size_t y = (index / dims_[0]) % dims_[1];
+    size_t z = index / (dims_[0] * dims_[1]);
+    size_t siteClass = boundary_class(x, 0) + 3 * boundary_class(y, 1) + 9 * boundary_class(z, 2);
+    const int64_t* offsets = offsets_.data() + siteClass * k_MaxNeighbors;
+    size_t numNeighbors = 0;
+    for(size_t n = 0; n < num_offsets_[siteClass]; n++)
     {
-      double dE = 0.0;
-      for(auto&& neighbor : neighbors)
-      {
-        int32_t n = fIds_[neighbor];
-        double a = (n != candidate) ? 1.0 : 0.0;
-        double b = (n != spin) ? 1.0 : 0.0;
-        dE += (a - b);
-      }
-      dE *= 0.5;
-      if(dE <= 0.0)
-      {
-        fIds_[index] = candidate;
-        total_flips_++;
-      }
-      else
+      size_t neighbor = static_cast<size_t>(static_cast<int64_t>(index) + offsets[n]);
+      if(mask_ != nullptr && !mask_[neighbor])
       {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        double r = dist(gen_);
-        if(r < std::exp(-dE / kT_))
-        {
-          fIds_[index] = candidate;
-          total_flips_++;
-        }
+        continue;
       }
+      neighbors[numNeighbors++] = neighbor;
     }
+    return numNeighbors;
   }
 
-  size_t total_flips()
+  /**
+   * @brief acceptance Returns the probability that a flip is accepted, given the number of neighbors that
+   * share the current spin and the number of neighbors that share the candidate spin
+   */
+  double acceptance(size_t same, size_t sameCandidate) const
   {
-    return total_flips_;
+    return (same <= sameCandidate) ? 1.0 : boltzmann_[same - sameCandidate];
   }
 
-  Dimension dimension()
+  /**
+   * @brief is_flippable Returns whether a site takes part in the simulation
+   */
+  bool is_flippable(size_t index) const
   {
-    return dim_type_;
+    return fIds_[index] != 0 && (mask_ == nullptr || mask_[index]);
   }
 
-private:
-  size_t random_neighbor(std::deque<size_t>& neighbors)
+  size_t num_sites() const
   {
-    std::uniform_int_distribution<size_t> dist(0, neighbors.size() - 1);
-    return neighbors[dist(gen_)];
+    return dims_[0] * dims_[1] * dims_[2];
   }
 
-  std::deque<size_t> valid_neighbor_query(size_t index)
+  uint64_t seed() const
   {
-    std::deque<size_t> neighbors;
+    return seed_;
+  }
 
-    size_t x = index % dims_[0];
-    size_t y = (index / dims_[0]) % dims_[1];
-    size_t z = index / (dims_[0] * dims_[1]);
+  size_t num_colors() const
+  {
+    return axis_coords_[0].size() * axis_coords_[1].size() * axis_coords_[2].size();
+  }
+
+  size_t num_rows(size_t color) const
+  {
+    return axis_coords_[1][axis_color(color, 1)].size() * axis_coords_[2][axis_color(color, 2)].size();
+  }
 
-    for(auto&& neighbor : neighborhood_)
+  Dimension dimension()
+  {
+    return dim_type_;
+  }
+
+private:
+  template <bool UseMask> size_t attempt_row_flips(size_t color, size_t row, uint64_t iteration) const
+  {
+    const std::vector<size_t>& columns = axis_coords_[0][axis_color(color, 0)];
+    const std::vector<size_t>& ys = axis_coords_[1][axis_color(color, 1)];
+    const std::vector<size_t>& zs = axis_coords_[2][axis_color(color, 2)];
+    size_t y = ys[row % ys.size()];
+    size_t z = zs[row / ys.size()];
+    size_t rowOffset = (z * dims_[1] + y) * dims_[0];
+    size_t rowClass = 3 * boundary_class(y, 1) + 9 * boundary_class(z, 2);
+    uint64_t stream = SplitMix64(seed_ ^ SplitMix64(iteration));
+
+    std::array<int32_t, k_MaxNeighbors> spins;
+    size_t flips = 0;
+    for(size_t x : columns)
     {
-      if(periodic_)
+      size_t index = rowOffset + x;
+      int32_t spin = fIds_[index];
+      if(spin == 0 || (UseMask && !mask_[index]))
       {
-        size_t modx = apply_modular_operation(x, neighbor[0], dims_[0]);
-        size_t mody = apply_modular_operation(y, neighbor[1], dims_[1]);
-        size_t modz = apply_modular_operation(z, neighbor[2], dims_[2]);
-        size_t neigh = neighbor_index(modx, mody, modz);
-        if(mask_ != nullptr)
-        {
-          if(mask_[neigh])
-          {
-            neighbors.push_back(neigh);
-          }
-        }
-        else
-        {
-          neighbors.push_back(neigh);
-        }
+        continue;
       }
-      else
+
+      size_t siteClass = rowClass + boundary_class(x, 0);
+      const int64_t* offsets = offsets_.data() + siteClass * k_MaxNeighbors;
+      size_t numNeighbors = 0;
+      size_t same = 0;
+      for(size_t n = 0; n < num_offsets_[siteClass]; n++)
       {
-        int64_t modx = static_cast<int64_t>(x) + neighbor[0];
-        int64_t mody = static_cast<int64_t>(y) + neighbor[1];
-        int64_t modz = static_cast<int64_t>(z) + neighbor[2];
-        if((modx >= 0 && modx < static_cast<int64_t>(dims_[0])) && (mody >= 0 && mody < static_cast<int64_t>(dims_[1])) && (modz >= 0 && modz < static_cast<int64_t>(dims_[2])))
+        size_t neighbor = static_cast<size_t>(static_cast<int64_t>(index) + offsets[n]);
+        if(UseMask && !mask_[neighbor])
         {
-          size_t neigh = neighbor_index(modx, mody, modz);
-          if(mask_ != nullptr)
-          {
-            if(mask_[neigh])
-            {
-              neighbors.push_back(neigh);
-            }
-          }
-          else
-          {
-            neighbors.push_back(neigh);
-          }
+          continue;
         }
+        spins[numNeighbors] = fIds_[neighbor];
+        same += (spins[numNeighbors] == spin) ? 1 : 0;
+        numNeighbors++;
+      }
+
+      if(same == numNeighbors)
+      {
+        continue;
+      }
+
+      uint64_t random = CounterRandom(stream, 2 * index);
+      int32_t candidate = spins[((random & 0xFFFFFFFFULL) * numNeighbors) >> 32];
+      if(candidate == 0 || candidate == spin)
+      {
+        continue;
+      }
+
+      // dE = 0.5 * (neighbors sharing the current spin - neighbors sharing the candidate spin)
+      size_t sameCandidate = static_cast<size_t>(std::count(spins.begin(), spins.begin() + numNeighbors, candidate));
+      bool accept = (same <= sameCandidate);
+      if(!accept)
+      {
+        double r = static_cast<double>(CounterRandom(stream, 2 * index + 1) >> 11) * k_UnitScale;
+        accept = (r < boltzmann_[same - sameCandidate]);
+      }
+      if(accept)
+      {
+        fIds_[index] = candidate;
+        flips++;
       }
     }
-    return neighbors;
+    return flips;
+  }
+
+  size_t axis_color(size_t color, size_t axis) const
+  {
+    size_t stride = 1;
+    for(size_t i = 0; i < axis; i++)
+    {
+      stride *= axis_coords_[i].size();
+    }
+    return (color / stride) % axis_coords_[axis].size();
+  }
+
+  size_t boundary_class(size_t coord, size_t axis) const
+  {
+    if(coord == 0)
+    {
+      return 0;
+    }
+    return (coord == dims_[axis] - 1) ? 2 : 1;
   }
 
   size_t modular_subtraction(size_t a, size_t b, size_t m)
@@ -273,10 +388,14 @@ private:
   {
     determine_dimensionality();
     generate_neighborhood();
+    generate_colors();
+    generate_offsets();
     kT_ = BOLTZMANN * temperature_;
-    total_flips_ = 0;
-    seed_ = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    gen_.seed(seed_);
+    for(size_t i = 0; i < boltzmann_.size(); i++)
+    {
+      boltzmann_[i] = std::exp(-0.5 * static_cast<double>(i) / kT_);
+    }
+    seed_ = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
   }
 
   void determine_dimensionality()
@@ -338,6 +457,103 @@ private:
     }
   }
 
+  /**
+   * @brief generate_colors Colors every axis so that coordinates of the same color are at least 2 apart.
+   * Alternating colors suffice, except for an odd periodic axis, where the last coordinate neighbors the
+   * first one and gets a third color. The color of a site combines the colors of its coordinates.
+   */
+  void generate_colors()
+  {
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      size_t dim = dims_[axis];
+      size_t numColors = 2;
+      if(dim == 1)
+      {
+        numColors = 1;
+      }
+      else if(periodic_ && dim % 2 == 1)
+      {
+        numColors = 3;
+      }
+      axis_coords_[axis].assign(numColors, std::vector<size_t>());
+      for(size_t coord = 0; coord < dim; coord++)
+      {
+        size_t color = (numColors == 1) ? 0 : coord % 2;
+        if(numColors == 3 && coord == dim - 1)
+        {
+          color = 2;
+        }
+        axis_coords_[axis][color].push_back(coord);
+      }
+    }
+  }
+
+  /**
+   * @brief generate_offsets Computes the linear index offsets of the valid neighbors of a site of each
+   * boundary class. All sites of a class share their offsets, including the wrapped offsets of periodic
+   * boundaries.
+   */
+  void generate_offsets()
+  {
+    offsets_.assign(k_NumBoundaryClasses * k_MaxNeighbors, 0);
+    num_offsets_.fill(0);
+    for(size_t siteClass = 0; siteClass < k_NumBoundaryClasses; siteClass++)
+    {
+      // a representative site of the class; classes that no site belongs to are skipped
+      size_t coords[3] = {0, 0, 0};
+      bool exists = true;
+      size_t axisClass = siteClass;
+      for(size_t axis = 0; axis < 3; axis++, axisClass /= 3)
+      {
+        switch(axisClass % 3)
+        {
+        case 0:
+          coords[axis] = 0;
+          break;
+        case 1:
+          coords[axis] = 1;
+          exists = exists && (dims_[axis] > 2);
+          break;
+        default:
+          coords[axis] = dims_[axis] - 1;
+          exists = exists && (dims_[axis] > 1);
+          break;
+        }
+      }
+      if(!exists)
+      {
+        continue;
+      }
+
+      size_t index = neighbor_index(coords[0], coords[1], coords[2]);
+      for(auto&& neighbor : neighborhood_)
+      {
+        size_t neigh = 0;
+        if(periodic_)
+        {
+          size_t modx = apply_modular_operation(coords[0], neighbor[0], dims_[0]);
+          size_t mody = apply_modular_operation(coords[1], neighbor[1], dims_[1]);
+          size_t modz = apply_modular_operation(coords[2], neighbor[2], dims_[2]);
+          neigh = neighbor_index(modx, mody, modz);
+        }
+        else
+        {
+          int64_t modx = static_cast<int64_t>(coords[0]) + neighbor[0];
+          int64_t mody = static_cast<int64_t>(coords[1]) + neighbor[1];
+          int64_t modz = static_cast<int64_t>(coords[2]) + neighbor[2];
+          if((modx < 0 || modx >= static_cast<int64_t>(dims_[0])) || (mody < 0 || mody >= static_cast<int64_t>(dims_[1])) || (modz < 0 || modz >= static_cast<int64_t>(dims_[2])))
+          {
+            continue;
+          }
+          neigh = neighbor_index(modx, mody, modz);
+        }
+        offsets_[siteClass * k_MaxNeighbors + num_offsets_[siteClass]] = static_cast<int64_t>(neigh) - static_cast<int64_t>(index);
+        num_offsets_[siteClass]++;
+      }
+    }
+  }
+
   ImageGeom::Pointer image_;
   double temperature_;
   double kT_{};
@@ -347,9 +563,274 @@ private:
   bool* mask_;
   size_t dims_[3]{};
   Dimension dim_type_;
-  size_t total_flips_{};
-  std::mt19937_64::result_type seed_{};
+  std::array<std::vector<std::vector<size_t>>, 3> axis_coords_;
+  std::vector<int64_t> offsets_;
+  std::array<size_t, k_NumBoundaryClasses> num_offsets_{};
+  std::array<double, k_MaxNeighbors + 1> boltzmann_{};
+  uint64_t seed_{};
+};
+
+/**
+ * @brief The CheckerboardSweepImpl class attempts the flips of all sites of one color, one row at a time
+ */
+class CheckerboardSweepImpl
+{
+public:
+  CheckerboardSweepImpl(AbstractFilter* filter, const SpinLattice& lattice, size_t color, uint64_t iteration, std::vector<size_t>& rowFlips)
+  : m_Filter(filter)
+  , m_Lattice(lattice)
+  , m_Color(color)
+  , m_Iteration(iteration)
+  , m_RowFlips(rowFlips)
+  {
+  }
+  virtual ~CheckerboardSweepImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t row = start; row < end; row++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      m_RowFlips[row] = m_Lattice.attempt_flips(m_Color, row, m_Iteration);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  const SpinLattice& m_Lattice;
+  size_t m_Color;
+  uint64_t m_Iteration;
+  std::vector<size_t>& m_RowFlips;
+};
+
+/**
+ * @brief The RejectionFreeSolver class reproduces the dynamics of Metropolis attempts at randomly chosen
+ * sites without ever drawing a rejected attempt (the n-fold way of Bortz, Kalos and Lebowitz). The rate
+ * of a site is the probability that an attempt at that site flips it. Only sites with a nonzero rate,
+ * i.e., sites next to a different spin that they may flip to, are kept, in a binary sum tree over their
+ * rates. An event is drawn in proportion to the rates, and the time advances by an exponentially
+ * distributed waiting time whose mean is the inverse of the total rate. Times are in Monte Carlo steps,
+ * i.e., one attempt per lattice site, so they match the sweeps of the Metropolis solver.
+ */
+class RejectionFreeSolver
+{
+public:
+  RejectionFreeSolver(const SpinLattice& lattice, int32_t* fIds)
+  : lattice_(lattice)
+  , fIds_(fIds)
+  , position_(lattice.num_sites(), k_Inactive)
+  , capacity_(1)
+  , tree_(2, 0.0)
+  , gen_(lattice.seed())
+  {
+  }
+
+  virtual ~RejectionFreeSolver() = default;
+
+  /**
+   * @brief initialize Computes the rates of all sites
+   */
+  void initialize(AbstractFilter* filter)
+  {
+    for(size_t i = 0; i < lattice_.num_sites(); i++)
+    {
+      if((i & 0xFFFF) == 0 && filter->getCancel())
+      {
+        return;
+      }
+      update_rate(i);
+    }
+  }
+
+  double total_rate() const
+  {
+    return tree_[1];
+  }
+
+  size_t num_boundary_sites() const
+  {
+    return active_.size();
+  }
+
+  /**
+   * @brief waiting_time Draws the time until the next event, in Monte Carlo steps
+   */
+  double waiting_time()
+  {
+    return -std::log(1.0 - dist_(gen_)) / tree_[1];
+  }
+
+  /**
+   * @brief execute_event Draws a site in proportion to its rate and flips it to a neighboring spin drawn
+   * in proportion to the acceptance probability of the flip, then updates the rates around the site
+   */
+  void execute_event()
+  {
+    double target = dist_(gen_) * tree_[1];
+    size_t node = 1;
+    while(node < capacity_)
+    {
+      size_t left = 2 * node;
+      if(target < tree_[left] || tree_[left + 1] <= 0.0)
+      {
+        node = left;
+      }
+      else
+      {
+        target -= tree_[left];
+        node = left + 1;
+      }
+    }
+    size_t site = active_[std::min(node - capacity_, active_.size() - 1)];
+
+    std::array<size_t, k_MaxNeighbors> neighbors;
+    std::array<int32_t, k_MaxNeighbors> spins;
+    std::array<double, k_MaxNeighbors> weights;
+    double sum = 0.0;
+    size_t numNeighbors = flip_weights(site, neighbors, spins, weights, sum);
+
+    target = dist_(gen_) * sum;
+    size_t chosen = numNeighbors;
+    for(size_t n = 0; n < numNeighbors; n++)
+    {
+      if(weights[n] <= 0.0)
+      {
+        continue;
+      }
+      chosen = n;
+      if(target < weights[n])
+      {
+        break;
+      }
+      target -= weights[n];
+    }
+    fIds_[site] = spins[chosen];
+
+    update_rate(site);
+    for(size_t n = 0; n < numNeighbors; n++)
+    {
+      update_rate(neighbors[n]);
+    }
+  }
+
+private:
+  /**
+   * @brief flip_weights Computes the acceptance probability of flipping a site to the spin of each of its
+   * valid neighbors; flips to Feature Id 0 or to the current spin have no weight
+   * @return Number of valid neighbors
+   */
+  size_t flip_weights(size_t site, std::array<size_t, k_MaxNeighbors>& neighbors, std::array<int32_t, k_MaxNeighbors>& spins, std::array<double, k_MaxNeighbors>& weights, double& sum) const
+  {
+    sum = 0.0;
+    size_t numNeighbors = lattice_.valid_neighbors(site, neighbors);
+    int32_t spin = fIds_[site];
+    for(size_t n = 0; n < numNeighbors; n++)
+    {
+      spins[n] = fIds_[neighbors[n]];
+    }
+    size_t same = static_cast<size_t>(std::count(spins.begin(), spins.begin() + numNeighbors, spin));
+    if(same == numNeighbors)
+    {
+      return 0;
+    }
+    for(size_t n = 0; n < numNeighbors; n++)
+    {
+      weights[n] = 0.0;
+      if(spins[n] != 0 && spins[n] != spin)
+      {
+        size_t sameCandidate = static_cast<size_t>(std::count(spins.begin(), spins.begin() + numNeighbors, spins[n]));
+        weights[n] = lattice_.acceptance(same, sameCandidate);
+        sum += weights[n];
+      }
+    }
+    return numNeighbors;
+  }
+
+  void update_rate(size_t site)
+  {
+    double rate = 0.0;
+    if(lattice_.is_flippable(site))
+    {
+      std::array<size_t, k_MaxNeighbors> neighbors;
+      std::array<int32_t, k_MaxNeighbors> spins;
+      std::array<double, k_MaxNeighbors> weights;
+      size_t numNeighbors = flip_weights(site, neighbors, spins, weights, rate);
+      // an attempt picks each valid neighbor with the same probability
+      rate = (numNeighbors > 0) ? rate / static_cast<double>(numNeighbors) : 0.0;
+    }
+
+    size_t pos = position_[site];
+    if(rate > 0.0)
+    {
+      if(pos == k_Inactive)
+      {
+        pos = active_.size();
+        active_.push_back(site);
+        position_[site] = pos;
+        if(active_.size() > capacity_)
+        {
+          grow();
+        }
+      }
+      set_leaf(pos, rate);
+    }
+    else if(pos != k_Inactive)
+    {
+      // move the last boundary site into the vacated position
+      size_t last = active_.size() - 1;
+      if(pos != last)
+      {
+        active_[pos] = active_[last];
+        position_[active_[pos]] = pos;
+        set_leaf(pos, tree_[capacity_ + last]);
+      }
+      set_leaf(last, 0.0);
+      active_.pop_back();
+      position_[site] = k_Inactive;
+    }
+  }
+
+  void set_leaf(size_t pos, double rate)
+  {
+    size_t node = capacity_ + pos;
+    tree_[node] = rate;
+    for(node /= 2; node > 0; node /= 2)
+    {
+      tree_[node] = tree_[2 * node] + tree_[2 * node + 1];
+    }
+  }
+
+  void grow()
+  {
+    size_t capacity = 2 * capacity_;
+    std::vector<double> tree(2 * capacity, 0.0);
+    std::copy(tree_.begin() + capacity_, tree_.end(), tree.begin() + capacity);
+    for(size_t node = capacity - 1; node > 0; node--)
+    {
+      tree[node] = tree[2 * node] + tree[2 * node + 1];
+    }
+    capacity_ = capacity;
+    tree_.swap(tree);
+  }
+
+  const SpinLattice& lattice_;
+  int32_t* fIds_;
+  std::vector<size_t> active_;
+  std::vector<size_t> position_;
+  size_t capacity_;
+  std::vector<double> tree_;
   std::mt19937_64 gen_;
+  std::uniform_real_distribution<double> dist_{0.0, 1.0};
 };
 } // namespace
 
@@ -360,6 +841,7 @@ PottsModel::PottsModel()
 : m_Iterations(100)
 , m_Temperature(273.0)
 , m_PeriodicBoundaries(false)
+, m_Solver(0)
 , m_UseMask(false)
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
 , m_MaskArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
@@ -392,6 +874,17 @@ void PottsModel::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Iterations", Iterations, FilterParameter::Parameter, PottsModel));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Temperature", Temperature, FilterParameter::Parameter, PottsModel));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Periodic Boundaries", PeriodicBoundaries, FilterParameter::Parameter, PottsModel));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Solver");
+    parameter->setPropertyName("Solver");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(PottsModel, this, Solver));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(PottsModel, this, Solver));
+    QVector<QString> choices = {"Checkerboard Metropolis", "Rejection Free (n-Fold Way)"};
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
   QStringList linkedProps = {"MaskArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Parameter, PottsModel, linkedProps));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
@@ -421,6 +914,12 @@ void PottsModel::dataCheck()
     setErrorCondition(-5555, ss);
   }
 
+  if(getSolver() < 0 || getSolver() > 1)
+  {
+    QString ss = QObject::tr("The selected solver is not valid");
+    setErrorCondition(-5555, ss);
+  }
+
   getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getFeatureIdsArrayPath().getDataContainerName());
 
   if(getErrorCode() < 0)
@@ -487,84 +986,83 @@ void PottsModel::execute()
 
   ImageGeom::Pointer image = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getGeometryAs<ImageGeom>();
 
-  size_t numTuples = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-  size_t rangeMin = 0;
-  size_t rangeMax = numTuples - 1;
-  size_t numNeighbors = 5;
-  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  std::mt19937_64 gen(seed);
-  std::uniform_int_distribution<size_t> dist(rangeMin, rangeMax);
-  std::uniform_int_distribution<size_t> ndist(rangeMin, numNeighbors);
+  SpinLattice lattice(image, m_Temperature, m_PeriodicBoundaries, m_FeatureIds, m_UseMask ? m_Mask : nullptr);
 
-  if(m_UseMask)
-  {
-    size_t trues = 0;
-    for(size_t i = 0; i < numTuples; i++)
-    {
-      if(m_Mask[i])
-      {
-        trues++;
-      }
-    }
-    numTuples = trues;
-  }
-
-  SpinLattice lattice(image, m_Temperature, m_PeriodicBoundaries, m_FeatureIds, m_Mask);
-
-  int64_t iter = 0;
-  int64_t progPercent = (lattice.dimension() == Dimension::Two) ? 10 : 100;
-  int64_t progIncrement = numTuples / progPercent;
-
-  while(iter < m_Iterations)
+  if(getSolver() == 1)
   {
+    notifyStatusMessage(QObject::tr("Finding boundary sites"));
+    RejectionFreeSolver solver(lattice, m_FeatureIds);
+    solver.initialize(this);
     if(getCancel())
     {
       return;
     }
 
-    int64_t prog = 1;
-    int64_t progressInt = 0;
-    int64_t counter = 0;
-
-    for(size_t i = 0; i < numTuples; i++)
+    // Events are drawn until the next one would happen after the last Monte Carlo step, or until no site can flip
+    double time = 0.0;
+    int32_t iter = 0;
+    size_t totalFlips = 0;
+    while(solver.total_rate() > 0.0)
     {
-      size_t current = 0;
-
-      while(true)
+      time += solver.waiting_time();
+      if(time >= static_cast<double>(m_Iterations))
       {
-        current = dist(gen);
-        if(m_FeatureIds[current] == 0)
-        {
-          continue;
-        }
-        if(m_UseMask)
-        {
-          if(!m_Mask[current])
-          {
-            continue;
-          }
-        }
         break;
       }
+      solver.execute_event();
+      totalFlips++;
 
-      lattice.attempt_flip(current);
-
-      if(counter > prog)
+      if((totalFlips & 0xFFFF) == 0 && getCancel())
       {
-        progressInt = static_cast<int64_t>((static_cast<float>(counter) / numTuples) * static_cast<float>(progPercent));
-        if(lattice.dimension() == Dimension::Two)
-        {
-          progressInt *= 10;
-        }
-        QString ss = QObject::tr("Iteration %1 of %2 || %3% Completed || %4 Total Flips").arg(iter + 1).arg(m_Iterations).arg(progressInt).arg(lattice.total_flips());
+        return;
+      }
+      while(static_cast<double>(iter + 1) <= time)
+      {
+        iter++;
+        QString ss = QObject::tr("Iteration %1 of %2 || %3 Boundary Sites || %4 Total Flips").arg(iter).arg(m_Iterations).arg(solver.num_boundary_sites()).arg(totalFlips);
         notifyStatusMessage(ss);
-        prog = prog + progIncrement;
       }
-      counter++;
     }
-    iter++;
+    return;
   }
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Every Monte Carlo step sweeps the colors in a random order, attempting one flip per lattice site
+  size_t totalFlips = 0;
+  std::vector<size_t> rowFlips;
+  for(int32_t iter = 0; iter < m_Iterations; iter++)
+  {
+    std::vector<size_t> colors = lattice.color_order(static_cast<uint64_t>(iter));
+    for(size_t color : colors)
+    {
+      size_t numRows = lattice.num_rows(color);
+      rowFlips.assign(numRows, 0);
+      CheckerboardSweepImpl impl(this, lattice, color, static_cast<uint64_t>(iter), rowFlips);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.compute(0, numRows);
+      }
+
+      if(getCancel())
+      {
+        return;
+      }
+      totalFlips = std::accumulate(rowFlips.begin(), rowFlips.end(), totalFlips);
+    }
+
+    QString ss = QObject::tr("Iteration %1 of %2 || %3 Total Flips").arg(iter + 1).arg(m_Iterations).arg(totalFlips);
+    notifyStatusMessage(ss);
+  }
 }
 
 // -----------------------------------------------------------------------------
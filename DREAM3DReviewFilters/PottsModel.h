@@ -53,6 +53,7 @@ class DREAM3DReview_EXPORT PottsModel : public AbstractFilter
   PYB11_PROPERTY(int Iterations READ getIterations WRITE setIterations)
   PYB11_PROPERTY(double Temperature READ getTemperature WRITE setTemperature)
   PYB11_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
+  PYB11_PROPERTY(int Solver READ getSolver WRITE setSolver)
   PYB11_PROPERTY(bool UseMask READ getUseMask WRITE setUseMask)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
@@ -75,6 +76,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, PeriodicBoundaries)
   Q_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
 
+  SIMPL_FILTER_PARAMETER(int, Solver)
+  Q_PROPERTY(int Solver READ getSolver WRITE setSolver)
+
   SIMPL_FILTER_PARAMETER(bool, UseMask)
   Q_PROPERTY(bool UseMask READ getUseMask WRITE setUseMask)
 
@@ -13,20 +13,115 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ReadBinaryCTNorthStar.h"
 
+#include <algorithm>
+
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/ScopedFileMonitor.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/CTSubvolumeReader.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+/**
+ * @brief The ReadCTFilesImpl class reads a range of North Star data files. Each file holds a disjoint
+ * slab of z-slices, so every file is read in blocks of whole slices straight into its own part of the
+ * density array. Flipping both in-plane axes maps the in-slice index i to (sliceSize - 1 - i), so
+ * each slice is then simply reversed in place.
+ */
+class ReadCTFilesImpl
+{
+public:
+  enum FileStatus
+  {
+    Success = 0,
+    OpenFailed = 1,
+    ReadFailed = 2
+  };
+
+  ReadCTFilesImpl(AbstractFilter* filter, std::vector<QByteArray>& fileNames, std::vector<size_t>& zOffsets, std::vector<int64_t>& slicesPerFile, size_t sliceSize, float* data,
+                  std::vector<int32_t>& fileStatus)
+  : m_Filter(filter)
+  , m_FileNames(fileNames)
+  , m_ZOffsets(zOffsets)
+  , m_SlicesPerFile(slicesPerFile)
+  , m_SliceSize(sliceSize)
+  , m_Data(data)
+  , m_FileStatus(fileStatus)
+  {
+  }
+  virtual ~ReadCTFilesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    size_t slicesPerBlock = std::max(static_cast<size_t>(1), static_cast<size_t>(64 * 1024 * 1024) / (m_SliceSize * sizeof(float)));
+    for(size_t iter = start; iter < end; iter++)
+    {
+      FILE* f = fopen(m_FileNames[iter].data(), "rb");
+      if(nullptr == f)
+      {
+        m_FileStatus[iter] = OpenFailed;
+        continue;
+      }
+
+      ScopedFileMonitor monitor(f);
+
+      size_t numSlices = static_cast<size_t>(m_SlicesPerFile[iter]);
+      for(size_t z = 0; z < numSlices; z += slicesPerBlock)
+      {
+        if(m_Filter->getCancel())
+        {
+          return;
+        }
+        size_t blockSlices = std::min(slicesPerBlock, numSlices - z);
+        size_t numValues = blockSlices * m_SliceSize;
+        float* block = m_Data + (m_ZOffsets[iter] + z) * m_SliceSize;
+        if(fread(block, sizeof(float), numValues, f) != numValues)
+        {
+          m_FileStatus[iter] = ReadFailed;
+          break;
+        }
+        for(size_t i = 0; i < blockSlices; i++)
+        {
+          std::reverse(block + i * m_SliceSize, block + (i + 1) * m_SliceSize);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  std::vector<QByteArray>& m_FileNames;
+  std::vector<size_t>& m_ZOffsets;
+  std::vector<int64_t>& m_SlicesPerFile;
+  size_t m_SliceSize;
+  float* m_Data;
+  std::vector<int32_t>& m_FileStatus;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -34,10 +129,21 @@ ReadBinaryCTNorthStar::ReadBinaryCTNorthStar()
 : m_InputFiles(0, "")
 , m_SlicesPerFile(0, 0)
 , m_InputHeaderFile("")
+, m_ImportSubvolume(false)
+, m_AverageSubvolumeBins(false)
 , m_DataContainerName("ImageDataContainer")
 , m_CellAttributeMatrixName("CellData")
 , m_DensityArrayName("Density")
 {
+  m_SubvolumeMinIndex[0] = 0;
+  m_SubvolumeMinIndex[1] = 0;
+  m_SubvolumeMinIndex[2] = 0;
+  m_SubvolumeMaxIndex[0] = 0;
+  m_SubvolumeMaxIndex[1] = 0;
+  m_SubvolumeMaxIndex[2] = 0;
+  m_SubvolumeStride[0] = 1;
+  m_SubvolumeStride[1] = 1;
+  m_SubvolumeStride[2] = 1;
 }
 
 // -----------------------------------------------------------------------------
@@ -52,6 +158,16 @@ void ReadBinaryCTNorthStar::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Input Header File", InputHeaderFile, FilterParameter::Parameter, ReadBinaryCTNorthStar, "*.nsihdr", "NSI header"));
+  QStringList linkedProps;
+  linkedProps << "SubvolumeMinIndex"
+              << "SubvolumeMaxIndex"
+              << "SubvolumeStride"
+              << "AverageSubvolumeBins";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Import Subvolume", ImportSubvolume, FilterParameter::Parameter, ReadBinaryCTNorthStar, linkedProps));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Minimum Voxel", SubvolumeMinIndex, FilterParameter::Parameter, ReadBinaryCTNorthStar));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Maximum Voxel", SubvolumeMaxIndex, FilterParameter::Parameter, ReadBinaryCTNorthStar));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Subvolume Stride", SubvolumeStride, FilterParameter::Parameter, ReadBinaryCTNorthStar));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Average Voxels Within Stride", AverageSubvolumeBins, FilterParameter::Parameter, ReadBinaryCTNorthStar));
   parameters.push_back(SIMPL_NEW_STRING_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ReadBinaryCTNorthStar));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Attribute Matrix", CellAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadBinaryCTNorthStar));
@@ -66,6 +182,11 @@ void ReadBinaryCTNorthStar::readFilterParameters(AbstractFilterParametersReader*
 {
   reader->openFilterGroup(this, index);
   setInputHeaderFile(reader->readString("InputHeaderFile", getInputHeaderFile()));
+  setImportSubvolume(reader->readValue("ImportSubvolume", getImportSubvolume()));
+  setSubvolumeMinIndex(reader->readIntVec3("SubvolumeMinIndex", getSubvolumeMinIndex()));
+  setSubvolumeMaxIndex(reader->readIntVec3("SubvolumeMaxIndex", getSubvolumeMaxIndex()));
+  setSubvolumeStride(reader->readIntVec3("SubvolumeStride", getSubvolumeStride()));
+  setAverageSubvolumeBins(reader->readValue("AverageSubvolumeBins", getAverageSubvolumeBins()));
   setDataContainerName(reader->readString("DataContainerName", getDataContainerName()));
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setDensityArrayName(reader->readString("DensityArrayName", getDensityArrayName()));
@@ -136,6 +257,17 @@ void ReadBinaryCTNorthStar::dataCheck()
     return;
   }
 
+  m_VolumeDimensions = image->getDimensions();
+
+  if(getImportSubvolume())
+  {
+    err = ApplyCTSubvolume(this, image, getSubvolumeMinIndex(), getSubvolumeMaxIndex(), getSubvolumeStride());
+    if(err < 0)
+    {
+      return;
+    }
+  }
+
   QFileInfo headerPath(getInputHeaderFile());
   QDir headerDir = headerPath.absoluteDir();
 
@@ -219,6 +351,10 @@ int32_t ReadBinaryCTNorthStar::readBinaryCTFiles(size_t dims[3])
   int32_t error = 0;
   size_t zShift = 0;
 
+  std::vector<QByteArray> fileNames(m_InputFiles.size());
+  std::vector<size_t> zOffsets(m_InputFiles.size(), 0);
+  std::vector<int32_t> fileStatus(m_InputFiles.size(), ReadCTFilesImpl::Success);
+
   for(size_t iter = 0; iter < m_InputFiles.size(); iter++)
   {
     QFileInfo fi(m_InputFiles[iter]);
@@ -235,51 +371,89 @@ int32_t ReadBinaryCTNorthStar::readBinaryCTFiles(size_t dims[3])
       return getErrorCode();
     }
 
-    FILE* f = fopen(m_InputFiles[iter].toLatin1().data(), "rb");
-    if(nullptr == f)
+    fileNames[iter] = m_InputFiles[iter].toLatin1();
+    zOffsets[iter] = zShift;
+    zShift += m_SlicesPerFile[iter];
+  }
+
+  notifyStatusMessage(QObject::tr("Reading Data || %1 Data Files").arg(m_InputFiles.size()));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  float* ptr = m_DensityPtr.lock()->getPointer(0);
+  size_t sliceSize = dims[0] * dims[1];
+
+  // every file covers its own z-slab, so the files are read concurrently with one task per file
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_InputFiles.size(), 1), ReadCTFilesImpl(this, fileNames, zOffsets, m_SlicesPerFile, sliceSize, ptr, fileStatus), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    ReadCTFilesImpl serial(this, fileNames, zOffsets, m_SlicesPerFile, sliceSize, ptr, fileStatus);
+    serial.compute(0, m_InputFiles.size());
+  }
+
+  for(size_t iter = 0; iter < m_InputFiles.size(); iter++)
+  {
+    if(fileStatus[iter] == ReadCTFilesImpl::OpenFailed)
     {
       QString ss = QObject::tr("Error opening binary input file: %1").arg(m_InputFiles[iter]);
       setErrorCondition(-100, ss);
       return getErrorCode();
     }
+    if(fileStatus[iter] == ReadCTFilesImpl::ReadFailed)
+    {
+      QString ss = QObject::tr("Error reading binary input file: %1").arg(m_InputFiles[iter]);
+      setErrorCondition(-100, ss);
+      return getErrorCode();
+    }
+  }
 
-    ScopedFileMonitor monitor(f);
+  return error;
+}
 
-    float* ptr = m_DensityPtr.lock()->getPointer(0);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t ReadBinaryCTNorthStar::readBinaryCTSubvolume(size_t dims[3])
+{
+  if(m_InputFiles.empty())
+  {
+    QString ss = QObject::tr("The header file does not list any binary input files");
+    setErrorCondition(-100, ss);
+    return getErrorCode();
+  }
 
-    size_t index = 0;
-    size_t totalPoints = dims[0] * dims[1] * m_SlicesPerFile[iter];
-    int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
-    int64_t prog = 1;
-    int64_t progressInt = 0;
-    int64_t counter = 0;
+  std::vector<QString> fileNames(m_InputFiles.size());
+  std::vector<size_t> zOffsets(m_InputFiles.size(), 0);
+  size_t zShift = 0;
 
-    for(size_t z = zShift; z < (zShift + m_SlicesPerFile[iter]); z++)
-    {
-      for(size_t y = 0; y < dims[1]; y++)
-      {
-        for(size_t x = 0; x < dims[0]; x++)
-        {
-          // Compute the proper index into the final storage array
-          index = (dims[0] * dims[1] * z) + (dims[0] * (dims[1] - y - 1)) + (dims[0] - x - 1);
-          fread(ptr + index, sizeof(float), 1, f);
+  for(size_t iter = 0; iter < m_InputFiles.size(); iter++)
+  {
+    QFileInfo fi(m_InputFiles[iter]);
+    size_t filesize = static_cast<size_t>(fi.size());
+    size_t allocatedBytes = m_VolumeDimensions[0] * m_VolumeDimensions[1] * m_SlicesPerFile[iter] * sizeof(float);
 
-          // Check for progress
-          if(counter > prog)
-          {
-            progressInt = static_cast<int64_t>((static_cast<float>(counter) / totalPoints) * 100.0f);
-            QString ss = QObject::tr("Reading Data || Data File: %1 of %2 || %3% Completed").arg(iter + 1).arg(m_InputFiles.size()).arg(progressInt);
-            notifyStatusMessage(ss);
-            prog = prog + progIncrement;
-          }
-          counter++;
-        }
-      }
+    if(sanityCheckFileSizeVersusAllocatedSize(allocatedBytes, filesize) < 0)
+    {
+      QString ss = QObject::tr("Binary file size is smaller than the number of bytes in the volume");
+      setErrorCondition(-100, ss);
+      return getErrorCode();
     }
+
+    fileNames[iter] = m_InputFiles[iter];
+    zOffsets[iter] = zShift;
     zShift += m_SlicesPerFile[iter];
   }
 
-  return error;
+  float* ptr = m_DensityPtr.lock()->getPointer(0);
+  return ReadCTSubvolume(this, fileNames, zOffsets, m_VolumeDimensions, getSubvolumeMinIndex(), getSubvolumeMaxIndex(), getSubvolumeStride(), getAverageSubvolumeBins(), ptr, dims);
 }
 
 // -----------------------------------------------------------------------------
@@ -480,7 +654,14 @@ void ReadBinaryCTNorthStar::execute()
 
   SizeVec3Type dims = image->getDimensions();
 
-  err = readBinaryCTFiles(dims.data());
+  if(getImportSubvolume())
+  {
+    err = readBinaryCTSubvolume(dims.data());
+  }
+  else
+  {
+    err = readBinaryCTFiles(dims.data());
+  }
 
   if(err < 0)
   {
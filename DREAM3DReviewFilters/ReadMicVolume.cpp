@@ -0,0 +1,769 @@
+/* ============================================================================
+* Software developed by US federal government employees (including military personnel)
+* as part of their official duties is not subject to copyright protection and is
+* considered “public domain” (see 17 USC Section 105). Public domain software can be used
+* by anyone for any purpose, and cannot be released under a copyright license
+* (including typical open source software licenses).
+*
+* This source code file was originally written by United States DoD employees. The
+* original source code files are released into the Public Domain.
+*
+* Subsequent changes to the codes by others may elect to add a copyright and license
+* for those changes.
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ReadMicVolume.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QFileInfo>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "EbsdLib/EbsdLib.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/FilePathGenerator.h"
+
+#include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewVersion.h"
+
+enum createdPathID : RenameDataPath::DataID_t
+{
+  AttributeMatrixID21 = 21,
+  AttributeMatrixID22 = 22,
+
+  DataArrayID31 = 31,
+  DataArrayID32 = 32,
+  DataArrayID33 = 33,
+  DataArrayID34 = 34,
+  DataArrayID35 = 35,
+
+  DataContainerID = 1
+};
+
+namespace
+{
+/**
+ * @brief The ReadMicSlicesImpl class reads the .mic files of a set of slices. Every slice is read
+ * into its own MicSlice, so that the files can be read concurrently.
+ */
+class ReadMicSlicesImpl
+{
+public:
+  ReadMicSlicesImpl(AbstractFilter* filter, const std::vector<QString>& fileNames, const std::vector<size_t>& sliceIndices, bool boundsOnly, std::vector<MicReader::MicSlice>& slices,
+                    std::vector<int32_t>& errors, std::vector<QString>& errorMessages)
+  : m_Filter(filter)
+  , m_FileNames(fileNames)
+  , m_SliceIndices(sliceIndices)
+  , m_BoundsOnly(boundsOnly)
+  , m_Slices(slices)
+  , m_Errors(errors)
+  , m_ErrorMessages(errorMessages)
+  {
+  }
+  virtual ~ReadMicSlicesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      size_t slice = m_SliceIndices[i];
+      m_Errors[slice] = MicReader::ReadMicSlice(m_FileNames[slice], m_BoundsOnly, m_Slices[slice], m_ErrorMessages[slice]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  const std::vector<QString>& m_FileNames;
+  const std::vector<size_t>& m_SliceIndices;
+  bool m_BoundsOnly;
+  std::vector<MicReader::MicSlice>& m_Slices;
+  std::vector<int32_t>& m_Errors;
+  std::vector<QString>& m_ErrorMessages;
+};
+
+/**
+ * @brief The RasterizeMicSlicesImpl class rasterizes the triangles of a range of slices onto their
+ * z-slices of the volume, and releases the triangles of each slice once it is done
+ */
+class RasterizeMicSlicesImpl
+{
+public:
+  RasterizeMicSlicesImpl(AbstractFilter* filter, std::vector<MicReader::MicSlice>& slices, float xMin, float yMin, size_t xDim, size_t yDim, float* eulerAngles, float* confidence)
+  : m_Filter(filter)
+  , m_Slices(slices)
+  , m_XMin(xMin)
+  , m_YMin(yMin)
+  , m_XDim(xDim)
+  , m_YDim(yDim)
+  , m_EulerAngles(eulerAngles)
+  , m_Confidence(confidence)
+  {
+  }
+  virtual ~RasterizeMicSlicesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t z = start; z < end; z++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      size_t sliceOffset = z * m_XDim * m_YDim;
+      float* eulerAngles = m_EulerAngles;
+      float* confidence = m_Confidence;
+      MicReader::RasterizeMicSlice(m_Slices[z], m_XMin, m_YMin, m_XDim, m_YDim, [=](size_t point, size_t, size_t, const MicReader::MicTriangle& triangle) {
+        size_t index = sliceOffset + point;
+        eulerAngles[3 * index + 0] = triangle.euler[0];
+        eulerAngles[3 * index + 1] = triangle.euler[1];
+        eulerAngles[3 * index + 2] = triangle.euler[2];
+        confidence[index] = triangle.conf;
+      });
+      std::vector<MicReader::MicTriangle>().swap(m_Slices[z].triangles);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  std::vector<MicReader::MicSlice>& m_Slices;
+  float m_XMin;
+  float m_YMin;
+  size_t m_XDim;
+  size_t m_YDim;
+  float* m_EulerAngles;
+  float* m_Confidence;
+};
+} // namespace
+
+/* ############## Start Private Implementation ############################### */
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+class ReadMicVolumePrivate
+{
+  Q_DISABLE_COPY(ReadMicVolumePrivate)
+  Q_DECLARE_PUBLIC(ReadMicVolume)
+  ReadMicVolume* const q_ptr;
+  ReadMicVolumePrivate(ReadMicVolume* ptr);
+
+  QVector<QString> m_InputFile_Cache;
+  QVector<QDateTime> m_TimeStamp_Cache;
+  std::vector<MicReader::MicSlice> m_SliceBounds_Cache;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ReadMicVolumePrivate::ReadMicVolumePrivate(ReadMicVolume* ptr)
+: q_ptr(ptr)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ReadMicVolume::ReadMicVolume()
+: m_SliceSpacing(1.0f)
+, m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
+, m_CellEnsembleAttributeMatrixName(SIMPL::Defaults::CellEnsembleAttributeMatrixName)
+, m_CellAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
+, m_MaterialNameArrayName(SIMPL::EnsembleData::PhaseName)
+, m_CellEulerAnglesArrayName(SIMPL::CellData::EulerAngles)
+, m_CellPhasesArrayName(SIMPL::CellData::Phases)
+, m_ConfidenceArrayName(Mic::Confidence)
+, m_CrystalStructuresArrayName(SIMPL::EnsembleData::CrystalStructures)
+, m_LatticeConstantsArrayName(SIMPL::EnsembleData::LatticeConstants)
+, d_ptr(new ReadMicVolumePrivate(this))
+{
+  m_InputFileListInfo.StartIndex = 0;
+  m_InputFileListInfo.EndIndex = 0;
+  m_InputFileListInfo.IncrementIndex = 1;
+  m_InputFileListInfo.PaddingDigits = 0;
+  m_InputFileListInfo.Ordering = 0;
+  m_InputFileListInfo.FileExtension = Mic::FileExt;
+  m_InputFileListInfo.FilePrefix = "";
+  m_InputFileListInfo.FileSuffix = "";
+  m_InputFileListInfo.InputPath = "";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ReadMicVolume::~ReadMicVolume() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SIMPL_PIMPL_PROPERTY_DEF(ReadMicVolume, QVector<QString>, InputFile_Cache)
+SIMPL_PIMPL_PROPERTY_DEF(ReadMicVolume, QVector<QDateTime>, TimeStamp_Cache)
+SIMPL_PIMPL_PROPERTY_DEF(ReadMicVolume, std::vector<MicReader::MicSlice>, SliceBounds_Cache)
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicVolume::setupFilterParameters()
+{
+  FilterParameterVectorType parameters;
+  parameters.push_back(SIMPL_NEW_FILELISTINFO_FP("Input File List", InputFileListInfo, FilterParameter::Parameter, ReadMicVolume));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Slice Spacing (Microns)", SliceSpacing, FilterParameter::Parameter, ReadMicVolume));
+  parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ReadMicVolume));
+  parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Attribute Matrix", CellAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadMicVolume));
+  parameters.push_back(SeparatorFilterParameter::New("Cell Ensemble Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Ensemble Attribute Matrix", CellEnsembleAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadMicVolume));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicVolume::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setInputFileListInfo(reader->readFileListInfo("InputFileListInfo", getInputFileListInfo()));
+  setSliceSpacing(reader->readValue("SliceSpacing", getSliceSpacing()));
+  setDataContainerName(reader->readDataArrayPath("DataContainerName", getDataContainerName()));
+  setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
+  setCellEnsembleAttributeMatrixName(reader->readString("CellEnsembleAttributeMatrixName", getCellEnsembleAttributeMatrixName()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicVolume::flushCache()
+{
+  setInputFile_Cache(QVector<QString>());
+  setTimeStamp_Cache(QVector<QDateTime>());
+  setSliceBounds_Cache(std::vector<MicReader::MicSlice>());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicVolume::initialize()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<QString> ReadMicVolume::generateFileList()
+{
+  bool hasMissingFiles = false;
+  bool orderAscending = (m_InputFileListInfo.Ordering == 0);
+  return FilePathGenerator::GenerateFileList(m_InputFileListInfo.StartIndex, m_InputFileListInfo.EndIndex, m_InputFileListInfo.IncrementIndex, hasMissingFiles, orderAscending,
+                                             m_InputFileListInfo.InputPath, m_InputFileListInfo.FilePrefix, m_InputFileListInfo.FileSuffix, m_InputFileListInfo.FileExtension,
+                                             m_InputFileListInfo.PaddingDigits);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ReadMicVolume::updateSliceCache(const QVector<QString>& fileList)
+{
+  QVector<QString> cachedFiles = getInputFile_Cache();
+  QVector<QDateTime> cachedTimeStamps = getTimeStamp_Cache();
+  std::vector<MicReader::MicSlice> cachedSlices = getSliceBounds_Cache();
+
+  std::vector<QString> fileNames(fileList.begin(), fileList.end());
+  QVector<QDateTime> timeStamps(fileList.size());
+  std::vector<MicReader::MicSlice> slices(fileNames.size());
+  std::vector<size_t> staleSlices;
+  for(int32_t i = 0; i < fileList.size(); i++)
+  {
+    QFileInfo fi(fileList[i]);
+    timeStamps[i] = fi.lastModified();
+    int32_t cached = cachedFiles.indexOf(fileList[i]);
+    if(cached >= 0 && cachedTimeStamps[cached].isValid() && cachedTimeStamps[cached] >= timeStamps[i])
+    {
+      slices[i] = cachedSlices[cached];
+    }
+    else
+    {
+      staleSlices.push_back(static_cast<size_t>(i));
+    }
+  }
+
+  if(!staleSlices.empty())
+  {
+    std::vector<int32_t> errors(fileNames.size(), 0);
+    std::vector<QString> errorMessages(fileNames.size());
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+#endif
+
+    ReadMicSlicesImpl impl(this, fileNames, staleSlices, true, slices, errors, errorMessages);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, staleSlices.size()), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.compute(0, staleSlices.size());
+    }
+
+    if(getCancel())
+    {
+      return -1;
+    }
+    for(size_t i = 0; i < errors.size(); i++)
+    {
+      if(errors[i] < 0)
+      {
+        setErrorCondition(errors[i], errorMessages[i]);
+        return errors[i];
+      }
+    }
+  }
+
+  setInputFile_Cache(fileList);
+  setTimeStamp_Cache(timeStamps);
+  setSliceBounds_Cache(slices);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ReadMicVolume::findVolumeGrid(SizeVec3Type& dims, float& xMin, float& yMin, float& edgeLength)
+{
+  const std::vector<MicReader::MicSlice>& slices = d_ptr->m_SliceBounds_Cache;
+  if(slices.empty())
+  {
+    return -1;
+  }
+
+  edgeLength = slices[0].edgeLength;
+  xMin = slices[0].xMin;
+  yMin = slices[0].yMin;
+  float xMax = slices[0].xMax;
+  float yMax = slices[0].yMax;
+  for(size_t i = 1; i < slices.size(); i++)
+  {
+    // the slices share the grid of the volume, so their triangles must be equally refined
+    if(std::fabs(slices[i].edgeLength - edgeLength) > 1.0e-5f * edgeLength)
+    {
+      QString ss = QObject::tr("The triangles of %1 have an edge length of %2, while those of %3 have an edge length of %4. All slices must have the same edge length.")
+                       .arg(d_ptr->m_InputFile_Cache[static_cast<int32_t>(i)])
+                       .arg(slices[i].edgeLength)
+                       .arg(d_ptr->m_InputFile_Cache[0])
+                       .arg(edgeLength);
+      setErrorCondition(-23003, ss);
+      return -23003;
+    }
+    xMin = std::min(xMin, slices[i].xMin);
+    yMin = std::min(yMin, slices[i].yMin);
+    xMax = std::max(xMax, slices[i].xMax);
+    yMax = std::max(yMax, slices[i].yMax);
+  }
+
+  dims[0] = static_cast<size_t>((xMax - xMin) / edgeLength) + 1;
+  dims[1] = static_cast<size_t>((yMax - yMin) / edgeLength) + 1;
+  dims[2] = slices.size();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicVolume::dataCheck()
+{
+  DataArrayPath tempPath;
+  clearErrorCode();
+  clearWarningCode();
+
+  DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getDataContainerName(), DataContainerID);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  // Create the Image Geometry
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+  m->setGeometry(image);
+
+  std::vector<size_t> tDims(3, 0);
+  AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix(this, getCellAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell, AttributeMatrixID21);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+  tDims.resize(1);
+  tDims[0] = 0;
+  AttributeMatrix::Pointer cellEnsembleAttrMat = m->createNonPrereqAttributeMatrix(this, getCellEnsembleAttributeMatrixName(), tDims, AttributeMatrix::Type::CellEnsemble, AttributeMatrixID22);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  if(m_SliceSpacing <= 0.0f)
+  {
+    QString ss = QObject::tr("The slice spacing must be positive");
+    setErrorCondition(-23001, ss);
+    return;
+  }
+
+  QVector<QString> fileList = generateFileList();
+  if(fileList.empty())
+  {
+    QString ss = QObject::tr("No files have been selected for import. Have you set the input directory?");
+    setErrorCondition(-23002, ss);
+    return;
+  }
+  for(const auto& fileName : fileList)
+  {
+    QFileInfo fi(fileName);
+    if(!fi.exists())
+    {
+      QString ss = QObject::tr("The input file does not exist: '%1'").arg(fileName);
+      setErrorCondition(-388, ss);
+      return;
+    }
+    if(fi.suffix().compare(Mic::FileExt) != 0)
+    {
+      QString ss = QObject::tr("The File extension '%1' was not recognized. The reader only recognizes the .mic file extension").arg(fi.suffix());
+      setErrorCondition(-997, ss);
+      return;
+    }
+  }
+
+  // The grid of the volume depends on the extent of every slice. The extents of files that have not
+  // changed since they were last read are taken from the cache.
+  if(updateSliceCache(fileList) < 0)
+  {
+    return;
+  }
+  SizeVec3Type dims;
+  float xMin = 0.0f;
+  float yMin = 0.0f;
+  float edgeLength = 0.0f;
+  if(findVolumeGrid(dims, xMin, yMin, edgeLength) < 0)
+  {
+    return;
+  }
+  image->setDimensions(dims);
+  image->setSpacing(FloatVec3Type(edgeLength * 1000.0f, edgeLength * 1000.0f, m_SliceSpacing));
+  image->setOrigin(FloatVec3Type(xMin * 1000.0f, yMin * 1000.0f, 0.0f));
+
+  tDims.resize(3);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  cellAttrMat->resizeAttributeArrays(tDims);
+
+  std::vector<size_t> cDims(1, 3);
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellEulerAnglesArrayName());
+  m_CellEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, cDims, "", DataArrayID31);
+  if(nullptr != m_CellEulerAnglesPtr.lock())
+  {
+    m_CellEulerAngles = m_CellEulerAnglesPtr.lock()->getPointer(0);
+  }
+  cDims[0] = 1;
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellPhasesArrayName());
+  m_CellPhasesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, cDims, "", DataArrayID32);
+  if(nullptr != m_CellPhasesPtr.lock())
+  {
+    m_CellPhases = m_CellPhasesPtr.lock()->getPointer(0);
+  }
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getConfidenceArrayName());
+  m_ConfidencePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, cDims, "", DataArrayID33);
+  if(nullptr != m_ConfidencePtr.lock())
+  {
+    m_Confidence = m_ConfidencePtr.lock()->getPointer(0);
+  }
+
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellEnsembleAttributeMatrixName(), getCrystalStructuresArrayName());
+  m_CrystalStructuresPtr =
+      getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter, uint32_t>(this, tempPath, Ebsd::CrystalStructure::UnknownCrystalStructure, cDims, "", DataArrayID34);
+  if(nullptr != m_CrystalStructuresPtr.lock())
+  {
+    m_CrystalStructures = m_CrystalStructuresPtr.lock()->getPointer(0);
+  }
+  cDims[0] = 6;
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellEnsembleAttributeMatrixName(), getLatticeConstantsArrayName());
+  m_LatticeConstantsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0.0, cDims, "", DataArrayID35);
+  if(nullptr != m_LatticeConstantsPtr.lock())
+  {
+    m_LatticeConstants = m_LatticeConstantsPtr.lock()->getPointer(0);
+  }
+
+  StringDataArray::Pointer materialNames = StringDataArray::CreateArray(cellEnsembleAttrMat->getNumberOfTuples(), getMaterialNameArrayName(), true);
+  cellEnsembleAttrMat->insertOrAssign(materialNames);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicVolume::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicVolume::execute()
+{
+  clearErrorCode();
+  clearWarningCode();
+
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  QVector<QString> fileList = getInputFile_Cache();
+  std::vector<QString> fileNames(fileList.begin(), fileList.end());
+  std::vector<size_t> sliceIndices(fileNames.size());
+  for(size_t i = 0; i < sliceIndices.size(); i++)
+  {
+    sliceIndices[i] = i;
+  }
+
+  SizeVec3Type dims;
+  float xMin = 0.0f;
+  float yMin = 0.0f;
+  float edgeLength = 0.0f;
+  findVolumeGrid(dims, xMin, yMin, edgeLength);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // read the triangles of every slice concurrently
+  notifyStatusMessage(QObject::tr("Reading %1 slices").arg(fileNames.size()));
+  std::vector<MicReader::MicSlice> slices(fileNames.size());
+  std::vector<int32_t> errors(fileNames.size(), 0);
+  std::vector<QString> errorMessages(fileNames.size());
+  ReadMicSlicesImpl readImpl(this, fileNames, sliceIndices, false, slices, errors, errorMessages);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, sliceIndices.size()), readImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    readImpl.compute(0, sliceIndices.size());
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+  for(size_t i = 0; i < errors.size(); i++)
+  {
+    if(errors[i] < 0)
+    {
+      setErrorCondition(errors[i], errorMessages[i]);
+      return;
+    }
+    // a file that changed after the preflight would not fit the grid that the arrays were sized for
+    const MicReader::MicSlice& bounds = d_ptr->m_SliceBounds_Cache[i];
+    if(slices[i].edgeLength != bounds.edgeLength || slices[i].xMin != bounds.xMin || slices[i].xMax != bounds.xMax || slices[i].yMin != bounds.yMin || slices[i].yMax != bounds.yMax)
+    {
+      QString ss = QObject::tr("The input file '%1' changed while the filter was running").arg(fileNames[i]);
+      setErrorCondition(-23004, ss);
+      return;
+    }
+  }
+
+  // rasterize every slice onto its z-slice of the volume; as in the single slice reader, every point
+  // is assigned to the phase of the .dat file
+  notifyStatusMessage(QObject::tr("Rasterizing %1 slices").arg(fileNames.size()));
+  m_CellEulerAnglesPtr.lock()->initializeWithZeros();
+  m_ConfidencePtr.lock()->initializeWithZeros();
+  m_CellPhasesPtr.lock()->initializeWithValue(1);
+  RasterizeMicSlicesImpl rasterizeImpl(this, slices, xMin, yMin, dims[0], dims[1], m_CellEulerAngles, m_Confidence);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, slices.size()), rasterizeImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    rasterizeImpl.compute(0, slices.size());
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  loadMaterialInfo(fileNames[0]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ReadMicVolume::loadMaterialInfo(const QString& fileName)
+{
+  MicReader reader;
+  reader.setFileName(fileName);
+  int err = reader.readPhaseInfo();
+  QVector<MicPhase::Pointer> phases = reader.getPhaseVector();
+  if(err < 0 || phases.empty())
+  {
+    setErrorCondition(reader.getErrorCode(), reader.getErrorMessage());
+    return getErrorCode();
+  }
+
+  DataArray<unsigned int>::Pointer crystalStructures = DataArray<unsigned int>::CreateArray(phases.size() + 1, getCrystalStructuresArrayName(), true);
+  StringDataArray::Pointer materialNames = StringDataArray::CreateArray(phases.size() + 1, getMaterialNameArrayName());
+  std::vector<size_t> dims(1, 6);
+  FloatArrayType::Pointer latticeConstants = FloatArrayType::CreateArray(phases.size() + 1, dims, getLatticeConstantsArrayName(), true);
+
+  // Initialize the zero'th element to unknowns. The other elements will
+  // be filled in based on values from the data file
+  crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  materialNames->setValue(0, "Invalid Phase");
+  for(size_t c = 0; c < 6; c++)
+  {
+    latticeConstants->setComponent(0, c, 0.0f);
+  }
+
+  for(int32_t i = 0; i < phases.size(); i++)
+  {
+    int phaseID = phases[i]->getPhaseIndex();
+    crystalStructures->setValue(phaseID, phases[i]->determineLaueGroup());
+    materialNames->setValue(phaseID, phases[i]->getMaterialName());
+    QVector<float> lc = phases[i]->getLatticeConstants();
+    for(int32_t c = 0; c < 6; c++)
+    {
+      latticeConstants->setComponent(phaseID, c, lc[c]);
+    }
+  }
+
+  AttributeMatrix::Pointer attrMatrix = getDataContainerArray()->getDataContainer(getDataContainerName())->getAttributeMatrix(getCellEnsembleAttributeMatrixName());
+
+  // Resize the AttributeMatrix based on the size of the crystal structures array
+  std::vector<size_t> tDims(1, crystalStructures->getNumberOfTuples());
+  attrMatrix->resizeAttributeArrays(tDims);
+  attrMatrix->insertOrAssign(crystalStructures);
+  attrMatrix->insertOrAssign(materialNames);
+  attrMatrix->insertOrAssign(latticeConstants);
+
+  // Now reset the internal ensemble array references to these new arrays
+  m_CrystalStructuresPtr = crystalStructures;
+  m_CrystalStructures = crystalStructures->getPointer(0);
+  m_LatticeConstantsPtr = latticeConstants;
+  m_LatticeConstants = latticeConstants->getPointer(0);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer ReadMicVolume::newFilterInstance(bool copyFilterParameters) const
+{
+  ReadMicVolume::Pointer filter = ReadMicVolume::New();
+  if(copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicVolume::getCompiledLibraryName() const
+{
+  return DREAM3DReviewConstants::DREAM3DReviewBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicVolume::getBrandingString() const
+{
+  return "DREAM3DReview";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicVolume::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << DREAM3DReview::Version::Major() << "." << DREAM3DReview::Version::Minor() << "." << DREAM3DReview::Version::Patch();
+  return version;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicVolume::getGroupName() const
+{
+  return SIMPL::FilterGroups::IOFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicVolume::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::InputFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicVolume::getHumanLabel() const
+{
+  return "Import HEDM Volume (.mic)";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QUuid ReadMicVolume::getUuid()
+{
+  return QUuid("{0b1f5f62-3e4d-4c6a-9f0e-7d2c8a51b3e9}");
+}
@@ -0,0 +1,236 @@
+/* ============================================================================
+* Software developed by US federal government employees (including military personnel)
+* as part of their official duties is not subject to copyright protection and is
+* considered “public domain” (see 17 USC Section 105). Public domain software can be used
+* by anyone for any purpose, and cannot be released under a copyright license
+* (including typical open source software licenses).
+*
+* This source code file was originally written by United States DoD employees. The
+* original source code files are released into the Public Domain.
+*
+* Subsequent changes to the codes by others may elect to add a copyright and license
+* for those changes.
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QString>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/HEDM/MicReader.h"
+
+#include "DREAM3DReview/DREAM3DReviewConstants.h"
+
+// our PIMPL private class
+class ReadMicVolumePrivate;
+
+#include "DREAM3DReview/DREAM3DReviewDLLExport.h"
+
+/**
+ * @brief The ReadMicVolume class. See [Filter documentation](@ref readmicvolume) for details.
+ */
+class DREAM3DReview_EXPORT ReadMicVolume : public AbstractFilter
+{
+  Q_OBJECT
+  PYB11_CREATE_BINDINGS(ReadMicVolume SUPERCLASS AbstractFilter)
+  PYB11_PROPERTY(FileListInfo_t InputFileListInfo READ getInputFileListInfo WRITE setInputFileListInfo)
+  PYB11_PROPERTY(float SliceSpacing READ getSliceSpacing WRITE setSliceSpacing)
+  PYB11_PROPERTY(DataArrayPath DataContainerName READ getDataContainerName WRITE setDataContainerName)
+  PYB11_PROPERTY(QString CellEnsembleAttributeMatrixName READ getCellEnsembleAttributeMatrixName WRITE setCellEnsembleAttributeMatrixName)
+  PYB11_PROPERTY(QString CellAttributeMatrixName READ getCellAttributeMatrixName WRITE setCellAttributeMatrixName)
+  Q_DECLARE_PRIVATE(ReadMicVolume)
+
+public:
+  SIMPL_SHARED_POINTERS(ReadMicVolume)
+  SIMPL_FILTER_NEW_MACRO(ReadMicVolume)
+  SIMPL_TYPE_MACRO_SUPER_OVERRIDE(ReadMicVolume, AbstractFilter)
+
+  ~ReadMicVolume() override;
+
+  SIMPL_FILTER_PARAMETER(FileListInfo_t, InputFileListInfo)
+  Q_PROPERTY(FileListInfo_t InputFileListInfo READ getInputFileListInfo WRITE setInputFileListInfo)
+
+  SIMPL_FILTER_PARAMETER(float, SliceSpacing)
+  Q_PROPERTY(float SliceSpacing READ getSliceSpacing WRITE setSliceSpacing)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, DataContainerName)
+  Q_PROPERTY(DataArrayPath DataContainerName READ getDataContainerName WRITE setDataContainerName)
+
+  SIMPL_FILTER_PARAMETER(QString, CellEnsembleAttributeMatrixName)
+  Q_PROPERTY(QString CellEnsembleAttributeMatrixName READ getCellEnsembleAttributeMatrixName WRITE setCellEnsembleAttributeMatrixName)
+
+  SIMPL_FILTER_PARAMETER(QString, CellAttributeMatrixName)
+  Q_PROPERTY(QString CellAttributeMatrixName READ getCellAttributeMatrixName WRITE setCellAttributeMatrixName)
+
+  SIMPL_INSTANCE_STRING_PROPERTY(MaterialNameArrayName)
+  SIMPL_INSTANCE_PROPERTY(QString, CellEulerAnglesArrayName)
+  SIMPL_INSTANCE_PROPERTY(QString, CellPhasesArrayName)
+  SIMPL_INSTANCE_PROPERTY(QString, ConfidenceArrayName)
+  SIMPL_INSTANCE_PROPERTY(QString, CrystalStructuresArrayName)
+  SIMPL_INSTANCE_PROPERTY(QString, LatticeConstantsArrayName)
+
+  /**
+   * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+   */
+  const QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+   */
+  const QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  const QString getFilterVersion() const override;
+
+  /**
+   * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+   */
+  AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+  /**
+   * @brief getGroupName Reimplemented from @see AbstractFilter class
+   */
+  const QString getGroupName() const override;
+
+  /**
+   * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+   */
+  const QString getSubGroupName() const override;
+
+  /**
+   * @brief getUuid Return the unique identifier for this filter.
+   * @return A QUuid object.
+   */
+  const QUuid getUuid() override;
+
+  /**
+   * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+   */
+  const QString getHumanLabel() const override;
+
+  /**
+   * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void setupFilterParameters() override;
+
+  /**
+   * @brief readFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
+
+  /**
+   * @brief execute Reimplemented from @see AbstractFilter class
+   */
+  void execute() override;
+
+  /**
+  * @brief preflight Reimplemented from @see AbstractFilter class
+  */
+  void preflight() override;
+
+  /* The file name, time stamp and grid bounds of every slice that has been read, so that
+   * preflights only read the files that were added or changed since */
+  SIMPL_PIMPL_PROPERTY_DECL(QVector<QString>, InputFile_Cache)
+  SIMPL_PIMPL_PROPERTY_DECL(QVector<QDateTime>, TimeStamp_Cache)
+  SIMPL_PIMPL_PROPERTY_DECL(std::vector<MicReader::MicSlice>, SliceBounds_Cache)
+
+public slots:
+  void flushCache();
+
+signals:
+  /**
+   * @brief updateFilterParameters Emitted when the Filter requests all the latest Filter parameters
+   * be pushed from a user-facing control (such as a widget)
+   * @param filter Filter instance pointer
+   */
+  void updateFilterParameters(AbstractFilter* filter);
+
+  /**
+   * @brief parametersChanged Emitted when any Filter parameter is changed internally
+   */
+  void parametersChanged();
+
+  /**
+   * @brief preflightAboutToExecute Emitted just before calling dataCheck()
+   */
+  void preflightAboutToExecute();
+
+  /**
+   * @brief preflightExecuted Emitted just after calling dataCheck()
+   */
+  void preflightExecuted();
+
+protected:
+  ReadMicVolume();
+
+  /**
+   * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
+   */
+  void dataCheck();
+
+  /**
+   * @brief Initializes all the private instance variables.
+   */
+  void initialize();
+
+  /**
+   * @brief generateFileList Returns the .mic files of the slices, in z order
+   */
+  QVector<QString> generateFileList();
+
+  /**
+   * @brief updateSliceCache Brings the cached grid bounds of the slices up to date, reading the bounds
+   * of the files that are not cached or have changed since they were cached
+   * @param fileList The .mic files of the slices
+   * @return Zero/Positive on Success - Negative on error.
+   */
+  int updateSliceCache(const QVector<QString>& fileList);
+
+  /**
+   * @brief findVolumeGrid Determines the grid that covers all slices from the cached slice bounds
+   * @param dims Receives the dimensions of the volume
+   * @param xMin Receives the x coordinate of the first grid point, in mm
+   * @param yMin Receives the y coordinate of the first grid point, in mm
+   * @param edgeLength Receives the common edge length of the slices, in mm
+   * @return Zero/Positive on Success - Negative on error.
+   */
+  int findVolumeGrid(SizeVec3Type& dims, float& xMin, float& yMin, float& edgeLength);
+
+  /**
+   * @brief This method reads the values for the phase type, crystal structure
+   * and lattice constants from the .dat file that goes with the first slice.
+   * @param fileName The .mic file of the first slice
+   * @return Zero/Positive on Success - Negative on error.
+   */
+  int loadMaterialInfo(const QString& fileName);
+
+private:
+  QScopedPointer<ReadMicVolumePrivate> const d_ptr;
+
+  DEFINE_DATAARRAY_VARIABLE(float, CellEulerAngles)
+  DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
+  DEFINE_DATAARRAY_VARIABLE(float, Confidence)
+  DEFINE_DATAARRAY_VARIABLE(uint32_t, CrystalStructures)
+  DEFINE_DATAARRAY_VARIABLE(float, LatticeConstants)
+
+public:
+  ReadMicVolume(const ReadMicVolume&) = delete;            // Copy Constructor Not Implemented
+  ReadMicVolume(ReadMicVolume&&) = delete;                 // Move Constructor Not Implemented
+  ReadMicVolume& operator=(const ReadMicVolume&) = delete; // Copy Assignment Not Implemented
+  ReadMicVolume& operator=(ReadMicVolume&&) = delete;      // Move Assignment Not Implemented
+};
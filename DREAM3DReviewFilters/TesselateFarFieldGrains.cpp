@@ -37,10 +37,14 @@
 #include "TesselateFarFieldGrains.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <queue>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range3d.h>
+#include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
@@ -52,6 +56,7 @@
 #include "SIMPLib/DataArrays/NeighborList.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -91,169 +96,240 @@ enum createdPathID : RenameDataPath::DataID_t
 //// Macro to determine if we are going to show the Debugging Output files
 #define PPP_SHOW_DEBUG_OUTPUTS 0
 
+namespace
+{
 /**
- * @brief
+ * @brief The EllipsoidShape struct holds the placement of one feature's ellipsoid, computed before the
+ * voxels are assigned
+ */
+struct EllipsoidShape
+{
+  float center[3];
+  float invRadii[3];
+  float gaT[3][3];
+  int64_t minIndex[3];
+  int64_t maxIndex[3];
+};
+
+/**
+ * @brief The AssignVoxelsImpl class assigns the voxels inside the ellipsoids of a range of features. A voxel
+ * covered by several ellipsoids goes to the ellipsoid it lies deepest inside, with ties going to the lowest
+ * feature Id, which is the result of assigning the features one after the other. To get that result for
+ * any order of the features, each claim on a voxel is packed into a key whose high bits hold the inside
+ * value and whose low bits hold the complement of the feature Id, and the largest key is kept with an
+ * atomic compare-exchange.
  */
 class AssignVoxelsImpl
 {
+  AbstractFilter* m_Filter;
   int64_t dims[3];
-  float Invradcur[3];
   float res[3];
-  float xc;
-  float yc;
-  float zc;
-  ShapeOps::Pointer m_EllipsoidOps;
-  float ga[3][3];
-  int curFeature;
-  Int32ArrayType::Pointer newownersPtr;
-  FloatArrayType::Pointer ellipfuncsPtr;
+  const std::vector<EllipsoidShape>& m_Shapes;
+  ShapeOps* m_EllipsoidOps;
+  std::atomic<uint64_t>* m_VoxelKeys;
 
 public:
-  AssignVoxelsImpl(int64_t* dimensions, float* resolution, float* radCur, float* xx, ShapeOps::Pointer ellipsoidOps, float gA[3][3], float* size, int cur_feature, Int32ArrayType::Pointer newowners,
-                   FloatArrayType::Pointer ellipfuncs)
-  : m_EllipsoidOps(ellipsoidOps)
-  , curFeature(cur_feature)
+  AssignVoxelsImpl(AbstractFilter* filter, int64_t* dimensions, float* resolution, const std::vector<EllipsoidShape>& shapes, ShapeOps* ellipsoidOps, std::atomic<uint64_t>* voxelKeys)
+  : m_Filter(filter)
+  , m_Shapes(shapes)
+  , m_EllipsoidOps(ellipsoidOps)
+  , m_VoxelKeys(voxelKeys)
   {
     dims[0] = dimensions[0];
     dims[1] = dimensions[1];
     dims[2] = dimensions[2];
-    Invradcur[0] = 1.0 / radCur[0];
-    Invradcur[1] = 1.0 / radCur[1];
-    Invradcur[2] = 1.0 / radCur[2];
 
     res[0] = resolution[0];
     res[1] = resolution[1];
     res[2] = resolution[2];
-
-    xc = xx[0];
-    yc = xx[1];
-    zc = xx[2];
-
-    ga[0][0] = gA[0][0];
-    ga[0][1] = gA[0][1];
-    ga[0][2] = gA[0][2];
-    ga[1][0] = gA[1][0];
-    ga[1][1] = gA[1][1];
-    ga[1][2] = gA[1][2];
-    ga[2][0] = gA[2][0];
-    ga[2][1] = gA[2][1];
-    ga[2][2] = gA[2][2];
-
-    newownersPtr = newowners;
-    ellipfuncsPtr = ellipfuncs;
   }
   virtual ~AssignVoxelsImpl() = default;
 
+  /**
+   * @brief PackKey Packs a claim on a voxel; the inside value must not be negative, so that its bit
+   * pattern orders like the value. A key of 0 means the voxel is unclaimed.
+   */
+  static uint64_t PackKey(float inside, int64_t feature)
+  {
+    // adding 0 turns -0 into +0
+    inside += 0.0f;
+    uint32_t insideBits = 0;
+    std::memcpy(&insideBits, &inside, sizeof(insideBits));
+    return (static_cast<uint64_t>(insideBits) << 32) | static_cast<uint64_t>(0xFFFFFFFFU - static_cast<uint32_t>(feature));
+  }
+
+  static int32_t UnpackFeature(uint64_t key)
+  {
+    return static_cast<int32_t>(0xFFFFFFFFU - static_cast<uint32_t>(key & 0xFFFFFFFFULL));
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
-  void convert(int zStart, int zEnd, int yStart, int yEnd, int xStart, int xEnd) const
+  void convert(size_t start, size_t end) const
   {
-
-    int column = 0;
-    int row = 0;
-    int plane = 0;
-    int index = 0;
-    float gaCopy[3][3];
-    float gaT[3][3];
     float coords[3] = {0.0f, 0.0f, 0.0f};
-    float inside = 0.0f;
-    //   float dist = 0.0f;
-    //   float radcur1squared = 1.0/(Invradcur[0]*Invradcur[0]);
     float coordsRotated[3] = {0.0f, 0.0f, 0.0f};
-    int32_t* newowners = newownersPtr->getPointer(0);
-    float* ellipfuncs = ellipfuncsPtr->getPointer(0);
+    float gaT[3][3];
+    int64_t dim0_dim_1 = dims[0] * dims[1];
 
-    // making a copy because the transpose function used later can't deal with the const nature of ga
-    for(int i = 0; i < 3; i++)
+    for(size_t feature = start; feature < end; feature++)
     {
-      for(int j = 0; j < 3; j++)
+      if(m_Filter->getCancel())
       {
-        gaCopy[i][j] = ga[i][j];
+        return;
       }
-    }
 
-    int64_t dim0_dim_1 = dims[0] * dims[1];
-    for(int64_t iter1 = xStart; iter1 < xEnd; iter1++)
-    {
-      column = iter1;
-      if(iter1 < 0)
+      const EllipsoidShape& shape = m_Shapes[feature];
+      std::copy(&shape.gaT[0][0], &shape.gaT[0][0] + 9, &gaT[0][0]);
+      for(int64_t plane = shape.minIndex[2]; plane <= shape.maxIndex[2]; plane++)
       {
-        column = iter1 + dims[0];
-      }
-      else if(iter1 > dims[0] - 1)
-      {
-        column = iter1 - dims[0];
+        for(int64_t row = shape.minIndex[1]; row <= shape.maxIndex[1]; row++)
+        {
+          int64_t rowIndex = plane * dim0_dim_1 + row * dims[0];
+          for(int64_t column = shape.minIndex[0]; column <= shape.maxIndex[0]; column++)
+          {
+            coords[0] = float(column) * res[0] - shape.center[0];
+            coords[1] = float(row) * res[1] - shape.center[1];
+            coords[2] = float(plane) * res[2] - shape.center[2];
+            MatrixMath::Multiply3x3with3x1(gaT, coords, coordsRotated);
+            float inside = m_EllipsoidOps->inside(coordsRotated[0] * shape.invRadii[0], coordsRotated[1] * shape.invRadii[1], coordsRotated[2] * shape.invRadii[2]);
+            if(!(inside >= 0.0f))
+            {
+              continue;
+            }
+
+            uint64_t key = PackKey(inside, static_cast<int64_t>(feature));
+            std::atomic<uint64_t>& voxelKey = m_VoxelKeys[rowIndex + column];
+            uint64_t current = voxelKey.load(std::memory_order_relaxed);
+            while(key > current && !voxelKey.compare_exchange_weak(current, key, std::memory_order_relaxed))
+            {
+            }
+          }
+        }
       }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+};
 
-      for(int64_t iter2 = yStart; iter2 < yEnd; iter2++)
+/**
+ * @brief FaceNeighbors Collects the face neighbors of a voxel that lie inside the volume, in the order
+ * -z, -y, -x, +x, +y, +z
+ * @return Number of neighbors found
+ */
+int32_t FaceNeighbors(int64_t index, const int64_t dims[3], int64_t neighbors[6])
+{
+  int64_t sliceSize = dims[0] * dims[1];
+  int64_t plane = index / sliceSize;
+  int64_t row = (index % sliceSize) / dims[0];
+  int64_t column = index % dims[0];
+  int32_t count = 0;
+  if(plane > 0)
+  {
+    neighbors[count++] = index - sliceSize;
+  }
+  if(row > 0)
+  {
+    neighbors[count++] = index - dims[0];
+  }
+  if(column > 0)
+  {
+    neighbors[count++] = index - 1;
+  }
+  if(column < dims[0] - 1)
+  {
+    neighbors[count++] = index + 1;
+  }
+  if(row < dims[1] - 1)
+  {
+    neighbors[count++] = index + dims[0];
+  }
+  if(plane < dims[2] - 1)
+  {
+    neighbors[count++] = index + sliceSize;
+  }
+  return count;
+}
+
+/**
+ * @brief The FillGapsImpl class picks the new owner of each voxel of the gap frontier: the feature held by
+ * most of its face neighbors, with ties going to the feature that reached the winning count first. The
+ * owners are written to a separate buffer, so all voxels of a cycle see the same Feature Ids.
+ */
+class FillGapsImpl
+{
+  const int32_t* m_FeatureIds;
+  int64_t m_Dims[3];
+  const std::vector<int64_t>& m_Frontier;
+  std::vector<int32_t>& m_NewIds;
+
+public:
+  FillGapsImpl(const int32_t* featureIds, const int64_t dims[3], const std::vector<int64_t>& frontier, std::vector<int32_t>& newIds)
+  : m_FeatureIds(featureIds)
+  , m_Frontier(frontier)
+  , m_NewIds(newIds)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~FillGapsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    int64_t neighbors[6];
+    int32_t features[6];
+    int32_t counts[6];
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t numNeighbors = FaceNeighbors(m_Frontier[i], m_Dims, neighbors);
+      int32_t numFeatures = 0;
+      int32_t most = 0;
+      int32_t owner = 0;
+      for(int32_t j = 0; j < numNeighbors; j++)
       {
-        row = iter2;
-        if(iter2 < 0)
+        int32_t feature = m_FeatureIds[neighbors[j]];
+        if(feature <= 0)
         {
-          row = iter2 + dims[1];
+          continue;
         }
-        else if(iter2 > dims[1] - 1)
+        int32_t k = 0;
+        while(k < numFeatures && features[k] != feature)
         {
-          row = iter2 - dims[1];
+          k++;
         }
-        size_t row_dim = row * dims[0];
-
-        for(int64_t iter3 = zStart; iter3 < zEnd; iter3++)
+        if(k == numFeatures)
         {
-          plane = iter3;
-          if(iter3 < 0)
-          {
-            plane = iter3 + dims[2];
-          }
-          else if(iter3 > dims[2] - 1)
-          {
-            plane = iter3 - dims[2];
-          }
-
-          index = static_cast<int>((plane * dim0_dim_1) + (row_dim) + column);
-
-          inside = -1;
-          coords[0] = float(iter1) * res[0];
-          coords[1] = float(iter2) * res[1];
-          coords[2] = float(iter3) * res[2];
-
-          coords[0] = coords[0] - xc;
-          coords[1] = coords[1] - yc;
-          coords[2] = coords[2] - zc;
-          MatrixMath::Transpose3x3(gaCopy, gaT);
-          MatrixMath::Multiply3x3with3x1(gaT, coords, coordsRotated);
-          float axis1comp = coordsRotated[0] * Invradcur[0];
-          float axis2comp = coordsRotated[1] * Invradcur[1];
-          float axis3comp = coordsRotated[2] * Invradcur[2];
-          inside = m_EllipsoidOps->inside(axis1comp, axis2comp, axis3comp);
-          // if (inside >= 0 && newowners[index] > 0)
-          if(inside >= 0 && newowners[index] > 0 && inside > ellipfuncs[index])
-          {
-            newowners[index] = curFeature;
-            ellipfuncs[index] = inside;
-            // newowners[index] = -2;
-            // ellipfuncs[index] = inside;
-          }
-          else if(inside >= 0 && newowners[index] == -1)
-          {
-            newowners[index] = curFeature;
-            ellipfuncs[index] = inside;
-          }
+          features[k] = feature;
+          counts[k] = 0;
+          numFeatures++;
+        }
+        counts[k]++;
+        if(counts[k] > most)
+        {
+          most = counts[k];
+          owner = feature;
         }
       }
+      m_NewIds[i] = owner;
     }
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range3d<int, int, int>& r) const
+  void operator()(const tbb::blocked_range<size_t>& r) const
   {
-    convert(r.pages().begin(), r.pages().end(), r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
+    compute(r.begin(), r.end());
   }
 #endif
-
-private:
 };
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -276,6 +352,7 @@ TesselateFarFieldGrains::TesselateFarFieldGrains()
 , m_EquivalentDiametersArrayName(SIMPL::FeatureData::EquivalentDiameters)
 , m_CrystalStructuresArrayName(SIMPL::EnsembleData::CrystalStructures)
 , m_MaskArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
+, m_GapFillMethod(0)
 {
   m_EllipsoidOps = EllipsoidOps::New();
 
@@ -307,6 +384,17 @@ void TesselateFarFieldGrains::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(SIMPL_NEW_FILELISTINFO_FP("Feature Input File List", FeatureInputFileListInfo, FilterParameter::Parameter, TesselateFarFieldGrains));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Gap Fill Method");
+    parameter->setPropertyName("GapFillMethod");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(TesselateFarFieldGrains, this, GapFillMethod));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(TesselateFarFieldGrains, this, GapFillMethod));
+    QVector<QString> choices = {"Majority Of Neighbors", "Nearest Feature"};
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
 
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -361,6 +449,7 @@ void TesselateFarFieldGrains::readFilterParameters(AbstractFilterParametersReade
   setElasticStrainsArrayName(reader->readString("ElasticStrainsArrayName", getElasticStrainsArrayName()));
   setCrystalStructuresArrayName(reader->readString("CrystalStructuresArrayName", getCrystalStructuresArrayName()));
   setMaskArrayPath(reader->readDataArrayPath("MaskArrayPath", getMaskArrayPath()));
+  setGapFillMethod(reader->readValue("GapFillMethod", getGapFillMethod()));
   reader->closeFilterGroup();
 }
 
@@ -433,7 +522,6 @@ void TesselateFarFieldGrains::updateEnsembleInstancePointers()
 // -----------------------------------------------------------------------------
 void TesselateFarFieldGrains::initialize()
 {
-  m_Neighbors = nullptr;
   m_BoundaryCells = nullptr;
 
   m_RandomSeed = QDateTime::currentMSecsSinceEpoch();
@@ -455,6 +543,12 @@ void TesselateFarFieldGrains::dataCheck()
   clearWarningCode();
   // This is for convenience
 
+  if(getGapFillMethod() < 0 || getGapFillMethod() > 1)
+  {
+    QString ss = QObject::tr("The selected gap fill method is not valid");
+    setErrorCondition(-12, ss);
+  }
+
   // Make sure we have our input DataContainer with the proper Ensemble data
   DataContainer::Pointer m = getDataContainerArray()->getPrereqDataContainer(this, getOutputCellAttributeMatrixName().getDataContainerName(), false);
   if(getErrorCode() < 0 || nullptr == m.get())
@@ -673,7 +767,14 @@ void TesselateFarFieldGrains::execute()
   }
 
   notifyStatusMessage("Assigning Gaps");
-  assign_gaps_only();
+  if(getGapFillMethod() == 1)
+  {
+    assign_gaps_by_distance();
+  }
+  else
+  {
+    assign_gaps_only();
+  }
   if(getCancel())
   {
     return;
@@ -915,39 +1016,16 @@ void TesselateFarFieldGrains::assign_voxels()
 
   int64_t column, row, plane;
   float xc, yc, zc;
-  float size[3] = {m_SizeX, m_SizeY, m_SizeZ};
-
-  int64_t xmin, xmax, ymin, ymax, zmin, zmax;
 
   FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
 
-  Int32ArrayType::Pointer newownersPtr = Int32ArrayType::CreateArray(totalPoints, "newowners", true);
-  newownersPtr->initializeWithValue(-1);
-  int32_t* newowners = newownersPtr->getPointer(0);
-
-  FloatArrayType::Pointer ellipfuncsPtr = FloatArrayType::CreateArray(totalPoints, "ellipfuncs", true);
-  ellipfuncsPtr->initializeWithValue(-1);
-  float* ellipfuncs = ellipfuncsPtr->getPointer(0);
-
-  float featuresPerTime = 0;
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
-  FOrientArrayType om(9, 0.0);
+  // Place the ellipsoid of every feature up front, so that the features can be assigned concurrently
   int64_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
+  std::vector<EllipsoidShape> shapes(totalFeatures);
+  m_EllipsoidOps->init();
+  FOrientArrayType om(9, 0.0);
   for(int64_t i = 1; i < totalFeatures; i++)
   {
-    featuresPerTime++;
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      float rate = featuresPerTime / ((float)(currentMillis - millis)) * 1000.0f;
-
-      QString ss = QObject::tr("Assign Voxels & Gaps|| Features Checked: %1 || Features/Second: %2").arg(i).arg((int)rate);
-      notifyStatusMessage(ss);
-      featuresPerTime = 0;
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
     float volcur = m_Volumes[i];
     float bovera = m_AxisLengths[3 * i + 1];
     float covera = m_AxisLengths[3 * i + 2];
@@ -957,9 +1035,6 @@ void TesselateFarFieldGrains::assign_voxels()
     zc = m_Centroids[3 * i + 2];
     float radcur1 = 0.0f;
 
-    // init any values for each of the Shape Ops
-    m_EllipsoidOps->init();
-
     // Create our Argument Map
     QMap<ShapeOps::ArgName, float> shapeArgMap;
     shapeArgMap[ShapeOps::Omega3] = omega3;
@@ -972,70 +1047,64 @@ void TesselateFarFieldGrains::assign_voxels()
     float radcur2 = (radcur1 * bovera);
     float radcur3 = (radcur1 * covera);
     float ga[3][3];
-    FOrientArrayType om(9, 0.0);
     FOrientTransformsType::eu2om(FOrientArrayType(&(m_AxisEulerAngles[3 * i]), 3), om);
     om.toGMatrix(ga);
+
+    EllipsoidShape& shape = shapes[i];
+    shape.center[0] = xc;
+    shape.center[1] = yc;
+    shape.center[2] = zc;
+    shape.invRadii[0] = 1.0 / radcur1;
+    shape.invRadii[1] = 1.0 / radcur2;
+    shape.invRadii[2] = 1.0 / radcur3;
+    MatrixMath::Transpose3x3(ga, shape.gaT);
+
     column = static_cast<int64_t>(xc / spacing[0]);
     row = static_cast<int64_t>(yc / spacing[1]);
     plane = static_cast<int64_t>(zc / spacing[2]);
-    xmin = int(column - ((radcur1 / spacing[0]) + 1));
-    xmax = int(column + ((radcur1 / spacing[0]) + 1));
-    ymin = int(row - ((radcur1 / spacing[1]) + 1));   // <======================
-    ymax = int(row + ((radcur1 / spacing[1]) + 1));   // <======================
-    zmin = int(plane - ((radcur1 / spacing[2]) + 1)); // <======================
-    zmax = int(plane + ((radcur1 / spacing[2]) + 1)); // <======================
-
-    if(xmin < 0)
-    {
-      xmin = 0;
-    }
-    if(xmax > dims[0] - 1)
-    {
-      xmax = dims[0] - 1;
-    }
-    if(ymin < 0)
-    {
-      ymin = 0;
-    }
-    if(ymax > dims[1] - 1)
-    {
-      ymax = dims[1] - 1;
-    }
-    if(zmin < 0)
-    {
-      zmin = 0;
-    }
-    if(zmax > dims[2] - 1)
-    {
-      zmax = dims[2] - 1;
-    }
+    shape.minIndex[0] = std::max<int64_t>(int(column - ((radcur1 / spacing[0]) + 1)), 0);
+    shape.maxIndex[0] = std::min<int64_t>(int(column + ((radcur1 / spacing[0]) + 1)), dims[0] - 1);
+    shape.minIndex[1] = std::max<int64_t>(int(row - ((radcur1 / spacing[1]) + 1)), 0);
+    shape.maxIndex[1] = std::min<int64_t>(int(row + ((radcur1 / spacing[1]) + 1)), dims[1] - 1);
+    shape.minIndex[2] = std::max<int64_t>(int(plane - ((radcur1 / spacing[2]) + 1)), 0);
+    shape.maxIndex[2] = std::min<int64_t>(int(plane + ((radcur1 / spacing[2]) + 1)), dims[2] - 1);
+  }
 
-    float radCur[3] = {radcur1, radcur2, radcur3};
-    float xx[3] = {xc, yc, zc};
+  if(getCancel())
+  {
+    return;
+  }
+
+  QString ss = QObject::tr("Assign Voxels & Gaps|| Features: %1").arg(totalFeatures - 1);
+  notifyStatusMessage(ss);
+
+  std::vector<std::atomic<uint64_t>> voxelKeys(totalPoints);
+  for(auto& voxelKey : voxelKeys)
+  {
+    voxelKey.store(0, std::memory_order_relaxed);
+  }
 
-//#if 0
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel)
-    {
-      tbb::parallel_for(tbb::blocked_range3d<int, int, int>(zmin, zmax + 1, ymin, ymax + 1, xmin, xmax + 1),
-                        AssignVoxelsImpl(dims, spacing.data(), radCur, xx, m_EllipsoidOps, ga, size, i, newownersPtr, ellipfuncsPtr), tbb::auto_partitioner());
-    }
-    else
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, static_cast<size_t>(std::max<int64_t>(totalFeatures, 1))),
+                      AssignVoxelsImpl(this, dims, spacing.data(), shapes, m_EllipsoidOps.get(), voxelKeys.data()), tbb::auto_partitioner());
+  }
+  else
 #endif
-    {
-      AssignVoxelsImpl serial(dims, spacing.data(), radCur, xx, m_EllipsoidOps, ga, size, i, newownersPtr, ellipfuncsPtr);
-      serial.convert(zmin, zmax + 1, ymin, ymax + 1, xmin, xmax + 1);
-    }
+  {
+    AssignVoxelsImpl serial(this, dims, spacing.data(), shapes, m_EllipsoidOps.get(), voxelKeys.data());
+    serial.convert(1, static_cast<size_t>(std::max<int64_t>(totalFeatures, 1)));
   }
 
   QVector<bool> activeObjects(totalFeatures, false);
   int gnum;
   for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
   {
-    //    if(ellipfuncs[i] >= 0) { m_FeatureIds[i] = newowners[i]; }
-    if(ellipfuncs[i] >= 0 && m_Mask[i])
+    uint64_t key = voxelKeys[i].load(std::memory_order_relaxed);
+    if(key != 0 && m_Mask[i])
     {
-      m_FeatureIds[i] = newowners[i];
+      m_FeatureIds[i] = AssignVoxelsImpl::UnpackFeature(key);
     }
     if(!m_Mask[i])
     {
@@ -1046,8 +1115,6 @@ void TesselateFarFieldGrains::assign_voxels()
     {
       activeObjects[gnum] = true;
     }
-    newowners[i] = -1;
-    ellipfuncs[i] = -1.0;
   }
 
   AttributeMatrix::Pointer cellFeatureAttrMat = m->getAttributeMatrix(getOutputCellFeatureAttributeMatrixName());
@@ -1082,158 +1149,193 @@ void TesselateFarFieldGrains::assign_gaps_only()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixName().getDataContainerName());
 
-  int featurename, feature;
-  int current = 0;
-  int most = 0;
-  int count = 1;
-  int fixedCount = 1;
-  int counter = 0;
-  int neighpoint;
-  int good;
-  int neighbor;
-
-  int xPoints = static_cast<int>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int yPoints = static_cast<int>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int zPoints = static_cast<int>(m->getGeometryAs<ImageGeom>()->getZPoints());
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  int64_t dims[3] = {
+      static_cast<int64_t>(udims[0]),
+      static_cast<int64_t>(udims[1]),
+      static_cast<int64_t>(udims[2]),
+  };
   size_t totalPoints = m->getAttributeMatrix(m_OutputCellAttributeMatrixName.getAttributeMatrixName())->getNumberOfTuples();
-  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
-
-  int neighpoints[6];
-  neighpoints[0] = -xPoints * yPoints;
-  neighpoints[1] = -xPoints;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(m->getGeometryAs<ImageGeom>()->getNumberOfElements(), "Neighbors", true);
-  neighborsPtr->initializeWithValue(-1);
-  m_Neighbors = neighborsPtr->getPointer(0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  QVector<int> n(totalFeatures + 1, 0);
-  // uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  // uint64_t currentMillis = millis;
+  // Only the unassigned voxels touching an assigned one can change in a cycle, so each cycle visits this
+  // frontier alone and gathers the next one around the voxels it assigned
+  std::vector<uint8_t> queued(totalPoints, 0);
+  std::vector<int64_t> frontier;
+  int64_t neighbors[6];
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    if(m_FeatureIds[i] >= 0)
+    {
+      continue;
+    }
+    int32_t numNeighbors = FaceNeighbors(static_cast<int64_t>(i), dims, neighbors);
+    for(int32_t j = 0; j < numNeighbors; j++)
+    {
+      if(m_FeatureIds[neighbors[j]] > 0)
+      {
+        frontier.push_back(static_cast<int64_t>(i));
+        queued[i] = 1;
+        break;
+      }
+    }
+  }
 
-  while(count != 0)
+  std::vector<int32_t> newIds;
+  std::vector<int64_t> nextFrontier;
+  int32_t counter = 0;
+  while(!frontier.empty())
   {
+    if(getCancel())
+    {
+      return;
+    }
     counter++;
-    count = 0;
-    fixedCount = 0;
-    int zStride, yStride;
-    for(int i = 0; i < zPoints; i++)
+
+    newIds.resize(frontier.size());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, frontier.size()), FillGapsImpl(m_FeatureIds, dims, frontier, newIds), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      FillGapsImpl serial(m_FeatureIds, dims, frontier, newIds);
+      serial.compute(0, frontier.size());
+    }
+
+    nextFrontier.clear();
+    for(size_t i = 0; i < frontier.size(); i++)
     {
-      zStride = i * xPoints * yPoints;
-      for(int j = 0; j < yPoints; j++)
+      int64_t index = frontier[i];
+      m_FeatureIds[index] = newIds[i];
+      m_CellPhases[index] = m_FeaturePhases[newIds[i]];
+
+      int32_t numNeighbors = FaceNeighbors(index, dims, neighbors);
+      for(int32_t j = 0; j < numNeighbors; j++)
       {
-        yStride = j * xPoints;
-        for(int k = 0; k < xPoints; k++)
+        int64_t neighbor = neighbors[j];
+        if(m_FeatureIds[neighbor] < 0 && queued[neighbor] == 0)
         {
-          featurename = m_FeatureIds[zStride + yStride + k];
-          if(featurename < 0)
-          {
-            count++;
-            current = 0;
-            most = 0;
-            for(int l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[zStride + yStride + k] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
+          nextFrontier.push_back(neighbor);
+          queued[neighbor] = 1;
         }
       }
     }
-    for(size_t j = 0; j < totalPoints; j++)
+    frontier.swap(nextFrontier);
+
+    QString ss = QObject::tr("Assign Gaps|| Cycle#: %1 || Frontier Voxel Count: %2").arg(counter).arg(frontier.size());
+    notifyStatusMessage(ss);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TesselateFarFieldGrains::assign_gaps_by_distance()
+{
+  notifyStatusMessage("Assigning Gaps");
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixName().getDataContainerName());
+
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  int64_t dims[3] = {
+      static_cast<int64_t>(udims[0]),
+      static_cast<int64_t>(udims[1]),
+      static_cast<int64_t>(udims[2]),
+  };
+  FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
+  size_t totalPoints = m->getAttributeMatrix(m_OutputCellAttributeMatrixName.getAttributeMatrixName())->getNumberOfTuples();
+  int64_t sliceSize = dims[0] * dims[1];
+
+  // Each unassigned voxel takes the feature of the nearest assigned voxel. The fill grows out of the assigned
+  // voxels bordering the gaps in order of distance, and every reached voxel keeps the assigned voxel it was
+  // reached from, so the distances are measured to that voxel rather than along the path
+  std::vector<float> distances(totalPoints, std::numeric_limits<float>::max());
+  std::vector<int64_t> sources(totalPoints, -1);
+  using QueueEntry = std::pair<float, int64_t>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+  int64_t neighbors[6];
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    if(m_FeatureIds[i] <= 0)
     {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if(featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
+      continue;
+    }
+    int32_t numNeighbors = FaceNeighbors(static_cast<int64_t>(i), dims, neighbors);
+    for(int32_t j = 0; j < numNeighbors; j++)
+    {
+      if(m_FeatureIds[neighbors[j]] < 0)
       {
-        m_FeatureIds[j] = m_FeatureIds[neighbor];
-        m_CellPhases[j] = m_FeaturePhases[m_FeatureIds[neighbor]];
-        fixedCount++;
+        distances[i] = 0.0f;
+        sources[i] = static_cast<int64_t>(i);
+        queue.push(QueueEntry(0.0f, static_cast<int64_t>(i)));
+        break;
       }
     }
-    if(counter >= 1)
+  }
+
+  size_t settled = 0;
+  while(!queue.empty())
+  {
+    QueueEntry entry = queue.top();
+    queue.pop();
+    int64_t index = entry.second;
+    if(entry.first > distances[index])
+    {
+      continue;
+    }
+
+    settled++;
+    if(settled % 1000000 == 0)
     {
-      QString ss = QObject::tr("Assign Gaps|| Cycle#: %1 || Remaining Unassigned Voxel Count: %2").arg(counter).arg(count);
+      if(getCancel())
+      {
+        return;
+      }
+      QString ss = QObject::tr("Assign Gaps|| Voxels Reached: %1").arg(settled);
       notifyStatusMessage(ss);
     }
+
+    int64_t source = sources[index];
+    int32_t feature = m_FeatureIds[source];
+    float sourceCoords[3] = {static_cast<float>(source % dims[0]) * spacing[0], static_cast<float>((source % sliceSize) / dims[0]) * spacing[1],
+                             static_cast<float>(source / sliceSize) * spacing[2]};
+    int32_t numNeighbors = FaceNeighbors(index, dims, neighbors);
+    for(int32_t j = 0; j < numNeighbors; j++)
+    {
+      int64_t neighbor = neighbors[j];
+      if(m_FeatureIds[neighbor] >= 0)
+      {
+        continue;
+      }
+      float dx = static_cast<float>(neighbor % dims[0]) * spacing[0] - sourceCoords[0];
+      float dy = static_cast<float>((neighbor % sliceSize) / dims[0]) * spacing[1] - sourceCoords[1];
+      float dz = static_cast<float>(neighbor / sliceSize) * spacing[2] - sourceCoords[2];
+      float distance = dx * dx + dy * dy + dz * dz;
+      // equally distant features go to the lowest Feature Id, so the result does not depend on the visiting order
+      if(distance < distances[neighbor] || (distance == distances[neighbor] && feature < m_FeatureIds[sources[neighbor]]))
+      {
+        distances[neighbor] = distance;
+        sources[neighbor] = source;
+        queue.push(QueueEntry(distance, neighbor));
+      }
+    }
+  }
+
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    if(m_FeatureIds[i] < 0 && sources[i] >= 0)
+    {
+      m_FeatureIds[i] = m_FeatureIds[sources[i]];
+      m_CellPhases[i] = m_FeaturePhases[m_FeatureIds[i]];
+    }
   }
 }
 
@@ -82,6 +82,7 @@ class DREAM3DReview_EXPORT TesselateFarFieldGrains : public AbstractFilter
   PYB11_PROPERTY(QString CrystalStructuresArrayName READ getCrystalStructuresArrayName WRITE setCrystalStructuresArrayName)
   PYB11_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
   PYB11_PROPERTY(FileListInfo_t FeatureInputFileListInfo READ getFeatureInputFileListInfo WRITE setFeatureInputFileListInfo)
+  PYB11_PROPERTY(int GapFillMethod READ getGapFillMethod WRITE setGapFillMethod)
 public:
   SIMPL_SHARED_POINTERS(TesselateFarFieldGrains)
   SIMPL_FILTER_NEW_MACRO(TesselateFarFieldGrains)
@@ -144,6 +145,9 @@ public:
   SIMPL_FILTER_PARAMETER(FileListInfo_t, FeatureInputFileListInfo)
   Q_PROPERTY(FileListInfo_t FeatureInputFileListInfo READ getFeatureInputFileListInfo WRITE setFeatureInputFileListInfo)
 
+  SIMPL_FILTER_PARAMETER(int, GapFillMethod)
+  Q_PROPERTY(int GapFillMethod READ getGapFillMethod WRITE setGapFillMethod)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -233,11 +237,10 @@ protected:
   void merge_twins();
   void assign_voxels();
   void assign_gaps_only();
+  void assign_gaps_by_distance();
   void assign_orientations();
 
 private:
-  int32_t* m_Neighbors;
-
   // Cell Data - make sure these are all initialized to nullptr in the constructor
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
   DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
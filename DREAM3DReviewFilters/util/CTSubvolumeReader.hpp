@@ -0,0 +1,312 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Common/SIMPLArray.hpp"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The CTSubvolumeReader class reads a box of voxels out of raw, x-fastest 32 bit float CT data
+ * that may be split over several files holding consecutive blocks of whole z-slices. The x and y axes
+ * of the raw data are reversed with respect to the imported volume, and the box bounds are given in the
+ * imported (flipped) voxel space. Only the parts of the rows that intersect the box are read.
+ *
+ * With a stride larger than 1 along an axis, either the first voxel of every bin of stride voxels is
+ * kept, or all voxels of the bin are averaged. Every output slice is independent of the others, so the
+ * output slices can be distributed over tasks; each task opens its own file handles.
+ */
+class CTSubvolumeReader
+{
+public:
+  enum SliceStatus
+  {
+    Success = 0,
+    OpenFailed = 1,
+    ReadFailed = 2
+  };
+
+  /**
+   * @brief CTSubvolumeReader
+   * @param filter Filter used to check for cancellation
+   * @param fileNames Raw data files, in z order
+   * @param zOffsets First z-slice held by each file
+   * @param volumeDims Dimensions of the complete volume
+   * @param minIndex First voxel of the box, inclusive
+   * @param maxIndex Last voxel of the box, inclusive
+   * @param stride Subsampling stride along each axis
+   * @param average Whether to average the voxels of each bin instead of keeping the first one
+   * @param data Destination array of OutputDimension(...) voxels along each axis
+   * @param sliceStatus Receives a SliceStatus for each output slice
+   */
+  CTSubvolumeReader(AbstractFilter* filter, std::vector<QString>& fileNames, std::vector<size_t>& zOffsets, const size_t volumeDims[3], const size_t minIndex[3], const size_t maxIndex[3],
+                    const size_t stride[3], bool average, float* data, std::vector<int32_t>& sliceStatus)
+  : m_Filter(filter)
+  , m_FileNames(fileNames)
+  , m_ZOffsets(zOffsets)
+  , m_Average(average)
+  , m_Data(data)
+  , m_SliceStatus(sliceStatus)
+  {
+    for(size_t i = 0; i < 3; i++)
+    {
+      m_VolumeDims[i] = volumeDims[i];
+      m_MinIndex[i] = minIndex[i];
+      m_MaxIndex[i] = maxIndex[i];
+      m_Stride[i] = stride[i];
+      m_OutputDims[i] = OutputDimension(minIndex[i], maxIndex[i], stride[i]);
+    }
+  }
+  virtual ~CTSubvolumeReader() = default;
+
+  /**
+   * @brief OutputDimension Returns the number of voxels imported along an axis
+   */
+  static size_t OutputDimension(size_t minIndex, size_t maxIndex, size_t stride)
+  {
+    return (maxIndex - minIndex) / stride + 1;
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    std::vector<std::unique_ptr<QFile>> files(m_FileNames.size());
+
+    // the raw rows run in reverse x, so the box covers raw columns [rowStart, rowStart + rowLength)
+    size_t rowStart = m_VolumeDims[0] - 1 - m_MaxIndex[0];
+    size_t rowLength = m_MaxIndex[0] - m_MinIndex[0] + 1;
+    qint64 rowBytes = static_cast<qint64>(rowLength * sizeof(float));
+    std::vector<float> row(rowLength);
+
+    size_t outSliceSize = m_OutputDims[0] * m_OutputDims[1];
+    std::vector<double> sums;
+    std::vector<size_t> counts;
+
+    for(size_t oz = start; oz < end; oz++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+
+      float* outSlice = m_Data + oz * outSliceSize;
+      if(m_Average)
+      {
+        sums.assign(outSliceSize, 0.0);
+        counts.assign(outSliceSize, 0);
+      }
+
+      int32_t status = Success;
+      size_t zBegin = m_MinIndex[2] + oz * m_Stride[2];
+      size_t zEnd = m_Average ? std::min(zBegin + m_Stride[2] - 1, m_MaxIndex[2]) : zBegin;
+      for(size_t z = zBegin; z <= zEnd && status == Success; z++)
+      {
+        size_t fileIndex = static_cast<size_t>(std::upper_bound(m_ZOffsets.begin(), m_ZOffsets.end(), z) - m_ZOffsets.begin()) - 1;
+        if(nullptr == files[fileIndex])
+        {
+          files[fileIndex] = std::unique_ptr<QFile>(new QFile(m_FileNames[fileIndex]));
+          if(!files[fileIndex]->open(QIODevice::ReadOnly))
+          {
+            status = OpenFailed;
+            break;
+          }
+        }
+        QFile& file = *files[fileIndex];
+        size_t localZ = z - m_ZOffsets[fileIndex];
+
+        for(size_t oy = 0; oy < m_OutputDims[1] && status == Success; oy++)
+        {
+          size_t yBegin = m_MinIndex[1] + oy * m_Stride[1];
+          size_t yEnd = m_Average ? std::min(yBegin + m_Stride[1] - 1, m_MaxIndex[1]) : yBegin;
+          for(size_t y = yBegin; y <= yEnd; y++)
+          {
+            size_t rawY = m_VolumeDims[1] - 1 - y;
+            qint64 offset = static_cast<qint64>(((localZ * m_VolumeDims[1] + rawY) * m_VolumeDims[0] + rowStart) * sizeof(float));
+            if(!file.seek(offset) || file.read(reinterpret_cast<char*>(row.data()), rowBytes) != rowBytes)
+            {
+              status = ReadFailed;
+              break;
+            }
+
+            // raw column rowStart + k holds voxel x = maxIndex - k
+            if(m_Average)
+            {
+              double* sumRow = sums.data() + oy * m_OutputDims[0];
+              size_t* countRow = counts.data() + oy * m_OutputDims[0];
+              for(size_t k = 0; k < rowLength; k++)
+              {
+                size_t ox = (m_MaxIndex[0] - k - m_MinIndex[0]) / m_Stride[0];
+                sumRow[ox] += row[k];
+                countRow[ox]++;
+              }
+            }
+            else
+            {
+              float* outRow = outSlice + oy * m_OutputDims[0];
+              for(size_t ox = 0; ox < m_OutputDims[0]; ox++)
+              {
+                outRow[ox] = row[m_MaxIndex[0] - (m_MinIndex[0] + ox * m_Stride[0])];
+              }
+            }
+          }
+        }
+      }
+
+      if(m_Average && status == Success)
+      {
+        for(size_t i = 0; i < outSliceSize; i++)
+        {
+          outSlice[i] = static_cast<float>(sums[i] / static_cast<double>(counts[i]));
+        }
+      }
+      m_SliceStatus[oz] = status;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AbstractFilter* m_Filter;
+  std::vector<QString>& m_FileNames;
+  std::vector<size_t>& m_ZOffsets;
+  size_t m_VolumeDims[3];
+  size_t m_MinIndex[3];
+  size_t m_MaxIndex[3];
+  size_t m_Stride[3];
+  size_t m_OutputDims[3];
+  bool m_Average;
+  float* m_Data;
+  std::vector<int32_t>& m_SliceStatus;
+};
+
+/**
+ * @brief ApplyCTSubvolume Validates the subvolume bounds and stride against the dimensions of the geometry
+ * and updates its dimensions, spacing and origin to the imported subvolume
+ * @param filter Filter that receives the error condition
+ * @param image Geometry holding the complete volume
+ * @param minIndex First voxel of the subvolume, inclusive
+ * @param maxIndex Last voxel of the subvolume, inclusive
+ * @param stride Subsampling stride along each axis
+ * @return Integer error code
+ */
+inline int32_t ApplyCTSubvolume(AbstractFilter* filter, const ImageGeom::Pointer& image, const IntVec3Type& minIndex, const IntVec3Type& maxIndex, const IntVec3Type& stride)
+{
+  SizeVec3Type volumeDims = image->getDimensions();
+  FloatVec3Type spacing = image->getSpacing();
+  FloatVec3Type origin = image->getOrigin();
+  size_t subvolumeDims[3] = {0, 0, 0};
+
+  for(size_t i = 0; i < 3; i++)
+  {
+    if(minIndex[i] < 0 || minIndex[i] > maxIndex[i] || static_cast<size_t>(maxIndex[i]) >= volumeDims[i])
+    {
+      QString ss = QObject::tr("The subvolume bounds (%1, %2) along axis %3 must satisfy 0 <= minimum <= maximum < %4").arg(minIndex[i]).arg(maxIndex[i]).arg(i).arg(volumeDims[i]);
+      filter->setErrorCondition(-389, ss);
+      return filter->getErrorCode();
+    }
+    if(stride[i] < 1)
+    {
+      QString ss = QObject::tr("The subvolume stride along axis %1 must be at least 1").arg(i);
+      filter->setErrorCondition(-390, ss);
+      return filter->getErrorCode();
+    }
+    subvolumeDims[i] = CTSubvolumeReader::OutputDimension(static_cast<size_t>(minIndex[i]), static_cast<size_t>(maxIndex[i]), static_cast<size_t>(stride[i]));
+    origin[i] += minIndex[i] * spacing[i];
+    spacing[i] *= stride[i];
+  }
+
+  image->setDimensions(subvolumeDims);
+  image->setSpacing(spacing);
+  image->setOrigin(origin);
+
+  return 0;
+}
+
+/**
+ * @brief ReadCTSubvolume Reads the subvolume that ApplyCTSubvolume selected out of the raw binary CT files,
+ * distributing the output slices over tasks
+ * @param filter Filter that receives progress, cancellation and error conditions
+ * @param fileNames Raw data files, in z order
+ * @param zOffsets First z-slice held by each file
+ * @param volumeDims Dimensions of the complete volume
+ * @param minIndex First voxel of the subvolume, inclusive
+ * @param maxIndex Last voxel of the subvolume, inclusive
+ * @param stride Subsampling stride along each axis
+ * @param average Whether to average the voxels of each bin instead of keeping the first one
+ * @param data Destination array
+ * @param dims Dimensions of the imported subvolume
+ * @return Integer error code
+ */
+inline int32_t ReadCTSubvolume(AbstractFilter* filter, std::vector<QString>& fileNames, std::vector<size_t>& zOffsets, const SizeVec3Type& volumeDims, const IntVec3Type& minIndex,
+                               const IntVec3Type& maxIndex, const IntVec3Type& stride, bool average, float* data, const size_t dims[3])
+{
+  size_t volume[3] = {volumeDims[0], volumeDims[1], volumeDims[2]};
+  size_t first[3] = {0, 0, 0};
+  size_t last[3] = {0, 0, 0};
+  size_t step[3] = {1, 1, 1};
+  for(size_t i = 0; i < 3; i++)
+  {
+    first[i] = static_cast<size_t>(minIndex[i]);
+    last[i] = static_cast<size_t>(maxIndex[i]);
+    step[i] = static_cast<size_t>(stride[i]);
+  }
+
+  filter->notifyStatusMessage(QObject::tr("Reading Data || Subvolume of %1 x %2 x %3 voxels").arg(dims[0]).arg(dims[1]).arg(dims[2]));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  std::vector<int32_t> sliceStatus(dims[2], CTSubvolumeReader::Success);
+
+  CTSubvolumeReader subvolumeReader(filter, fileNames, zOffsets, volume, first, last, step, average, data, sliceStatus);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, dims[2]), subvolumeReader, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    subvolumeReader.compute(0, dims[2]);
+  }
+
+  if(filter->getCancel())
+  {
+    return 0;
+  }
+
+  for(size_t z = 0; z < dims[2]; z++)
+  {
+    if(sliceStatus[z] != CTSubvolumeReader::Success)
+    {
+      QString ss = QObject::tr("Error reading slice %1 of the subvolume from the binary input file").arg(z);
+      filter->setErrorCondition(-100, ss);
+      return filter->getErrorCode();
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief The DislocationLengthTracer class distributes the length of dislocation segments over the cells of
+ * an image grid with a spacing of half the averaging cell size. Cell (l, k, j) collects the length that falls
+ * inside a box of one averaging cell size centered on it, so the boxes of neighboring cells overlap.
+ *
+ * Each box is the union of 2x2x2 sub-cells of a grid staggered by half a spacing, so a segment is walked
+ * through the staggered grid with a 3D-DDA (Amanatides & Woo) that only visits the sub-cells it crosses, and
+ * the length in each sub-cell is handed to the (up to 8) cells whose boxes contain it.
+ */
+class DislocationLengthTracer
+{
+public:
+  /**
+   * @brief DislocationLengthTracer
+   * @param origin Origin of the image grid
+   * @param spacing Spacing of the image grid (half the averaging cell size)
+   * @param dims Dimensions of the image grid
+   */
+  DislocationLengthTracer(const float origin[3], const float spacing[3], const size_t dims[3])
+  {
+    for(size_t i = 0; i < 3; i++)
+    {
+      m_Origin[i] = static_cast<double>(origin[i]) - 0.5 * static_cast<double>(spacing[i]);
+      m_Spacing[i] = static_cast<double>(spacing[i]);
+      m_Dims[i] = static_cast<int64_t>(dims[i]);
+    }
+  }
+  virtual ~DislocationLengthTracer() = default;
+
+  /**
+   * @brief trace Calls func(point, length) with the length of the segment inside the box of each cell it
+   * crosses. A cell may be reported several times for one segment; the lengths add up to the length inside
+   * its box.
+   */
+  template <typename Func>
+  void trace(const float point1[3], const float point2[3], Func&& func) const
+  {
+    // positions are measured in staggered sub-cells, of which there are dims + 1 along each axis
+    double start[3];
+    double delta[3];
+    double tEnter = 0.0;
+    double tExit = 1.0;
+    double length = 0.0;
+    for(size_t i = 0; i < 3; i++)
+    {
+      start[i] = (static_cast<double>(point1[i]) - m_Origin[i]) / m_Spacing[i];
+      delta[i] = (static_cast<double>(point2[i]) - static_cast<double>(point1[i])) / m_Spacing[i];
+      length += delta[i] * delta[i] * m_Spacing[i] * m_Spacing[i];
+
+      double upper = static_cast<double>(m_Dims[i] + 1);
+      if(delta[i] == 0.0)
+      {
+        if(start[i] < 0.0 || start[i] > upper)
+        {
+          return;
+        }
+        continue;
+      }
+      double t0 = -start[i] / delta[i];
+      double t1 = (upper - start[i]) / delta[i];
+      if(t0 > t1)
+      {
+        std::swap(t0, t1);
+      }
+      tEnter = std::max(tEnter, t0);
+      tExit = std::min(tExit, t1);
+    }
+    if(tEnter >= tExit)
+    {
+      return;
+    }
+    length = std::sqrt(length);
+
+    int64_t cell[3];
+    int64_t step[3];
+    double tMax[3];
+    double tDelta[3];
+    for(size_t i = 0; i < 3; i++)
+    {
+      double position = start[i] + tEnter * delta[i];
+      if(delta[i] > 0.0)
+      {
+        cell[i] = static_cast<int64_t>(std::floor(position));
+        step[i] = 1;
+      }
+      else if(delta[i] < 0.0)
+      {
+        // moving down from a sub-cell boundary starts in the sub-cell below it
+        cell[i] = static_cast<int64_t>(std::ceil(position)) - 1;
+        step[i] = -1;
+      }
+      else
+      {
+        cell[i] = static_cast<int64_t>(std::floor(position));
+        step[i] = 0;
+      }
+      cell[i] = std::min(std::max(cell[i], int64_t(0)), m_Dims[i]);
+
+      if(step[i] == 0)
+      {
+        tMax[i] = std::numeric_limits<double>::max();
+        tDelta[i] = std::numeric_limits<double>::max();
+      }
+      else
+      {
+        double boundary = static_cast<double>(step[i] > 0 ? cell[i] + 1 : cell[i]);
+        tMax[i] = (boundary - start[i]) / delta[i];
+        tDelta[i] = 1.0 / std::fabs(delta[i]);
+      }
+    }
+
+    double t = tEnter;
+    while(t < tExit)
+    {
+      size_t axis = 0;
+      if(tMax[1] < tMax[axis])
+      {
+        axis = 1;
+      }
+      if(tMax[2] < tMax[axis])
+      {
+        axis = 2;
+      }
+      double tNext = std::min(tMax[axis], tExit);
+      if(tNext > t)
+      {
+        spread(cell, static_cast<float>((tNext - t) * length), func);
+      }
+      t = tNext;
+
+      cell[axis] += step[axis];
+      tMax[axis] += tDelta[axis];
+      if(cell[axis] < 0 || cell[axis] > m_Dims[axis])
+      {
+        break;
+      }
+    }
+  }
+
+protected:
+  /**
+   * @brief spread Hands the length inside staggered sub-cell (a, b, c) to the cells (a - 1..a, b - 1..b,
+   * c - 1..c) whose boxes contain it
+   */
+  template <typename Func>
+  void spread(const int64_t cell[3], float length, Func&& func) const
+  {
+    for(int64_t j = std::max(cell[2] - 1, int64_t(0)); j <= std::min(cell[2], m_Dims[2] - 1); j++)
+    {
+      for(int64_t k = std::max(cell[1] - 1, int64_t(0)); k <= std::min(cell[1], m_Dims[1] - 1); k++)
+      {
+        size_t rowIndex = static_cast<size_t>((j * m_Dims[1] + k) * m_Dims[0]);
+        for(int64_t l = std::max(cell[0] - 1, int64_t(0)); l <= std::min(cell[0], m_Dims[0] - 1); l++)
+        {
+          func(rowIndex + static_cast<size_t>(l), length);
+        }
+      }
+    }
+  }
+
+private:
+  double m_Origin[3];
+  double m_Spacing[3];
+  int64_t m_Dims[3];
+};
@@ -0,0 +1,290 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include <unsupported/Eigen/FFT>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The PhaseCorrelation class estimates the integer translation between two equally sized 2D scalar
+ * images from the peak of their normalized cross-power spectrum. The transforms are computed with the
+ * header-only Eigen FFT module, so the image dimensions do not need to be powers of two. The estimate seeds
+ * the local search that the adaptive alignment filters refine with their own cost functions.
+ */
+class PhaseCorrelation
+{
+public:
+  SIMPL_SHARED_POINTERS(PhaseCorrelation)
+  SIMPL_TYPE_MACRO(PhaseCorrelation)
+
+  PhaseCorrelation() {}
+  virtual ~PhaseCorrelation() {}
+
+  using ComplexType = std::complex<float>;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief FindShift Determines the shift (shiftX, shiftY) for which cur(x + shiftX, y + shiftY) best matches ref(x, y).
+   * Both images are stored x-fastest with dimensions dimX * dimY.  The returned shift is limited to
+   * |shiftX| <= maxShiftX and |shiftY| <= maxShiftY.
+   * @return false if the images carry no usable signal (e.g. they are constant)
+   */
+  static bool FindShift(const std::vector<float>& ref, const std::vector<float>& cur, size_t dimX, size_t dimY, int64_t maxShiftX, int64_t maxShiftY, int64_t& shiftX, int64_t& shiftY)
+  {
+    shiftX = 0;
+    shiftY = 0;
+    if(dimX < 2 || dimY < 2 || ref.size() < dimX * dimY || cur.size() < dimX * dimY)
+    {
+      return false;
+    }
+
+    std::vector<ComplexType> refSpectrum;
+    std::vector<ComplexType> curSpectrum;
+    Forward2D(ref, dimX, dimY, refSpectrum);
+    Forward2D(cur, dimX, dimY, curSpectrum);
+
+    // normalized cross-power spectrum; the DC term is dropped so constant offsets do not register
+    float epsilon = std::numeric_limits<float>::epsilon();
+    bool hasSignal = false;
+    for(size_t i = 0; i < refSpectrum.size(); i++)
+    {
+      ComplexType cross = curSpectrum[i] * std::conj(refSpectrum[i]);
+      float magnitude = std::abs(cross);
+      if(i == 0 || magnitude <= epsilon)
+      {
+        curSpectrum[i] = ComplexType(0.0f, 0.0f);
+      }
+      else
+      {
+        curSpectrum[i] = cross / magnitude;
+        hasSignal = true;
+      }
+    }
+    if(!hasSignal)
+    {
+      return false;
+    }
+
+    Inverse2D(curSpectrum, dimX, dimY);
+
+    float maxValue = -std::numeric_limits<float>::max();
+    for(size_t y = 0; y < dimY; y++)
+    {
+      int64_t wrappedY = (y > dimY / 2) ? static_cast<int64_t>(y) - static_cast<int64_t>(dimY) : static_cast<int64_t>(y);
+      if(std::llabs(wrappedY) > maxShiftY)
+      {
+        continue;
+      }
+      for(size_t x = 0; x < dimX; x++)
+      {
+        int64_t wrappedX = (x > dimX / 2) ? static_cast<int64_t>(x) - static_cast<int64_t>(dimX) : static_cast<int64_t>(x);
+        if(std::llabs(wrappedX) > maxShiftX)
+        {
+          continue;
+        }
+        float value = curSpectrum[y * dimX + x].real();
+        if(value > maxValue)
+        {
+          maxValue = value;
+          shiftX = wrappedX;
+          shiftY = wrappedY;
+        }
+      }
+    }
+    return true;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief SeedShift Estimates the shift between two sections from feature images of both (e.g. boundary
+   * maps), limited to less than half of each dimension so that the estimate is a valid starting point for
+   * RefineShift. The shift is left at zero if the images carry no usable signal.
+   */
+  static void SeedShift(const std::vector<float>& ref, const std::vector<float>& cur, size_t dimX, size_t dimY, int64_t& shiftX, int64_t& shiftY)
+  {
+    int64_t maxShiftX = static_cast<int64_t>(dimX * 0.5f) - 1;
+    int64_t maxShiftY = static_cast<int64_t>(dimY * 0.5f) - 1;
+    FindShift(ref, cur, dimX, dimY, maxShiftX, maxShiftY, shiftX, shiftY);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief RefineShift Hill climbs from the best stored shift (zero, or the SeedShift estimate) over the
+   * 7 x 7 neighborhood of candidate shifts until the best shift no longer moves. Every candidate with
+   * |shift| < half the dimension is evaluated once with cost(shiftX, shiftY), where a lower cost is a better
+   * match, and the maxStoredShifts best candidates are kept in ascending order of cost.
+   * @param visited dimX x dimY scratch grid, reset here so that it can be reused from slice to slice
+   */
+  template <typename CostFunc>
+  static void RefineShift(size_t dimX, size_t dimY, uint64_t maxStoredShifts, std::vector<std::vector<bool>>& visited, std::vector<int64_t>& shiftsX, std::vector<int64_t>& shiftsY,
+                          std::vector<float>& costs, CostFunc&& cost)
+  {
+    const int64_t halfDimX = static_cast<int64_t>(dimX * 0.5f);
+    const int64_t halfDimY = static_cast<int64_t>(dimY * 0.5f);
+    visited.resize(dimX);
+    for(size_t i = 0; i < dimX; i++)
+    {
+      visited[i].assign(dimY, false);
+    }
+
+    int64_t oldShiftX = 0;
+    int64_t oldShiftY = 0;
+    do
+    {
+      oldShiftX = shiftsX[0];
+      oldShiftY = shiftsY[0];
+
+      for(int64_t j = -3; j <= 3; j++)
+      {
+        for(int64_t k = -3; k <= 3; k++)
+        {
+          int64_t shiftX = k + oldShiftX;
+          int64_t shiftY = j + oldShiftY;
+          if(std::llabs(shiftX) >= halfDimX || std::llabs(shiftY) >= halfDimY || visited[shiftX + halfDimX][shiftY + halfDimY])
+          {
+            continue;
+          }
+          float value = cost(shiftX, shiftY);
+          visited[shiftX + halfDimX][shiftY + halfDimY] = true;
+
+          // compare the new shift with currently stored ones
+          int64_t s = static_cast<int64_t>(maxStoredShifts);
+          while(s - 1 >= 0 && value < costs[s - 1])
+          {
+            s--;
+          }
+
+          // new shift is stored with index 's' in the arrays
+          if(s < static_cast<int64_t>(maxStoredShifts))
+          {
+            // lag the shifts already stored
+            for(int64_t t = maxStoredShifts - 1; t > s; t--)
+            {
+              shiftsX[t] = shiftsX[t - 1];
+              shiftsY[t] = shiftsY[t - 1];
+              costs[t] = costs[t - 1];
+            }
+            // store the new shift
+            shiftsX[s] = shiftX;
+            shiftsY[s] = shiftY;
+            costs[s] = value;
+          }
+        }
+      }
+    } while(shiftsX[0] != oldShiftX || shiftsY[0] != oldShiftY);
+  }
+
+protected:
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief Forward2D Computes the 2D FFT of a real image after removing its mean and applying a Hann
+   * window, which suppresses the spurious correlation caused by the image borders.
+   */
+  static void Forward2D(const std::vector<float>& image, size_t dimX, size_t dimY, std::vector<ComplexType>& spectrum)
+  {
+    double mean = 0.0;
+    for(size_t i = 0; i < dimX * dimY; i++)
+    {
+      mean += image[i];
+    }
+    mean /= static_cast<double>(dimX * dimY);
+
+    std::vector<float> windowX(dimX);
+    std::vector<float> windowY(dimY);
+    for(size_t x = 0; x < dimX; x++)
+    {
+      windowX[x] = 0.5f - 0.5f * std::cos(2.0f * SIMPLib::Constants::k_Pif * x / static_cast<float>(dimX - 1));
+    }
+    for(size_t y = 0; y < dimY; y++)
+    {
+      windowY[y] = 0.5f - 0.5f * std::cos(2.0f * SIMPLib::Constants::k_Pif * y / static_cast<float>(dimY - 1));
+    }
+
+    spectrum.resize(dimX * dimY);
+    for(size_t y = 0; y < dimY; y++)
+    {
+      for(size_t x = 0; x < dimX; x++)
+      {
+        float value = static_cast<float>(image[y * dimX + x] - mean) * windowX[x] * windowY[y];
+        spectrum[y * dimX + x] = ComplexType(value, 0.0f);
+      }
+    }
+
+    Transform2D(spectrum, dimX, dimY, false);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  static void Inverse2D(std::vector<ComplexType>& spectrum, size_t dimX, size_t dimY)
+  {
+    Transform2D(spectrum, dimX, dimY, true);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  static void Transform2D(std::vector<ComplexType>& data, size_t dimX, size_t dimY, bool inverse)
+  {
+    Eigen::FFT<float> fft;
+    std::vector<ComplexType> in;
+    std::vector<ComplexType> out;
+
+    // rows
+    in.resize(dimX);
+    for(size_t y = 0; y < dimY; y++)
+    {
+      std::copy(data.begin() + y * dimX, data.begin() + (y + 1) * dimX, in.begin());
+      if(inverse)
+      {
+        fft.inv(out, in);
+      }
+      else
+      {
+        fft.fwd(out, in);
+      }
+      std::copy(out.begin(), out.end(), data.begin() + y * dimX);
+    }
+
+    // columns
+    in.resize(dimY);
+    for(size_t x = 0; x < dimX; x++)
+    {
+      for(size_t y = 0; y < dimY; y++)
+      {
+        in[y] = data[y * dimX + x];
+      }
+      if(inverse)
+      {
+        fft.inv(out, in);
+      }
+      else
+      {
+        fft.fwd(out, in);
+      }
+      for(size_t y = 0; y < dimY; y++)
+      {
+        data[y * dimX + x] = out[y];
+      }
+    }
+  }
+};
@@ -0,0 +1,203 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The TextParsing class holds locale independent helpers for parsing ASCII files that are held in
+ * memory as a whole, e.g. a memory mapped file. Lines and tokens are scanned in place, without copying them
+ * into strings, and numbers are parsed directly from the characters.
+ */
+class TextParsing
+{
+public:
+  /**
+   * @brief FindLineEnd Returns the position of the next newline at or after pos, or end if there is none
+   */
+  static const char* FindLineEnd(const char* pos, const char* end)
+  {
+    const char* lineEnd = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    return (nullptr != lineEnd) ? lineEnd : end;
+  }
+
+  /**
+   * @brief SkipWhitespace Returns the first position at or after pos that is not a blank, tab or carriage return
+   */
+  static const char* SkipWhitespace(const char* pos, const char* end)
+  {
+    while(pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+    {
+      pos++;
+    }
+    return pos;
+  }
+
+  /**
+   * @brief StartsWith Returns whether the characters starting at pos match prefix
+   */
+  static bool StartsWith(const char* pos, const char* end, const char* prefix)
+  {
+    size_t length = std::strlen(prefix);
+    return static_cast<size_t>(end - pos) >= length && std::memcmp(pos, prefix, length) == 0;
+  }
+
+  /**
+   * @brief LineNumber Returns the 1-based number of the line holding pos
+   */
+  static int32_t LineNumber(const char* data, const char* pos)
+  {
+    return static_cast<int32_t>(std::count(data, pos, '\n')) + 1;
+  }
+
+  /**
+   * @brief ParseFloat Parses a decimal floating point value, with optional sign, fraction and
+   * exponent, starting at pos after any leading whitespace, and advances pos past it
+   * @return false if no number starts at pos
+   */
+  static bool ParseFloat(const char*& pos, const char* end, float& value)
+  {
+    static const double k_Powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char* p = SkipWhitespace(pos, end);
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+      negative = (*p == '-');
+      p++;
+    }
+
+    // up to 19 significant digits fit the mantissa exactly; further digits only shift the exponent
+    uint64_t mantissa = 0;
+    int32_t exponent = 0;
+    int32_t digits = 0;
+    int32_t significant = 0;
+    for(; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+    {
+      if(significant < 19)
+      {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        significant += (mantissa != 0) ? 1 : 0;
+      }
+      else
+      {
+        exponent++;
+      }
+    }
+    if(p < end && *p == '.')
+    {
+      for(p++; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+      {
+        if(significant < 19)
+        {
+          mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+          significant += (mantissa != 0) ? 1 : 0;
+          exponent--;
+        }
+      }
+    }
+    if(digits == 0)
+    {
+      return false;
+    }
+    if(p < end && (*p == 'e' || *p == 'E'))
+    {
+      const char* e = p + 1;
+      bool negativeExponent = false;
+      if(e < end && (*e == '-' || *e == '+'))
+      {
+        negativeExponent = (*e == '-');
+        e++;
+      }
+      if(e < end && *e >= '0' && *e <= '9')
+      {
+        int32_t explicitExponent = 0;
+        for(; e < end && *e >= '0' && *e <= '9'; e++)
+        {
+          explicitExponent = std::min(explicitExponent * 10 + (*e - '0'), 10000);
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        p = e;
+      }
+    }
+
+    double result = static_cast<double>(mantissa);
+    if(mantissa != 0 && exponent != 0)
+    {
+      if(exponent > 0 && exponent <= 22)
+      {
+        result *= k_Powers[exponent];
+      }
+      else if(exponent < 0 && exponent >= -22)
+      {
+        result /= k_Powers[-exponent];
+      }
+      else
+      {
+        result *= std::pow(10.0, static_cast<double>(exponent));
+      }
+    }
+    value = static_cast<float>(negative ? -result : result);
+    pos = p;
+    return true;
+  }
+
+  /**
+   * @brief ParseInteger Parses a decimal integer value, with optional sign, starting at pos after any
+   * leading whitespace, and advances pos past it
+   * @return false if no integer starts at pos or the value overflows int64_t
+   */
+  static bool ParseInteger(const char*& pos, const char* end, int64_t& value)
+  {
+    const char* p = SkipWhitespace(pos, end);
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+      negative = (*p == '-');
+      p++;
+    }
+    const char* digitsStart = p;
+    uint64_t magnitude = 0;
+    for(; p < end && *p >= '0' && *p <= '9'; p++)
+    {
+      if(magnitude > (static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) - static_cast<uint64_t>(*p - '0')) / 10)
+      {
+        return false;
+      }
+      magnitude = magnitude * 10 + static_cast<uint64_t>(*p - '0');
+    }
+    if(p == digitsStart)
+    {
+      return false;
+    }
+    value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+    pos = p;
+    return true;
+  }
+
+  /**
+   * @brief SkipToken Advances pos past any leading whitespace and the following run of non-whitespace characters
+   * @return false if there is no token left before end
+   */
+  static bool SkipToken(const char*& pos, const char* end)
+  {
+    const char* p = SkipWhitespace(pos, end);
+    const char* tokenStart = p;
+    while(p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+    {
+      p++;
+    }
+    pos = p;
+    return p != tokenStart;
+  }
+
+protected:
+  TextParsing() = default;
+};
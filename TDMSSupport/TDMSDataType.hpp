@@ -80,16 +80,16 @@ template <typename T> inline void ReadArrayFromFile(std::ifstream& filestream, I
   // uint32_t b = 0;
 }
 
-inline void ReadStringArrayFromFile(std::ifstream& filestream, IDataArray::Pointer ptr, uint64_t pos, uint64_t bytes)
+inline void ReadStringArrayFromFile(std::ifstream& filestream, IDataArray::Pointer ptr, uint64_t pos, uint64_t numValues)
 {
   StringDataArray::Pointer data = std::dynamic_pointer_cast<StringDataArray>(ptr);
-  std::vector<uint32_t> offsets(bytes + 1, 0);
-  filestream.read(reinterpret_cast<char*>(offsets.data() + 1), bytes * sizeof(uint32_t));
-  for(uint64_t s = 0; s < bytes; s++)
+  std::vector<uint32_t> offsets(numValues + 1, 0);
+  filestream.read(reinterpret_cast<char*>(offsets.data() + 1), numValues * sizeof(uint32_t));
+  for(uint64_t s = 0; s < numValues; s++)
   {
     std::vector<char> string(offsets[s + 1] - offsets[s]);
     filestream.read(string.data(), string.size());
-    data->setValue(s, QString(string.data()));
+    data->setValue(pos + s, QString::fromUtf8(string.data(), static_cast<int>(string.size())));
   }
 }
 
@@ -110,6 +110,13 @@ template <typename T> inline void AllocateArray(IDataArray::Pointer ptr)
   data->initializeWithZeros();
 }
 
+inline DataArray<uint8_t>::Pointer GenerateTimeStampArray(uint64_t numTuples, std::string name)
+{
+  std::vector<size_t> cDims(1, 16);
+  DataArray<uint8_t>::Pointer data = DataArray<uint8_t>::CreateArray(numTuples, cDims, QString::fromStdString(name), false);
+  return data;
+}
+
 inline StringDataArray::Pointer GenerateStringArray(uint64_t numTuples, std::string name)
 {
   StringDataArray::Pointer data = StringDataArray::CreateArray(numTuples, QString::fromStdString(name), false);
@@ -157,6 +164,11 @@ template <typename T> inline std::function<void(std::ifstream&, IDataArray::Poin
   return ReadArrayFromFile<T>;
 }
 
+inline std::function<IDataArray::Pointer(uint64_t, std::string)> TimeStampArrayGeneratorFactory()
+{
+  return GenerateTimeStampArray;
+}
+
 inline std::function<IDataArray::Pointer(uint64_t, std::string)> StringArrayGeneratorFactory()
 {
   return GenerateStringArray;
@@ -228,14 +240,13 @@ public:
     m_ArrayAllocator(ptr);
   }
 
-  void readArrayFromFile(std::ifstream& filestream, IDataArray::Pointer ptr, uint64_t pos, uint64_t numValues)
+  /**
+   * @brief readArrayFromFile Reads numValues values into ptr starting at tuple pos. Fixed size types read the
+   * bytes of raw data directly, while strings are read value by value from their offset table.
+   */
+  void readArrayFromFile(std::ifstream& filestream, IDataArray::Pointer ptr, uint64_t pos, uint64_t numValues, uint64_t bytes)
   {
-    uint64_t bytes = numValues;
-    if(m_Size > 0)
-    {
-      bytes *= m_Size;
-    }
-    m_ArrayReader(filestream, ptr, pos, bytes);
+    m_ArrayReader(filestream, ptr, pos, m_Size > 0 ? bytes : numValues);
   }
 
 private:
@@ -78,7 +78,7 @@ void TDMSDataTypeFactory::initializeDataTypes()
                                         TDMSDataTypeHelpers::StringArrayAllocatorFactory(), TDMSDataTypeHelpers::StringArrayReaderFactory());
   m_DataTypes[0x21] = TDMSDataType::New("tdsTypeBoolean", 1, TDMSDataTypeHelpers::ValueReaderFactory<bool>(), TDMSDataTypeHelpers::ArrayGeneratorFactory<bool>(),
                                         TDMSDataTypeHelpers::ArrayAllocatorFactory<bool>(), TDMSDataTypeHelpers::ArrayReaderFactory<bool>());
-  m_DataTypes[0x44] = TDMSDataType::New("tdsTypeTimeStamp", 16, TDMSDataTypeHelpers::TimeStampReaderFactory(), TDMSDataTypeHelpers::ArrayGeneratorFactory<uint8_t>(),
+  m_DataTypes[0x44] = TDMSDataType::New("tdsTypeTimeStamp", 16, TDMSDataTypeHelpers::TimeStampReaderFactory(), TDMSDataTypeHelpers::TimeStampArrayGeneratorFactory(),
                                         TDMSDataTypeHelpers::ArrayAllocatorFactory<uint8_t>(), TDMSDataTypeHelpers::ArrayReaderFactory<uint8_t>());
 }
 
@@ -9,6 +9,8 @@ const std::string TDMSMetaDataError("TDMS Meta Data Error: ");
 const std::string TDMSDataTypeError("TDMS Data Type Error: ");
 const std::string BadFile = TDMSFileError + "Unable to open file";
 const std::string EndOfFile = TDMSFileError + "Reached end of file";
+const std::string UnknownObject = TDMSFileError + "Requested object does not exist in file";
+const std::string ReadFailed = TDMSFileError + "Unable to read raw data from file";
 const std::string InvalidTag = TDMSLeadInError + "Lead in contains invalid tag";
 const std::string InvalidVersion = TDMSLeadInError + "Lead in contains invalid version number";
 const std::string IsBigEndian = TDMSLeadInError + "Lead in indicates data are big endian; only little endian data are supported";
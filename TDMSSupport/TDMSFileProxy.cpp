@@ -1,20 +1,80 @@
 #include "TDMSFileProxy.h"
 
+#include <algorithm>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "TDMSExceptionHandler.h"
 
+/**
+ * @brief The ReadObjectsImpl class reads the raw data of a range of objects whose chunk locations have
+ * already been resolved. Each task opens its own stream for the values that are not copied out of the
+ * memory map, so objects can be read concurrently.
+ */
+class TDMSFileProxy::ReadObjectsImpl
+{
+public:
+  ReadObjectsImpl(const std::string& file, const uchar* mappedData, uint64_t mappedSize, std::vector<TDMSObject::Pointer>& objects,
+                  std::vector<std::vector<TDMSObject::RawDataChunk>>& chunks)
+  : m_File(file)
+  , m_MappedData(mappedData)
+  , m_MappedSize(mappedSize)
+  , m_Objects(objects)
+  , m_Chunks(chunks)
+  {
+  }
+  virtual ~ReadObjectsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    std::ifstream filestream(m_File.data(), std::ios::binary | std::ios::in);
+    for(size_t i = start; i < end; i++)
+    {
+      m_Objects[i]->readRawData(filestream, m_MappedData, m_MappedSize, m_Chunks[i]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::string& m_File;
+  const uchar* m_MappedData;
+  uint64_t m_MappedSize;
+  std::vector<TDMSObject::Pointer>& m_Objects;
+  std::vector<std::vector<TDMSObject::RawDataChunk>>& m_Chunks;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 TDMSFileProxy::TDMSFileProxy(const std::string& file)
 : m_File(file)
 , m_FileStream(std::ifstream(m_File.data(), std::ios::binary | std::ios::in))
+, m_FileSize(0)
+, m_MappedData(nullptr)
 , m_ObjectsAllocated(false)
 , m_MetaDataRead(false)
+, m_UsedIndexFile(false)
 {
   if(!m_FileStream.good())
   {
     throw FatalTDMSException(TDMSExceptionMessages::BadFile);
   }
+  m_FileStream.seekg(0, std::ios::end);
+  m_FileSize = m_FileStream.tellg();
+  m_FileStream.seekg(0, std::ios::beg);
 }
 
 // -----------------------------------------------------------------------------
@@ -22,6 +82,10 @@ TDMSFileProxy::TDMSFileProxy(const std::string& file)
 // -----------------------------------------------------------------------------
 TDMSFileProxy::~TDMSFileProxy()
 {
+  if(nullptr != m_MappedData)
+  {
+    m_MappedFile.unmap(m_MappedData);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -42,14 +106,54 @@ void TDMSFileProxy::readMetaData()
   {
     return;
   }
-  uint64_t currentSegment = 0;
+
+  uint64_t segmentPosition = 0;
+  std::ifstream indexStream(m_File + "_index", std::ios::binary | std::ios::in);
+  if(indexStream.good())
+  {
+    try
+    {
+      m_UsedIndexFile = readSegments(indexStream, true, segmentPosition) && !m_Segments.empty();
+    } catch(const FatalTDMSException&)
+    {
+      m_UsedIndexFile = false;
+    }
+    if(!m_UsedIndexFile)
+    {
+      // the index does not describe the .tdms file; start over from the .tdms file alone
+      m_Segments.clear();
+      m_Objects.clear();
+      m_ObjectOrder.clear();
+      segmentPosition = 0;
+    }
+  }
+
+  m_FileStream.clear();
+  m_FileStream.seekg(segmentPosition);
+  readSegments(m_FileStream, false, segmentPosition);
+
+  m_FileStream.clear();
+
+  for(auto&& path : m_ObjectOrder)
+  {
+    m_Objects[path]->generateDataArray();
+  }
+  m_MetaDataRead = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TDMSFileProxy::readSegments(std::ifstream& metaDataStream, bool indexFile, uint64_t& segmentPosition)
+{
+  uint64_t currentSegment = m_Segments.size();
   while(true)
   {
     TDMSSegment::Pointer segment = nullptr;
 
     try
     {
-      segment = TDMSSegment::New(m_FileStream, currentSegment);
+      segment = TDMSSegment::New(m_FileStream, metaDataStream, currentSegment, segmentPosition, indexFile);
     } catch(const NonFatalTDMSException&)
     {
       break;
@@ -58,40 +162,118 @@ void TDMSFileProxy::readMetaData()
     {
       break;
     }
+    if(indexFile && segment->m_NextSegmentPosition > m_FileSize)
+    {
+      return false;
+    }
 
-    segment->readMetaData(m_Objects, m_ObjectOrder);
+    segment->readMetaData(metaDataStream, m_Objects, m_ObjectOrder);
     m_Segments.push_back(segment);
     currentSegment++;
-    if(m_FileStream.eof())
+    segmentPosition = segment->m_NextSegmentPosition;
+    if(metaDataStream.eof())
     {
       break;
     }
-    m_FileStream.seekg(segment->m_NextSegmentPosition);
+    metaDataStream.seekg(segment->m_NextMetaDataPosition);
   }
 
-  m_FileStream.clear();
+  return true;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TDMSFileProxy::readRawData()
+{
+  if(!m_MetaDataRead)
+  {
+    readMetaData();
+    allocateObjects();
+  }
+  for(auto&& segment : m_Segments)
+  {
+    segment->readRawData(m_Objects, m_ObjectOrder);
+  }
   for(auto&& path : m_ObjectOrder)
   {
-    m_Objects[path]->generateDataArray();
+    m_Objects[path]->m_RawDataRead = true;
   }
-  m_MetaDataRead = true;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TDMSFileProxy::readRawData()
+void TDMSFileProxy::readRawData(const std::vector<std::string>& paths, bool mapFile)
 {
   if(!m_MetaDataRead)
   {
     readMetaData();
-    allocateObjects();
   }
+
+  if(mapFile && nullptr == m_MappedData && m_FileSize > 0)
+  {
+    m_MappedFile.setFileName(QString::fromStdString(m_File));
+    if(m_MappedFile.open(QIODevice::ReadOnly))
+    {
+      m_MappedData = m_MappedFile.map(0, static_cast<qint64>(m_FileSize));
+    }
+  }
+
+  // resolve the objects and the locations of their raw data once, then read the objects concurrently
+  std::vector<TDMSObject::Pointer> objects;
+  std::vector<std::vector<TDMSObject::RawDataChunk>> chunks;
+  for(auto&& path : paths)
+  {
+    auto iter = m_Objects.find(path);
+    if(iter == m_Objects.end())
+    {
+      std::string info("Object path: " + path);
+      throw FatalTDMSException(TDMSExceptionMessages::UnknownObject, info);
+    }
+    TDMSObject::Pointer object = iter->second;
+    if(object->m_RawDataRead || !object->m_Data || std::find(std::begin(objects), std::end(objects), object) != std::end(objects))
+    {
+      continue;
+    }
+
+    if(!m_ObjectsAllocated)
+    {
+      object->allocate();
+    }
+    objects.push_back(object);
+    chunks.push_back(rawDataChunks(path));
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  ReadObjectsImpl readObjects(m_File, mapFile ? m_MappedData : nullptr, m_FileSize, objects, chunks);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, objects.size(), 1), readObjects, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    readObjects.compute(0, objects.size());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<TDMSObject::RawDataChunk> TDMSFileProxy::rawDataChunks(const std::string& path)
+{
+  std::vector<TDMSObject::RawDataChunk> chunks;
   for(auto&& segment : m_Segments)
   {
-    segment->readRawData(m_Objects, m_ObjectOrder);
+    segment->appendRawDataChunks(m_Objects, m_ObjectOrder, path, chunks);
   }
+  return chunks;
 }
 
 // -----------------------------------------------------------------------------
@@ -1,10 +1,14 @@
 #ifndef _tdmsfileproxy_h
 #define _tdmsfileproxy_h
 
+#include <QtCore/QFile>
+
 #include "TDMSObject.h"
 #include "TDMSSegment.h"
 
-class TDMSFileProxy
+#include "DREAM3DReview/DREAM3DReviewDLLExport.h"
+
+class DREAM3DReview_EXPORT TDMSFileProxy
 {
 public:
   virtual ~TDMSFileProxy();
@@ -14,10 +18,28 @@ public:
   typedef std::shared_ptr<TDMSFileProxy> Pointer;
   static Pointer New(const std::string& file);
 
+  /**
+   * @brief Reads the lead ins and meta data of all segments. When the .tdms_index companion file exists,
+   * the meta data are read from it instead of seeking through the raw data of the .tdms file; segments
+   * the index does not cover are read from the .tdms file.
+   */
   void readMetaData();
 
   void readRawData();
 
+  /**
+   * @brief Allocates and reads only the objects with the given paths (e.g. "/'Group'/'Channel'"). Fixed size
+   * values are copied out of a memory map of the file in runs of contiguous chunks where possible, and
+   * the objects are read concurrently. With mapFile false every chunk is read through a file stream, as
+   * when the file cannot be mapped.
+   */
+  void readRawData(const std::vector<std::string>& paths, bool mapFile = true);
+
+  bool usedIndexFile()
+  {
+    return m_UsedIndexFile;
+  }
+
   void allocateObjects();
 
   std::unordered_map<std::string, TDMSObject::Pointer> objects()
@@ -25,6 +47,14 @@ public:
     return m_Objects;
   }
 
+  /**
+   * @brief Returns the paths of all objects in the order they first appear in the file
+   */
+  std::vector<std::string> objectPaths()
+  {
+    return m_ObjectOrder;
+  }
+
   TDMSObject::Pointer rootObject();
 
   std::unordered_map<std::string, TDMSObject::Pointer> groupObjects();
@@ -32,17 +62,27 @@ public:
   std::unordered_map<std::string, TDMSObject::Pointer> channelObjects();
 
 private:
+  class ReadObjectsImpl;
+
   TDMSFileProxy(const std::string& file);
 
   std::unordered_map<std::string, TDMSObject::Pointer> extractObjectsOfType(TDMSObject::Type type);
 
+  bool readSegments(std::ifstream& metaDataStream, bool indexFile, uint64_t& segmentPosition);
+
+  std::vector<TDMSObject::RawDataChunk> rawDataChunks(const std::string& path);
+
   std::string m_File;
   std::ifstream m_FileStream;
+  uint64_t m_FileSize;
+  QFile m_MappedFile;
+  uchar* m_MappedData;
   std::list<TDMSSegment::Pointer> m_Segments;
   std::unordered_map<std::string, TDMSObject::Pointer> m_Objects;
   std::vector<std::string> m_ObjectOrder;
   bool m_ObjectsAllocated;
   bool m_MetaDataRead;
+  bool m_UsedIndexFile;
 };
 
 #endif
@@ -5,13 +5,15 @@
 #include "TDMSExceptionHandler.h"
 
 const std::string TDMSLeadIn::TDMSTAG = "TDSm";
+const std::string TDMSLeadIn::TDMSINDEXTAG = "TDSh";
 const std::set<uint32_t> TDMSLeadIn::TDMSVERSIONS = {4712, 4713};
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-TDMSLeadIn::TDMSLeadIn(std::ifstream& filestream)
+TDMSLeadIn::TDMSLeadIn(std::ifstream& filestream, bool indexFile)
 : m_FileStream(filestream)
+, m_IndexFile(indexFile)
 {
   constructLeadIn();
 }
@@ -26,9 +28,9 @@ TDMSLeadIn::~TDMSLeadIn()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-TDMSLeadIn::Pointer TDMSLeadIn::New(std::ifstream& filestream)
+TDMSLeadIn::Pointer TDMSLeadIn::New(std::ifstream& filestream, bool indexFile)
 {
-  Pointer shared(new TDMSLeadIn(filestream));
+  Pointer shared(new TDMSLeadIn(filestream, indexFile));
   return shared;
 }
 
@@ -46,9 +48,10 @@ void TDMSLeadIn::constructLeadIn()
   m_LeadInStruct = *(reinterpret_cast<TDMSLeadInStruct*>(buffer));
 
   std::string tdmstag(m_LeadInStruct.TDMSTag, 4);
-  if(tdmstag != TDMSTAG)
+  const std::string& validTag = m_IndexFile ? TDMSINDEXTAG : TDMSTAG;
+  if(tdmstag != validTag)
   {
-    std::string info("Tag from TDMS file: " + tdmstag + "\n" + "Valid TDMS tag: " + TDMSTAG);
+    std::string info("Tag from TDMS file: " + tdmstag + "\n" + "Valid TDMS tag: " + validTag);
     throw FatalTDMSException(TDMSExceptionMessages::InvalidTag, info);
   }
 
@@ -39,18 +39,20 @@ public:
   };
 
   static const std::string TDMSTAG;
+  static const std::string TDMSINDEXTAG;
   static const uint32_t TDMSLEADINLENGTH = 28;
   static const std::set<uint32_t> TDMSVERSIONS;
 
 private:
   friend class TDMSSegment;
 
-  TDMSLeadIn(std::ifstream& filestream);
-  static Pointer New(std::ifstream& filestream);
+  TDMSLeadIn(std::ifstream& filestream, bool indexFile);
+  static Pointer New(std::ifstream& filestream, bool indexFile = false);
 
   void constructLeadIn();
 
   std::ifstream& m_FileStream;
+  bool m_IndexFile;
   TDMSLeadInStruct m_LeadInStruct;
   ToCFlags m_ToCFlags;
 };
@@ -1,5 +1,7 @@
 #include "TDMSObject.h"
 
+#include <cstring>
+
 #include "TDMSExceptionHandler.h"
 
 // -----------------------------------------------------------------------------
@@ -15,6 +17,7 @@ TDMSObject::TDMSObject(const std::string& path)
 , m_CurrentDataPosition(0)
 , m_HasData(false)
 , m_HasInitializedMetaData(false)
+, m_RawDataRead(false)
 , m_Data(nullptr)
 {
   determineObjectType();
@@ -110,9 +113,46 @@ void TDMSObject::readRawData(std::ifstream& filestream, uint64_t index)
 {
   if(m_Data && m_DataType && m_HasData)
   {
-    m_DataType->readArrayFromFile(filestream, m_Data, m_CurrentDataPosition, m_MetaData->m_SegmentMetaData[index].NumberOfValues);
-    m_CurrentDataPosition += m_MetaData->m_SegmentMetaData[index].NumberOfValues;
+    const TDMSMetaData::MetaData& metaData = m_MetaData->m_SegmentMetaData[index];
+    m_DataType->readArrayFromFile(filestream, m_Data, m_CurrentDataPosition, metaData.NumberOfValues, metaData.TotalSegmentSize);
+    m_CurrentDataPosition += metaData.NumberOfValues;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TDMSObject::readRawData(std::ifstream& filestream, const uchar* mappedData, uint64_t mappedSize, const std::vector<RawDataChunk>& chunks)
+{
+  if(!m_Data || !m_DataType || !m_HasData)
+  {
+    return;
+  }
+
+  for(const RawDataChunk& chunk : chunks)
+  {
+    if(nullptr != mappedData && m_DataType->size() > 0)
+    {
+      if(chunk.FileOffset + chunk.Bytes > mappedSize)
+      {
+        std::string info("Object: " + m_Path + "\n" + "File offset (bytes): " + std::to_string(chunk.FileOffset) + "\n" + "File size (bytes): " + std::to_string(mappedSize));
+        throw FatalTDMSException(TDMSExceptionMessages::ReadFailed, info);
+      }
+      std::memcpy(m_Data->getVoidPointer(chunk.ValueIndex * m_Data->getNumberOfComponents()), mappedData + chunk.FileOffset, chunk.Bytes);
+    }
+    else
+    {
+      filestream.clear();
+      filestream.seekg(chunk.FileOffset);
+      m_DataType->readArrayFromFile(filestream, m_Data, chunk.ValueIndex, chunk.NumberOfValues, chunk.Bytes);
+      if(filestream.fail())
+      {
+        std::string info("Object: " + m_Path + "\n" + "File offset (bytes): " + std::to_string(chunk.FileOffset));
+        throw FatalTDMSException(TDMSExceptionMessages::ReadFailed, info);
+      }
+    }
   }
+  m_RawDataRead = true;
 }
 
 // -----------------------------------------------------------------------------
@@ -59,6 +59,17 @@ private:
   friend class TDMSFileProxy;
   friend class TDMSSegment;
 
+  /**
+   * @brief Location of a contiguous run of values of the object in the .tdms file
+   */
+  struct RawDataChunk
+  {
+    uint64_t FileOffset;
+    uint64_t ValueIndex;
+    uint64_t NumberOfValues;
+    uint64_t Bytes;
+  };
+
   TDMSObject(const std::string& path);
   static Pointer New(const std::string& path);
 
@@ -72,6 +83,12 @@ private:
 
   void readRawData(std::ifstream& filestream, uint64_t index);
 
+  /**
+   * @brief Reads the given chunks of the object; fixed size values are copied straight out of mappedData
+   * when the file is memory mapped, otherwise every chunk is read from filestream
+   */
+  void readRawData(std::ifstream& filestream, const uchar* mappedData, uint64_t mappedSize, const std::vector<RawDataChunk>& chunks);
+
   std::string parseChannelName();
 
   std::string parseGroupName();
@@ -88,6 +105,7 @@ private:
   size_t m_CurrentDataPosition;
   bool m_HasData;
   bool m_HasInitializedMetaData;
+  bool m_RawDataRead;
   IDataArray::Pointer m_Data;
   Type m_ObjectType;
 };
@@ -5,16 +5,17 @@
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-TDMSSegment::TDMSSegment(std::ifstream& filestream, uint64_t currentSegment)
+TDMSSegment::TDMSSegment(std::ifstream& filestream, std::ifstream& metaDataStream, uint64_t currentSegment, uint64_t segmentPosition, bool indexFile)
 : m_FileStream(filestream)
 , m_SegmentIndex(currentSegment)
 , m_LeadIn(nullptr)
-, m_RawDataPosition(filestream.tellg())
-, m_NextSegmentPosition(filestream.tellg())
+, m_RawDataPosition(segmentPosition)
+, m_NextSegmentPosition(segmentPosition)
+, m_NextMetaDataPosition(metaDataStream.tellg())
 , m_NumberOfChunks(0)
 , m_TotalSegmentDataSize(0)
 {
-  initializeSegment();
+  initializeSegment(metaDataStream, indexFile);
 }
 
 // -----------------------------------------------------------------------------
@@ -27,18 +28,18 @@ TDMSSegment::~TDMSSegment()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-TDMSSegment::Pointer TDMSSegment::New(std::ifstream& filestream, uint64_t currentSegment)
+TDMSSegment::Pointer TDMSSegment::New(std::ifstream& filestream, std::ifstream& metaDataStream, uint64_t currentSegment, uint64_t segmentPosition, bool indexFile)
 {
-  Pointer shared(new TDMSSegment(filestream, currentSegment));
+  Pointer shared(new TDMSSegment(filestream, metaDataStream, currentSegment, segmentPosition, indexFile));
   return shared;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TDMSSegment::initializeSegment()
+void TDMSSegment::initializeSegment(std::ifstream& metaDataStream, bool indexFile)
 {
-  m_LeadIn = TDMSLeadIn::New(m_FileStream);
+  m_LeadIn = TDMSLeadIn::New(metaDataStream, indexFile);
 
   m_RawDataPosition += TDMSLeadIn::TDMSLEADINLENGTH + m_LeadIn->m_LeadInStruct.RawDataOffset;
 
@@ -49,6 +50,9 @@ void TDMSSegment::initializeSegment()
 
   m_NextSegmentPosition += TDMSLeadIn::TDMSLEADINLENGTH + m_LeadIn->m_LeadInStruct.RemainingSegmentLength;
 
+  // segments in the index file end where the raw data would begin
+  m_NextMetaDataPosition += TDMSLeadIn::TDMSLEADINLENGTH + (indexFile ? m_LeadIn->m_LeadInStruct.RawDataOffset : m_LeadIn->m_LeadInStruct.RemainingSegmentLength);
+
   if(m_NextSegmentPosition < m_RawDataPosition)
   {
     std::string info("Next segment position (bytes): " + std::to_string(m_NextSegmentPosition) + "\n" + "Raw data position (bytes): " + std::to_string(m_RawDataPosition) + "\n" +
@@ -62,7 +66,7 @@ void TDMSSegment::initializeSegment()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TDMSSegment::readMetaData(std::unordered_map<std::string, TDMSObject::Pointer>& objects, std::vector<std::string>& order)
+void TDMSSegment::readMetaData(std::ifstream& metaDataStream, std::unordered_map<std::string, TDMSObject::Pointer>& objects, std::vector<std::string>& order)
 {
   if(!m_LeadIn->m_ToCFlags.HasMetaData)
   {
@@ -83,17 +87,17 @@ void TDMSSegment::readMetaData(std::unordered_map<std::string, TDMSObject::Point
   }
 
   char buffer[4];
-  m_FileStream.read(buffer, 4);
+  metaDataStream.read(buffer, 4);
   uint32_t numObjects = *(reinterpret_cast<uint32_t*>(buffer));
 
   std::list<std::string> objectsExtended;
 
   for(uint32_t i = 0; i < numObjects; i++)
   {
-    m_FileStream.read(buffer, 4);
+    metaDataStream.read(buffer, 4);
     uint32_t pathLength = *(reinterpret_cast<uint32_t*>(buffer));
     std::vector<char> pathBuffer(pathLength);
-    m_FileStream.read(pathBuffer.data(), pathLength);
+    metaDataStream.read(pathBuffer.data(), pathLength);
     std::string path(pathBuffer.data(), pathLength);
 
     TDMSObject::Pointer object = nullptr;
@@ -114,7 +118,7 @@ void TDMSSegment::readMetaData(std::unordered_map<std::string, TDMSObject::Point
     }
 
     objectsExtended.push_back(path);
-    object->m_MetaData->readSegmentMetaData(m_FileStream, m_SegmentIndex);
+    object->m_MetaData->readSegmentMetaData(metaDataStream, m_SegmentIndex);
     object->populateMetaData();
   }
 
@@ -155,16 +159,23 @@ void TDMSSegment::readRawData(std::unordered_map<std::string, TDMSObject::Pointe
     return;
   }
 
+  std::vector<TDMSObject::Pointer> objectsWithData;
+  for(auto&& path : order)
+  {
+    TDMSObject::Pointer object = objects[path];
+    if(object->m_MetaData->m_SegmentMetaData[m_SegmentIndex].HasData)
+    {
+      objectsWithData.push_back(object);
+    }
+  }
+
   m_FileStream.seekg(m_RawDataPosition);
 
   for(uint64_t i = 0; i < m_NumberOfChunks; i++)
   {
-    for(auto&& path : order)
+    for(auto&& object : objectsWithData)
     {
-      if(objects[path]->m_MetaData->m_SegmentMetaData[m_SegmentIndex].HasData)
-      {
-        objects[path]->readRawData(m_FileStream, m_SegmentIndex);
-      }
+      object->readRawData(m_FileStream, m_SegmentIndex);
     }
   }
 }
@@ -212,3 +223,57 @@ void TDMSSegment::computeIncrementalChunks(std::unordered_map<std::string, TDMSO
     }
   }
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TDMSSegment::appendRawDataChunks(std::unordered_map<std::string, TDMSObject::Pointer>& objects, std::vector<std::string>& order, const std::string& path,
+                                      std::vector<TDMSObject::RawDataChunk>& chunks)
+{
+  if(!m_LeadIn->m_ToCFlags.HasRawData || m_NumberOfChunks == 0)
+  {
+    return;
+  }
+
+  TDMSObject::Pointer object = objects[path];
+  if(m_SegmentIndex >= object->m_MetaData->m_SegmentMetaData.size() || !object->m_MetaData->m_SegmentMetaData[m_SegmentIndex].HasData)
+  {
+    return;
+  }
+
+  // the raw data of a chunk hold the values of every object with data, one after the other in object order
+  uint64_t offset = 0;
+  uint64_t chunkSize = 0;
+  for(auto&& otherPath : order)
+  {
+    const TDMSMetaData::MetaData& metaData = objects[otherPath]->m_MetaData->m_SegmentMetaData[m_SegmentIndex];
+    if(!metaData.HasData)
+    {
+      continue;
+    }
+    if(otherPath == path)
+    {
+      offset = chunkSize;
+    }
+    chunkSize += metaData.TotalSegmentSize;
+  }
+
+  const TDMSMetaData::MetaData& metaData = object->m_MetaData->m_SegmentMetaData[m_SegmentIndex];
+  bool fixedSize = object->m_DataType->size() > 0;
+  uint64_t valueIndex = chunks.empty() ? 0 : chunks.back().ValueIndex + chunks.back().NumberOfValues;
+  for(uint64_t i = 0; i < m_NumberOfChunks; i++)
+  {
+    uint64_t fileOffset = m_RawDataPosition + i * chunkSize + offset;
+    // fixed size values that directly follow the previous chunk are read in a single copy
+    if(fixedSize && !chunks.empty() && chunks.back().FileOffset + chunks.back().Bytes == fileOffset)
+    {
+      chunks.back().NumberOfValues += metaData.NumberOfValues;
+      chunks.back().Bytes += metaData.TotalSegmentSize;
+    }
+    else
+    {
+      chunks.push_back({fileOffset, valueIndex, metaData.NumberOfValues, metaData.TotalSegmentSize});
+    }
+    valueIndex += metaData.NumberOfValues;
+  }
+}
@@ -18,22 +18,34 @@ public:
 private:
   friend class TDMSFileProxy;
 
-  TDMSSegment(std::ifstream& filestream, uint64_t currentSegment);
-  static Pointer New(std::ifstream& filestream, uint64_t currentSegment);
+  /**
+   * @brief Reads the lead in of a segment from metaDataStream, which is either the .tdms file itself or
+   * its .tdms_index companion; the index repeats the lead ins and meta data of every segment without the
+   * raw data. segmentPosition is the offset of the segment in the .tdms file.
+   */
+  TDMSSegment(std::ifstream& filestream, std::ifstream& metaDataStream, uint64_t currentSegment, uint64_t segmentPosition, bool indexFile);
+  static Pointer New(std::ifstream& filestream, std::ifstream& metaDataStream, uint64_t currentSegment, uint64_t segmentPosition, bool indexFile = false);
 
-  void initializeSegment();
+  void initializeSegment(std::ifstream& metaDataStream, bool indexFile);
 
-  void readMetaData(std::unordered_map<std::string, TDMSObject::Pointer>& objects, std::vector<std::string>& order);
+  void readMetaData(std::ifstream& metaDataStream, std::unordered_map<std::string, TDMSObject::Pointer>& objects, std::vector<std::string>& order);
 
   void readRawData(std::unordered_map<std::string, TDMSObject::Pointer>& objects, std::vector<std::string>& order);
 
   void computeIncrementalChunks(std::unordered_map<std::string, TDMSObject::Pointer>& objects, std::vector<std::string>& order);
 
+  /**
+   * @brief Appends the locations of the raw data of the object at path in this segment to chunks
+   */
+  void appendRawDataChunks(std::unordered_map<std::string, TDMSObject::Pointer>& objects, std::vector<std::string>& order, const std::string& path,
+                           std::vector<TDMSObject::RawDataChunk>& chunks);
+
   std::ifstream& m_FileStream;
   uint64_t m_SegmentIndex;
   TDMSLeadIn::Pointer m_LeadIn;
   uint64_t m_RawDataPosition;
   uint64_t m_NextSegmentPosition;
+  uint64_t m_NextMetaDataPosition;
   uint64_t m_NumberOfChunks;
   uint64_t m_TotalSegmentDataSize;
 };
@@ -0,0 +1,260 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/EdgeGeom.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/DislocationLengthTracer.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+class DiscretizeDDDomainTest
+{
+
+  public:
+    DiscretizeDDDomainTest() = default;
+    virtual ~DiscretizeDDDomainTest() = default;
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFilterAvailability()
+    {
+      // Now instantiate the DiscretizeDDDomain Filter from the FilterManager
+      QString filtName = "DiscretizeDDDomain";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The DREAM3DReview Requires the use of the " << filtName.toStdString() << " filter which is found in the DREAM3DReview Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    FloatArrayType::Pointer runFilter(const std::vector<float>& nodes, const std::vector<MeshIndexType>& edges, ImageGeom::Pointer& image)
+    {
+      SharedVertexList::Pointer vertices = EdgeGeom::CreateSharedVertexList(static_cast<MeshIndexType>(nodes.size() / 3));
+      std::copy(nodes.begin(), nodes.end(), vertices->getPointer(0));
+      EdgeGeom::Pointer edgeGeom = EdgeGeom::CreateGeometry(static_cast<MeshIndexType>(edges.size() / 2), vertices, SIMPL::Geometry::EdgeGeometry);
+      std::copy(edges.begin(), edges.end(), edgeGeom->getEdgePointer(0));
+
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer edc = DataContainer::New(SIMPL::Defaults::DataContainerName);
+      edc->setGeometry(edgeGeom);
+      dca->addOrReplaceDataContainer(edc);
+
+      QString filtName = "DiscretizeDDDomain";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      DREAM3D_REQUIRE(nullptr != filterFactory.get())
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      var.setValue(FloatVec3Type(2.0f, 2.0f, 2.0f));
+      bool propWasSet = filter->setProperty("CellSize", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::DataContainerName, "", ""));
+      propWasSet = filter->setProperty("EdgeDataContainerName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+      DataContainer::Pointer vdc = dca->getDataContainer(SIMPL::Defaults::NewDataContainerName);
+      DREAM3D_REQUIRE(nullptr != vdc.get())
+      image = vdc->getGeometryAs<ImageGeom>();
+      DREAM3D_REQUIRE(nullptr != image.get())
+      AttributeMatrix::Pointer cellAttrMat = vdc->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+      DREAM3D_REQUIRE(nullptr != cellAttrMat.get())
+      FloatArrayType::Pointer density = cellAttrMat->getAttributeArrayAs<FloatArrayType>("DislocationLineDensity");
+      DREAM3D_REQUIRE(nullptr != density.get())
+      return density;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    double lengthInBox(const float point1[3], const float point2[3], const double corner1[3], const double corner2[3])
+    {
+      // clips the segment against the slabs of the box one axis at a time
+      double tEnter = 0.0;
+      double tExit = 1.0;
+      double length = 0.0;
+      for(size_t i = 0; i < 3; i++)
+      {
+        double start = point1[i];
+        double delta = static_cast<double>(point2[i]) - start;
+        length += delta * delta;
+        if(delta == 0.0)
+        {
+          if(start < corner1[i] || start > corner2[i])
+          {
+            return 0.0;
+          }
+          continue;
+        }
+        double t0 = (corner1[i] - start) / delta;
+        double t1 = (corner2[i] - start) / delta;
+        tEnter = std::max(tEnter, std::min(t0, t1));
+        tExit = std::min(tExit, std::max(t0, t1));
+      }
+      return tExit > tEnter ? (tExit - tEnter) * std::sqrt(length) : 0.0;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestAxisAlignedEdge()
+    {
+      // one edge along x; the unconnected corner nodes span a grid of 4 x 4 x 4 cells with a spacing of 1,
+      // whose boxes of 2 x 2 x 2 start half a spacing before each cell
+      std::vector<float> nodes = {0.0f, 0.0f, 0.0f, 4.0f, 4.0f, 4.0f, 0.25f, 1.25f, 2.25f, 3.75f, 1.25f, 2.25f};
+      std::vector<MeshIndexType> edges = {2, 3};
+      ImageGeom::Pointer image;
+      FloatArrayType::Pointer density = runFilter(nodes, edges, image);
+
+      SizeVec3Type dims = image->getDimensions();
+      DREAM3D_REQUIRE_EQUAL(dims[0], 4)
+      DREAM3D_REQUIRE_EQUAL(dims[1], 4)
+      DREAM3D_REQUIRE_EQUAL(dims[2], 4)
+      DREAM3D_REQUIRE_EQUAL(density->getNumberOfTuples(), 64)
+
+      // y = 1.25 lies in the boxes of rows 0 and 1, z = 2.25 in those of planes 1 and 2
+      const float lengths[4] = {1.25f, 2.0f, 2.0f, 1.25f};
+      for(size_t j = 0; j < 4; j++)
+      {
+        for(size_t k = 0; k < 4; k++)
+        {
+          for(size_t l = 0; l < 4; l++)
+          {
+            float expected = (k <= 1 && (j == 1 || j == 2)) ? lengths[l] : 0.0f;
+            // lengths are per um^3 of the 2 x 2 x 2 box, in m/mm^3
+            expected = expected / 8.0f * 1.0E12f;
+            float value = density->getValue((j * 4 + k) * 4 + l);
+            DREAM3D_REQUIRE(std::fabs(value - expected) <= 1.0e-5f * 1.0E12f)
+          }
+        }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestManyEdges()
+    {
+      // enough edges to be traced in several chunks; std::mt19937 gives the same sequence everywhere
+      const size_t numEdges = 3000;
+      std::mt19937 generator(5489U);
+      std::vector<float> nodes = {0.0f, 0.0f, 0.0f, 8.0f, 8.0f, 8.0f};
+      std::vector<MeshIndexType> edges;
+      for(size_t i = 0; i < numEdges; i++)
+      {
+        for(size_t j = 0; j < 6; j++)
+        {
+          nodes.push_back(static_cast<float>(generator() % 8001U) / 1000.0f);
+        }
+        edges.push_back(2 + 2 * i);
+        edges.push_back(3 + 2 * i);
+      }
+      ImageGeom::Pointer image;
+      FloatArrayType::Pointer density = runFilter(nodes, edges, image);
+
+      SizeVec3Type dims = image->getDimensions();
+      FloatVec3Type origin = image->getOrigin();
+      FloatVec3Type spacing = image->getSpacing();
+      DREAM3D_REQUIRE_EQUAL(dims[0], 8)
+      DREAM3D_REQUIRE_EQUAL(dims[1], 8)
+      DREAM3D_REQUIRE_EQUAL(dims[2], 8)
+      size_t totalPoints = dims[0] * dims[1] * dims[2];
+      DREAM3D_REQUIRE_EQUAL(density->getNumberOfTuples(), totalPoints)
+
+      // summing the traced lengths edge by edge must give the same floats however the edges were split up
+      std::vector<float> serial(totalPoints, 0.0f);
+      DislocationLengthTracer tracer(origin.data(), spacing.data(), dims.data());
+      for(size_t i = 0; i < numEdges; i++)
+      {
+        tracer.trace(&nodes[3 * edges[2 * i]], &nodes[3 * edges[2 * i + 1]], [&](size_t point, float length) { serial[point] += length; });
+      }
+      float cellVolume = 8.0f;
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        serial[i] /= cellVolume;
+        serial[i] *= 1.0E12f;
+        DREAM3D_REQUIRE_EQUAL(density->getValue(i), serial[i])
+      }
+
+      // and the traced lengths must match the segments clipped against each box
+      for(size_t j = 0; j < dims[2]; j++)
+      {
+        for(size_t k = 0; k < dims[1]; k++)
+        {
+          for(size_t l = 0; l < dims[0]; l++)
+          {
+            size_t index[3] = {l, k, j};
+            double corner1[3];
+            double corner2[3];
+            for(size_t d = 0; d < 3; d++)
+            {
+              corner1[d] = origin[d] + (static_cast<double>(index[d]) - 0.5) * spacing[d];
+              corner2[d] = corner1[d] + 2.0 * spacing[d];
+            }
+            double expected = 0.0;
+            for(size_t i = 0; i < numEdges; i++)
+            {
+              expected += lengthInBox(&nodes[3 * edges[2 * i]], &nodes[3 * edges[2 * i + 1]], corner1, corner2);
+            }
+            double value = density->getValue((j * dims[1] + k) * dims[0] + l) * 8.0 / 1.0E12;
+            DREAM3D_REQUIRE(std::fabs(value - expected) <= 1.0e-4 * std::max(1.0, expected))
+          }
+        }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      std::cout << "###### DiscretizeDDDomainTest ######" << std::endl;
+      int err = EXIT_SUCCESS;
+
+      DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+      DREAM3D_REGISTER_TEST(TestAxisAlignedEdge())
+      DREAM3D_REGISTER_TEST(TestManyEdges())
+    }
+
+  public:
+    DiscretizeDDDomainTest(const DiscretizeDDDomainTest&) = delete;            // Copy Constructor Not Implemented
+    DiscretizeDDDomainTest(DiscretizeDDDomainTest&&) = delete;                 // Move Constructor Not Implemented
+    DiscretizeDDDomainTest& operator=(const DiscretizeDDDomainTest&) = delete; // Copy Assignment Not Implemented
+    DiscretizeDDDomainTest& operator=(DiscretizeDDDomainTest&&) = delete;      // Move Assignment Not Implemented
+};
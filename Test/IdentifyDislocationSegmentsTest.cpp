@@ -0,0 +1,206 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/EdgeGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+namespace
+{
+/* Columns are vertex 1, vertex 2, Burgers vector, slip plane normal and the segment the edge belongs to,
+ * with the segments numbered in the order of their first edge
+ */
+const size_t k_NumEdges = 12;
+const size_t k_NumSegments = 5;
+const float k_Edges[k_NumEdges][9] = {
+    {0, 1, 1, 0, 0, 0, 0, 1, 1},      // a chain of three edges along x
+    {1, 2, 1, 0, 0, 0, 0, 1, 1},      //
+    {2, 3, 1, 0, 0, 0, 0, 1, 1},      //
+    {3, 4, 0, 1, 0, 0, 0, 1, 2},      // shares vertex 3 with the chain, but with another Burgers vector
+    {4, 5, 0, -1, 0, 0, 0, -1, 2},    // antiparallel vectors still join
+    {6, 7, 1, 0, 0, 0, 0, 1, 3},      // parallel to the chain, but not connected to it
+    {8, 9, 0, 0, 1, 1, 0, 0, 4},      //
+    {9, 6, 0, 0, 1, 1, 0, 0, 4},      // shares vertex 6 with segment 3, but with other vectors
+    {5, 10, 0, 1, 0, 0, 0, 1, 2},     // joins segment 2 after the Ids of segments 3 and 4 were handed out
+    {3, 11, 1, 0, 0, 0, 1, 0, 5},     // shares vertex 3 and the Burgers vector with the chain, but not the plane
+    {11, 12, 1, 0.01f, 0, 0, 1, 0, 5}, // about 0.57 degrees off the previous edge
+    {11, 13, 1, 0.02f, 0, 0, 1, 0, 5}, // 1.15 degrees off edge 9, but joins through the previous edge
+};
+const int k_SeedValue = 5489;
+} // namespace
+
+class IdentifyDislocationSegmentsTest
+{
+
+  public:
+    IdentifyDislocationSegmentsTest() = default;
+    virtual ~IdentifyDislocationSegmentsTest() = default;
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFilterAvailability()
+    {
+      // Now instantiate the IdentifyDislocationSegments Filter from the FilterManager
+      QString filtName = "IdentifyDislocationSegments";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The DREAM3DReview Requires the use of the " << filtName.toStdString() << " filter which is found in the DREAM3DReview Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer createDataContainerArray()
+    {
+      const MeshIndexType numVertices = 14;
+      SharedVertexList::Pointer vertices = EdgeGeom::CreateSharedVertexList(numVertices);
+      for(MeshIndexType i = 0; i < numVertices; i++)
+      {
+        vertices->setComponent(i, 0, static_cast<float>(i));
+        vertices->setComponent(i, 1, static_cast<float>(i % 3));
+        vertices->setComponent(i, 2, 0.0f);
+      }
+      EdgeGeom::Pointer edgeGeom = EdgeGeom::CreateGeometry(k_NumEdges, vertices, SIMPL::Geometry::EdgeGeometry);
+      MeshIndexType* edges = edgeGeom->getEdgePointer(0);
+
+      std::vector<size_t> tDims(1, k_NumEdges);
+      std::vector<size_t> cDims(1, 3);
+      FloatArrayType::Pointer burgersVectors = FloatArrayType::CreateArray(tDims, cDims, SIMPL::EdgeData::BurgersVectors, true);
+      FloatArrayType::Pointer slipPlaneNormals = FloatArrayType::CreateArray(tDims, cDims, SIMPL::EdgeData::SlipPlaneNormals, true);
+      for(size_t i = 0; i < k_NumEdges; i++)
+      {
+        edges[2 * i + 0] = static_cast<MeshIndexType>(k_Edges[i][0]);
+        edges[2 * i + 1] = static_cast<MeshIndexType>(k_Edges[i][1]);
+        for(int j = 0; j < 3; j++)
+        {
+          burgersVectors->setComponent(i, j, k_Edges[i][2 + j]);
+          slipPlaneNormals->setComponent(i, j, k_Edges[i][5 + j]);
+        }
+      }
+
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::EdgeDataContainerName);
+      m->setGeometry(edgeGeom);
+      dca->addOrReplaceDataContainer(m);
+      AttributeMatrix::Pointer edgeAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::EdgeAttributeMatrixName, AttributeMatrix::Type::Edge);
+      m->addOrReplaceAttributeMatrix(edgeAttrMat);
+      edgeAttrMat->insertOrAssign(burgersVectors);
+      edgeAttrMat->insertOrAssign(slipPlaneNormals);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    Int32ArrayType::Pointer runFilter()
+    {
+      QString filtName = "IdentifyDislocationSegments";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      DREAM3D_REQUIRE(nullptr != filterFactory.get())
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      DataContainerArray::Pointer dca = createDataContainerArray();
+      filter->setDataContainerArray(dca);
+
+      bool propWasSet = filter->setProperty("UseSeed", true);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("SeedValue", k_SeedValue);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+      DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::EdgeDataContainerName);
+      AttributeMatrix::Pointer edgeFeatureAttrMat = m->getAttributeMatrix(SIMPL::Defaults::EdgeFeatureAttributeMatrixName);
+      DREAM3D_REQUIRE(nullptr != edgeFeatureAttrMat.get())
+      DREAM3D_REQUIRE_EQUAL(edgeFeatureAttrMat->getNumberOfTuples(), k_NumSegments + 1)
+      BoolArrayType::Pointer active = edgeFeatureAttrMat->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::Active);
+      DREAM3D_REQUIRE(nullptr != active.get())
+      for(size_t i = 0; i < active->getNumberOfTuples(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(active->getValue(i), true)
+      }
+
+      Int32ArrayType::Pointer dislocationIds = m->getAttributeMatrix(SIMPL::Defaults::EdgeAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::EdgeData::DislocationIds);
+      DREAM3D_REQUIRE(nullptr != dislocationIds.get())
+      DREAM3D_REQUIRE_EQUAL(dislocationIds->getNumberOfTuples(), k_NumEdges)
+      return dislocationIds;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestSeededSegmentIds()
+    {
+      // the segments numbered in edge order are shuffled by exchanging each Id with a random one
+      std::mt19937_64 generator(static_cast<std::mt19937_64::result_type>(k_SeedValue));
+      std::uniform_int_distribution<int32_t> distribution(1, static_cast<int32_t>(k_NumSegments));
+      std::vector<int32_t> gid(k_NumSegments + 1);
+      for(size_t i = 0; i <= k_NumSegments; i++)
+      {
+        gid[i] = static_cast<int32_t>(i);
+      }
+      for(size_t i = 1; i <= k_NumSegments; i++)
+      {
+        std::swap(gid[i], gid[distribution(generator)]);
+      }
+
+      Int32ArrayType::Pointer dislocationIds = runFilter();
+      for(size_t i = 0; i < k_NumEdges; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(dislocationIds->getValue(i), gid[static_cast<size_t>(k_Edges[i][8])])
+      }
+
+      // the same seed gives the same Ids again
+      Int32ArrayType::Pointer repeatedIds = runFilter();
+      for(size_t i = 0; i < k_NumEdges; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(repeatedIds->getValue(i), dislocationIds->getValue(i))
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      std::cout << "###### IdentifyDislocationSegmentsTest ######" << std::endl;
+      int err = EXIT_SUCCESS;
+
+      DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+      DREAM3D_REGISTER_TEST(TestSeededSegmentIds())
+    }
+
+  public:
+    IdentifyDislocationSegmentsTest(const IdentifyDislocationSegmentsTest&) = delete;            // Copy Constructor Not Implemented
+    IdentifyDislocationSegmentsTest(IdentifyDislocationSegmentsTest&&) = delete;                 // Move Constructor Not Implemented
+    IdentifyDislocationSegmentsTest& operator=(const IdentifyDislocationSegmentsTest&) = delete; // Copy Assignment Not Implemented
+    IdentifyDislocationSegmentsTest& operator=(IdentifyDislocationSegmentsTest&&) = delete;      // Move Assignment Not Implemented
+};
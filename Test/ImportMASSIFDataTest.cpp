@@ -2,21 +2,80 @@
 // Insert your license & copyright information here
 // -----------------------------------------------------------------------------
 
+#include <vector>
+
 #include <QtCore/QFile>
 
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/Filtering/FilterFactory.hpp"
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Filtering/FilterPipeline.h"
 #include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/StringOperations.h"
 #include "UnitTestSupport.hpp"
 
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/H5Utilities.h"
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "DREAM3DReview/DREAM3DReviewConstants.h"
+
 #include "DREAM3DReviewTestFileLocations.h"
 
+namespace
+{
+const size_t k_Dims[3] = {5, 4, 3};
+const float k_Origin[3] = {1.0f, 2.0f, 3.0f};
+const float k_Spacing[3] = {0.5f, 0.25f, 2.0f};
+const int32_t k_FirstStep = 2;
+const int32_t k_LastStep = 4;
+const size_t k_NumArrays = 10;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString stepName(int32_t step)
+{
+  return "Step-" + StringOperations::GenerateIndexString(step, MASSIFUtilitiesConstants::ImportMassifData::MaxStepNumber);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<QString> arrayPaths()
+{
+  // the arrays relative to the Datapoint group of a step, in the order ImportMASSIFData reads them; the last two are integers
+  QVector<QString> paths;
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::DFieldsGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::DField);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::EFieldsGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::EField);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::SFieldsGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::SField);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::DFieldsGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::EVM);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::SFieldsGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::SVM);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::EulerAngleGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::Phi1);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::EulerAngleGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::Phi);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::EulerAngleGrpName + "/" + MASSIFUtilitiesConstants::ImportMassifData::Phi2);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::GrainID);
+  paths.push_back(MASSIFUtilitiesConstants::ImportMassifData::Phase);
+  return paths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t voxelValue(int32_t step, size_t array, size_t x, size_t y, size_t z)
+{
+  // every voxel of every array of every step holds its own value, so reading the wrong one shows up
+  return static_cast<int32_t>(step * 10000 + array * 100 + (z * k_Dims[1] + y) * k_Dims[0] + x);
+}
+} // namespace
+
 class ImportMASSIFDataTest
 {
 
@@ -30,8 +89,7 @@ class ImportMASSIFDataTest
     void RemoveTestFiles()
     {
 #if REMOVE_TEST_FILES
-      // QFile::remove(UnitTest::ImportMASSIFDataTest::TestFile1);
-      // QFile::remove(UnitTest::ImportMASSIFDataTest::TestFile2);
+      QFile::remove(UnitTest::ImportMASSIFDataTest::TestFile);
 #endif
     }
 
@@ -56,29 +114,270 @@ class ImportMASSIFDataTest
     // -----------------------------------------------------------------------------
     //
     // -----------------------------------------------------------------------------
-    int TestImportMASSIFDataTest()
+    int WriteTestFile()
+    {
+      hid_t fileId = QH5Utilities::createFile(UnitTest::ImportMASSIFDataTest::TestFile);
+      DREAM3D_REQUIRE(fileId > 0)
+      H5ScopedFileSentinel sentinel(&fileId, true);
+
+      // the geometry stores the dimensions x first, while the arrays are stored z slowest
+      std::vector<size_t> dims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+      std::vector<float> origin = {k_Origin[0], k_Origin[1], k_Origin[2]};
+      std::vector<float> spacing = {k_Spacing[0], k_Spacing[1], k_Spacing[2]};
+      hsize_t geometryDims[1] = {3};
+      hsize_t arrayDims[3] = {k_Dims[2], k_Dims[1], k_Dims[0]};
+      size_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+      QVector<QString> paths = arrayPaths();
+
+      for(int32_t step = k_FirstStep; step <= k_LastStep; step++)
+      {
+        QString stepPath = "/" + MASSIFUtilitiesConstants::ImportMassifData::DCGrpName + "/" + stepName(step);
+        QString geometryPath = stepPath + "/" + MASSIFUtilitiesConstants::ImportMassifData::GeometryGrpName;
+        herr_t err = H5Utilities::createGroupsFromPath(geometryPath.toStdString(), fileId);
+        DREAM3D_REQUIRE(err >= 0)
+        err = QH5Lite::writePointerDataset(fileId, geometryPath + "/" + MASSIFUtilitiesConstants::ImportMassifData::DimGrpName, 1, geometryDims, dims.data());
+        DREAM3D_REQUIRE(err >= 0)
+        err = QH5Lite::writePointerDataset(fileId, geometryPath + "/" + MASSIFUtilitiesConstants::ImportMassifData::OriginGrpName, 1, geometryDims, origin.data());
+        DREAM3D_REQUIRE(err >= 0)
+        err = QH5Lite::writePointerDataset(fileId, geometryPath + "/" + MASSIFUtilitiesConstants::ImportMassifData::SpacingGrpName, 1, geometryDims, spacing.data());
+        DREAM3D_REQUIRE(err >= 0)
+
+        for(size_t a = 0; a < k_NumArrays; a++)
+        {
+          QString datasetPath = stepPath + "/" + MASSIFUtilitiesConstants::ImportMassifData::Datapoint + "/" + paths[a];
+          err = H5Utilities::createGroupsFromPath(QH5Utilities::getParentPath(datasetPath).toStdString(), fileId);
+          DREAM3D_REQUIRE(err >= 0)
+
+          std::vector<int32_t> intValues(totalPoints);
+          std::vector<float> floatValues(totalPoints);
+          for(size_t z = 0; z < k_Dims[2]; z++)
+          {
+            for(size_t y = 0; y < k_Dims[1]; y++)
+            {
+              for(size_t x = 0; x < k_Dims[0]; x++)
+              {
+                size_t index = (z * k_Dims[1] + y) * k_Dims[0] + x;
+                intValues[index] = voxelValue(step, a, x, y, z);
+                floatValues[index] = static_cast<float>(intValues[index]);
+              }
+            }
+          }
+          if(a < k_NumArrays - 2)
+          {
+            err = QH5Lite::writePointerDataset(fileId, datasetPath, 3, arrayDims, floatValues.data());
+          }
+          else
+          {
+            err = QH5Lite::writePointerDataset(fileId, datasetPath, 3, arrayDims, intValues.data());
+          }
+          DREAM3D_REQUIRE(err >= 0)
+        }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    AbstractFilter::Pointer createFilter(int32_t stepNumber)
+    {
+      QString filtName = "ImportMASSIFData";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      DREAM3D_REQUIRE(nullptr != filterFactory.get())
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(DataContainerArray::New());
+
+      bool propWasSet = filter->setProperty("MassifInputFilePath", UnitTest::ImportMASSIFDataTest::TestFile);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("FilePrefix", "Step-");
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("StepNumber", stepNumber);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      return filter;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void setSubvolume(AbstractFilter::Pointer filter, const IntVec3Type& minIndex, const IntVec3Type& maxIndex, const IntVec3Type& stride)
+    {
+      bool propWasSet = filter->setProperty("ImportSubvolume", true);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      QVariant var;
+      var.setValue(minIndex);
+      propWasSet = filter->setProperty("SubvolumeMinIndex", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(maxIndex);
+      propWasSet = filter->setProperty("SubvolumeMaxIndex", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(stride);
+      propWasSet = filter->setProperty("SubvolumeStride", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int CheckStep(AbstractFilter::Pointer filter, const QString& amName, int32_t step, const IntVec3Type& minIndex, const IntVec3Type& stride)
+    {
+      DataContainer::Pointer dc = filter->getDataContainerArray()->getDataContainer(MASSIFUtilitiesConstants::ImportMassifData::MassifDC);
+      DREAM3D_REQUIRE(nullptr != dc.get())
+      ImageGeom::Pointer image = dc->getGeometryAs<ImageGeom>();
+      DREAM3D_REQUIRE(nullptr != image.get())
+      SizeVec3Type dims = image->getDimensions();
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      DREAM3D_REQUIRE(nullptr != am.get())
+      DREAM3D_REQUIRE_EQUAL(am->getNumberOfTuples(), dims[0] * dims[1] * dims[2])
+
+      QVector<QString> paths = arrayPaths();
+      for(size_t a = 0; a < k_NumArrays; a++)
+      {
+        QString name = QH5Utilities::getObjectNameFromPath(paths[a]);
+        FloatArrayType::Pointer floats = am->getAttributeArrayAs<FloatArrayType>(name);
+        Int32ArrayType::Pointer ints = am->getAttributeArrayAs<Int32ArrayType>(name);
+        if(a < k_NumArrays - 2)
+        {
+          DREAM3D_REQUIRE(nullptr != floats.get())
+        }
+        else
+        {
+          DREAM3D_REQUIRE(nullptr != ints.get())
+        }
+
+        for(size_t z = 0; z < dims[2]; z++)
+        {
+          for(size_t y = 0; y < dims[1]; y++)
+          {
+            for(size_t x = 0; x < dims[0]; x++)
+            {
+              size_t index = (z * dims[1] + y) * dims[0] + x;
+              int32_t expected = voxelValue(step, a, minIndex[0] + x * stride[0], minIndex[1] + y * stride[1], minIndex[2] + z * stride[2]);
+              if(a < k_NumArrays - 2)
+              {
+                DREAM3D_REQUIRE_EQUAL(floats->getValue(index), static_cast<float>(expected))
+              }
+              else
+              {
+                DREAM3D_REQUIRE_EQUAL(ints->getValue(index), expected)
+              }
+            }
+          }
+        }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestSingleStep()
+    {
+      AbstractFilter::Pointer filter = createFilter(3);
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+      ImageGeom::Pointer image = filter->getDataContainerArray()->getDataContainer(MASSIFUtilitiesConstants::ImportMassifData::MassifDC)->getGeometryAs<ImageGeom>();
+      SizeVec3Type dims = image->getDimensions();
+      FloatVec3Type origin = image->getOrigin();
+      FloatVec3Type spacing = image->getSpacing();
+      for(size_t i = 0; i < 3; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(dims[i], k_Dims[i])
+        DREAM3D_REQUIRE_EQUAL(origin[i], k_Origin[i])
+        DREAM3D_REQUIRE_EQUAL(spacing[i], k_Spacing[i])
+      }
+
+      return CheckStep(filter, MASSIFUtilitiesConstants::ImportMassifData::MassifAM, 3, IntVec3Type(0, 0, 0), IntVec3Type(1, 1, 1));
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestStepRange()
     {
-      //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-      /* Please write ImportMASSIFDataTest test code here.
-       *
-       * Your IO test files are:
-       * UnitTest::ImportMASSIFDataTest::TestFile1
-       * UnitTest::ImportMASSIFDataTest::TestFile2
-       *
-       * SIMPLib provides some macros that will throw exceptions when a test fails
-       * and thus report that during testing. These macros are located in the
-       * SIMPLib/Common/UnitTestSupport.hpp file. Some examples are:
-       *
-       * SIMPLib_REQUIRE_EQUAL(foo, 0)
-       * This means that if the variable foo is NOT equal to Zero then test will fail
-       * and the current test will exit immediately. If there are more tests registered
-       * with the SIMPLib_REGISTER_TEST() macro, the next test will execute. There are
-       * lots of examples in the SIMPLib/Test folder to look at.
-       */
-      //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-
-      int foo = 0;
-      DREAM3D_REQUIRE_EQUAL(foo, 0)
+      AbstractFilter::Pointer filter = createFilter(k_FirstStep);
+      bool propWasSet = filter->setProperty("ImportStepRange", true);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("EndStepNumber", k_LastStep);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("StepIncrement", 2);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+      // steps 2 and 4 each get their own Attribute Matrix; step 3 is skipped and nothing goes into the default one
+      DataContainer::Pointer dc = filter->getDataContainerArray()->getDataContainer(MASSIFUtilitiesConstants::ImportMassifData::MassifDC);
+      DREAM3D_REQUIRE_EQUAL(dc->getAttributeMatrices().size(), 2)
+      DREAM3D_REQUIRE(nullptr == dc->getAttributeMatrix(MASSIFUtilitiesConstants::ImportMassifData::MassifAM).get())
+      DREAM3D_REQUIRE(nullptr == dc->getAttributeMatrix(stepName(3)).get())
+
+      int err = CheckStep(filter, stepName(k_FirstStep), k_FirstStep, IntVec3Type(0, 0, 0), IntVec3Type(1, 1, 1));
+      DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+      return CheckStep(filter, stepName(k_LastStep), k_LastStep, IntVec3Type(0, 0, 0), IntVec3Type(1, 1, 1));
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestSubvolume()
+    {
+      // voxels 1 and 3 along x, 0 and 2 along y, and 1 and 2 along z
+      IntVec3Type minIndex(1, 0, 1);
+      IntVec3Type maxIndex(4, 3, 2);
+      IntVec3Type stride(2, 2, 1);
+      AbstractFilter::Pointer filter = createFilter(k_LastStep);
+      setSubvolume(filter, minIndex, maxIndex, stride);
+
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+      ImageGeom::Pointer image = filter->getDataContainerArray()->getDataContainer(MASSIFUtilitiesConstants::ImportMassifData::MassifDC)->getGeometryAs<ImageGeom>();
+      SizeVec3Type dims = image->getDimensions();
+      FloatVec3Type origin = image->getOrigin();
+      FloatVec3Type spacing = image->getSpacing();
+      for(size_t i = 0; i < 3; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(dims[i], 2)
+        DREAM3D_REQUIRE_EQUAL(origin[i], k_Origin[i] + minIndex[i] * k_Spacing[i])
+        DREAM3D_REQUIRE_EQUAL(spacing[i], k_Spacing[i] * stride[i])
+      }
+
+      return CheckStep(filter, MASSIFUtilitiesConstants::ImportMassifData::MassifAM, k_LastStep, minIndex, stride);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestInvalidParameters()
+    {
+      AbstractFilter::Pointer filter = createFilter(k_FirstStep);
+      filter->setProperty("ImportStepRange", true);
+      filter->setProperty("EndStepNumber", k_FirstStep - 1);
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -3011)
+
+      filter = createFilter(k_FirstStep);
+      filter->setProperty("ImportStepRange", true);
+      filter->setProperty("EndStepNumber", k_LastStep);
+      filter->setProperty("StepIncrement", 0);
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -3012)
+
+      filter = createFilter(k_FirstStep);
+      setSubvolume(filter, IntVec3Type(0, 0, 0), IntVec3Type(5, 3, 2), IntVec3Type(1, 1, 1));
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -3013)
+
+      filter = createFilter(k_FirstStep);
+      setSubvolume(filter, IntVec3Type(0, 0, 0), IntVec3Type(4, 3, 2), IntVec3Type(1, 0, 1));
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -3014)
 
       return EXIT_SUCCESS;
     }
@@ -93,7 +392,11 @@ class ImportMASSIFDataTest
 
       DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
-      DREAM3D_REGISTER_TEST(TestImportMASSIFDataTest())
+      DREAM3D_REGISTER_TEST(WriteTestFile())
+      DREAM3D_REGISTER_TEST(TestSingleStep())
+      DREAM3D_REGISTER_TEST(TestStepRange())
+      DREAM3D_REGISTER_TEST(TestSubvolume())
+      DREAM3D_REGISTER_TEST(TestInvalidParameters())
 
       DREAM3D_REGISTER_TEST(RemoveTestFiles())
     }
@@ -0,0 +1,315 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <cstring>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/TDMSSupport/TDMSFileProxy.h"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+class ImportTDMSFileTest
+{
+
+  public:
+    ImportTDMSFileTest() = default;
+    virtual ~ImportTDMSFileTest() = default;
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      QFile::remove(UnitTest::ImportTDMSFileTest::TestFile);
+      QFile::remove(UnitTest::ImportTDMSFileTest::TestIndexFile);
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFilterAvailability()
+    {
+      // Now instantiate the ImportTDMSFile Filter from the FilterManager
+      QString filtName = "ImportTDMSFile";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The DREAM3DReview Requires the use of the " << filtName.toStdString() << " filter which is found in the DREAM3DReview Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    template <typename T> void appendValue(QByteArray& bytes, T value)
+    {
+      bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void appendString(QByteArray& bytes, const QByteArray& string)
+    {
+      appendValue<uint32_t>(bytes, static_cast<uint32_t>(string.size()));
+      bytes.append(string);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void appendLeadIn(QByteArray& bytes, const char* tag, uint32_t tableOfContents, const QByteArray& metaData, const QByteArray& rawData)
+    {
+      bytes.append(tag, 4);
+      appendValue<uint32_t>(bytes, tableOfContents);
+      appendValue<uint32_t>(bytes, 4713);
+      appendValue<uint64_t>(bytes, static_cast<uint64_t>(metaData.size() + rawData.size()));
+      appendValue<uint64_t>(bytes, static_cast<uint64_t>(metaData.size()));
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void appendChunk(QByteArray& bytes, const float floats[2], const char* strings[2], const int64_t seconds[2])
+    {
+      appendValue<float>(bytes, floats[0]);
+      appendValue<float>(bytes, floats[1]);
+
+      // strings are stored as a table of end offsets followed by the characters
+      uint32_t offset = 0;
+      for(size_t i = 0; i < 2; i++)
+      {
+        offset += static_cast<uint32_t>(strlen(strings[i]));
+        appendValue<uint32_t>(bytes, offset);
+      }
+      bytes.append(strings[0]);
+      bytes.append(strings[1]);
+
+      for(size_t i = 0; i < 2; i++)
+      {
+        appendValue<uint64_t>(bytes, 0);
+        appendValue<int64_t>(bytes, seconds[i]);
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void writeTestFiles(bool writeIndex)
+    {
+      const uint32_t k_MetaData = 1 << 1;
+      const uint32_t k_NewObjList = 1 << 2;
+      const uint32_t k_RawData = 1 << 3;
+
+      /* One group with a float, a string and a timestamp channel, each holding two values per chunk.
+       * The first segment declares the objects and holds one chunk; the second segment reuses that
+       * meta data and holds two chunks.
+       */
+      QByteArray metaData;
+      appendValue<uint32_t>(metaData, 5);
+      appendString(metaData, "/");
+      appendValue<uint32_t>(metaData, 0xFFFFFFFF);
+      appendValue<uint32_t>(metaData, 0);
+      appendString(metaData, "/'Group'");
+      appendValue<uint32_t>(metaData, 0xFFFFFFFF);
+      appendValue<uint32_t>(metaData, 0);
+      appendString(metaData, "/'Group'/'Float'");
+      appendValue<uint32_t>(metaData, 20);
+      appendValue<uint32_t>(metaData, 9);
+      appendValue<uint32_t>(metaData, 1);
+      appendValue<uint64_t>(metaData, 2);
+      appendValue<uint32_t>(metaData, 0);
+      appendString(metaData, "/'Group'/'String'");
+      appendValue<uint32_t>(metaData, 28);
+      appendValue<uint32_t>(metaData, 0x20);
+      appendValue<uint32_t>(metaData, 1);
+      appendValue<uint64_t>(metaData, 2);
+      appendValue<uint64_t>(metaData, 11);
+      appendValue<uint32_t>(metaData, 0);
+      appendString(metaData, "/'Group'/'Time'");
+      appendValue<uint32_t>(metaData, 20);
+      appendValue<uint32_t>(metaData, 0x44);
+      appendValue<uint32_t>(metaData, 1);
+      appendValue<uint64_t>(metaData, 2);
+      appendValue<uint32_t>(metaData, 0);
+
+      QByteArray rawData1;
+      QByteArray rawData2;
+      for(size_t c = 0; c < 3; c++)
+      {
+        appendChunk(c == 0 ? rawData1 : rawData2, k_Floats + 2 * c, k_Strings + 2 * c, k_Seconds + 2 * c);
+      }
+
+      QByteArray file;
+      appendLeadIn(file, "TDSm", k_MetaData | k_NewObjList | k_RawData, metaData, rawData1);
+      file.append(metaData);
+      file.append(rawData1);
+      appendLeadIn(file, "TDSm", k_RawData, QByteArray(), rawData2);
+      file.append(rawData2);
+
+      QFile tdmsFile(UnitTest::ImportTDMSFileTest::TestFile);
+      DREAM3D_REQUIRE_EQUAL(tdmsFile.open(QIODevice::WriteOnly | QIODevice::Truncate), true)
+      DREAM3D_REQUIRE_EQUAL(tdmsFile.write(file), file.size())
+      tdmsFile.close();
+
+      // the index repeats the lead ins and meta data without the raw data
+      QFile::remove(UnitTest::ImportTDMSFileTest::TestIndexFile);
+      if(writeIndex)
+      {
+        QByteArray index;
+        appendLeadIn(index, "TDSh", k_MetaData | k_NewObjList | k_RawData, metaData, rawData1);
+        index.append(metaData);
+        appendLeadIn(index, "TDSh", k_RawData, QByteArray(), rawData2);
+
+        QFile indexFile(UnitTest::ImportTDMSFileTest::TestIndexFile);
+        DREAM3D_REQUIRE_EQUAL(indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate), true)
+        DREAM3D_REQUIRE_EQUAL(indexFile.write(index), index.size())
+        indexFile.close();
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void checkChannels(const IDataArray::Pointer& floatData, const IDataArray::Pointer& stringData, const IDataArray::Pointer& timeData)
+    {
+      FloatArrayType::Pointer floats = std::dynamic_pointer_cast<FloatArrayType>(floatData);
+      StringDataArray::Pointer strings = std::dynamic_pointer_cast<StringDataArray>(stringData);
+      UInt8ArrayType::Pointer times = std::dynamic_pointer_cast<UInt8ArrayType>(timeData);
+      DREAM3D_REQUIRE(nullptr != floats.get())
+      DREAM3D_REQUIRE(nullptr != strings.get())
+      DREAM3D_REQUIRE(nullptr != times.get())
+      DREAM3D_REQUIRE_EQUAL(floats->getNumberOfTuples(), 6)
+      DREAM3D_REQUIRE_EQUAL(strings->getNumberOfTuples(), 6)
+      DREAM3D_REQUIRE_EQUAL(times->getNumberOfTuples(), 6)
+      DREAM3D_REQUIRE_EQUAL(times->getNumberOfComponents(), 16)
+
+      QList<QDateTime> dateTimes = TDMSDataTypeHelpers::TDMSTimeStampsToQDateTimes(times);
+      DREAM3D_REQUIRE_EQUAL(dateTimes.size(), 6)
+      QDateTime epoch(QDate(1904, 1, 1), QTime(0, 0, 0, 0), Qt::UTC);
+      for(size_t i = 0; i < 6; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(floats->getValue(i), k_Floats[i])
+        DREAM3D_REQUIRE(strings->getValue(i) == QString(k_Strings[i]))
+        DREAM3D_REQUIRE(dateTimes[static_cast<int>(i)] == epoch.addSecs(k_Seconds[i]))
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void runFilter()
+    {
+      QString filtName = "ImportTDMSFile";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      DREAM3D_REQUIRE(nullptr != filterFactory.get())
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      filter->setDataContainerArray(dca);
+      bool propWasSet = filter->setProperty("InputFile", UnitTest::ImportTDMSFileTest::TestFile);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+      // the only group is selected, and every channel of it is imported
+      AttributeMatrix::Pointer am = dca->getAttributeMatrix(DataArrayPath("TDMSDataContainer", "ChannelData", ""));
+      DREAM3D_REQUIRE(nullptr != am.get())
+      DREAM3D_REQUIRE_EQUAL(am->getNumberOfTuples(), 6)
+      checkChannels(am->getAttributeArray("Float"), am->getAttributeArray("String"), am->getAttributeArray("Time"));
+
+      filter = filterFactory->create();
+      filter->setDataContainerArray(DataContainerArray::New());
+      filter->setProperty("InputFile", UnitTest::ImportTDMSFileTest::TestFile);
+      filter->setProperty("TDMSGroupName", "Missing");
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -11004)
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestImportTDMSFile()
+    {
+      // meta data from the .tdms_index file
+      writeTestFiles(true);
+      runFilter();
+
+      // meta data from the .tdms file alone
+      writeTestFiles(false);
+      runFilter();
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestUnmappedRead()
+    {
+      writeTestFiles(true);
+
+      // without the memory map the fixed size channels are read chunk by chunk from a stream
+      const std::vector<std::string> paths = {"/'Group'/'Float'", "/'Group'/'String'", "/'Group'/'Time'"};
+      TDMSFileProxy::Pointer proxy = TDMSFileProxy::New(UnitTest::ImportTDMSFileTest::TestFile.toStdString());
+      proxy->readMetaData();
+      DREAM3D_REQUIRE_EQUAL(proxy->usedIndexFile(), true)
+      proxy->readRawData(paths, false);
+
+      std::unordered_map<std::string, TDMSObject::Pointer> objects = proxy->objects();
+      checkChannels(objects[paths[0]]->data(), objects[paths[1]]->data(), objects[paths[2]]->data());
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      std::cout << "###### ImportTDMSFileTest ######" << std::endl;
+      int err = EXIT_SUCCESS;
+
+      DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+      DREAM3D_REGISTER_TEST(TestImportTDMSFile())
+      DREAM3D_REGISTER_TEST(TestUnmappedRead())
+
+      DREAM3D_REGISTER_TEST(RemoveTestFiles())
+    }
+
+  private:
+    const float k_Floats[6] = {1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f};
+    const char* k_Strings[6] = {"a", "bc", "def", "", "gh", "i"};
+    const int64_t k_Seconds[6] = {3600, 7200, 10800, 14400, 18000, 21600};
+
+  public:
+    ImportTDMSFileTest(const ImportTDMSFileTest&) = delete;            // Copy Constructor Not Implemented
+    ImportTDMSFileTest(ImportTDMSFileTest&&) = delete;                 // Move Constructor Not Implemented
+    ImportTDMSFileTest& operator=(const ImportTDMSFileTest&) = delete; // Copy Assignment Not Implemented
+    ImportTDMSFileTest& operator=(ImportTDMSFileTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,290 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/HEDM/MicConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/ReadMicVolume.h"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+class ReadMicVolumeTest
+{
+
+  public:
+    ReadMicVolumeTest() = default;
+    virtual ~ReadMicVolumeTest() = default;
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      QFile::remove(UnitTest::ReadMicVolumeTest::Slice0File);
+      QFile::remove(UnitTest::ReadMicVolumeTest::Slice1File);
+      QFile::remove(UnitTest::ReadMicVolumeTest::ConfigFile);
+      QFile::remove(UnitTest::ReadMicVolumeTest::DatFile);
+      QDir().rmdir(UnitTest::ReadMicVolumeTest::TestDir);
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFilterAvailability()
+    {
+      // Now instantiate the ReadMicVolume Filter from the FilterManager
+      QString filtName = "ReadMicVolume";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The DREAM3DReview Requires the use of the " << filtName.toStdString() << " filter which is found in the DREAM3DReview Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void writeTestFile(const QString& fileName, const QByteArray& contents)
+    {
+      QFile file(fileName);
+      DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::WriteOnly | QIODevice::Truncate), true)
+      DREAM3D_REQUIRE_EQUAL(file.write(contents), contents.size())
+      file.close();
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void writeTestFiles()
+    {
+      DREAM3D_REQUIRE_EQUAL(QDir().mkpath(UnitTest::ReadMicVolumeTest::TestDir), true)
+
+      /* Triangles with an edge length of 0.5 mm: the first slice has an up triangle at the origin and a
+       * down triangle sharing its apex row, the second slice only the down triangle. Columns are
+       * x y z up level good phi1 phi phi2 conf
+       */
+      writeTestFile(UnitTest::ReadMicVolumeTest::Slice0File, "0.5\n"
+                                                             "0.0 0.0 0.0 1 0 1 0.1 0.2 0.3 0.9\n"
+                                                             "0.5 0.8660254 0.0 0 0 1 0.4 0.5 0.6 0.8\n");
+      writeTestFile(UnitTest::ReadMicVolumeTest::Slice1File, "0.5\n"
+                                                             "0.5 0.8660254 0.0 0 0 1 0.7 0.8 0.9 0.7\n");
+      writeTestFile(UnitTest::ReadMicVolumeTest::ConfigFile, "SampleSymmetry Cubic\n");
+      writeTestFile(UnitTest::ReadMicVolumeTest::DatFile, "3.6,3.6,3.6\n"
+                                                          "90,90,90\n"
+                                                          "1\n"
+                                                          "28 0 0 0\n");
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void requireClose(float value, float expected)
+    {
+      DREAM3D_REQUIRE(std::fabs(value - expected) <= 1.0e-5f * std::max(1.0f, std::fabs(expected)))
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestReadMicVolume()
+    {
+      writeTestFiles();
+
+      QString filtName = "ReadMicVolume";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      DREAM3D_REQUIRE(nullptr != filterFactory.get())
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      FileListInfo_t input;
+      input.InputPath = UnitTest::ReadMicVolumeTest::TestDir;
+      input.FilePrefix = "slice_";
+      input.FileSuffix = "";
+      input.FileExtension = "mic";
+      input.StartIndex = 0;
+      input.EndIndex = 1;
+      input.IncrementIndex = 1;
+      input.PaddingDigits = 0;
+      input.Ordering = 0;
+      var.setValue(input);
+      bool propWasSet = filter->setProperty("InputFileListInfo", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("SliceSpacing", 2.0f);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+      // the grid spans the centroids of both slices padded by two edge lengths, in micrometers
+      DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+      DREAM3D_REQUIRE(nullptr != m.get())
+      ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+      DREAM3D_REQUIRE(nullptr != image.get())
+      SizeVec3Type dims = image->getDimensions();
+      DREAM3D_REQUIRE_EQUAL(dims[0], 6)
+      DREAM3D_REQUIRE_EQUAL(dims[1], 6)
+      DREAM3D_REQUIRE_EQUAL(dims[2], 2)
+      FloatVec3Type spacing = image->getSpacing();
+      requireClose(spacing[0], 500.0f);
+      requireClose(spacing[1], 500.0f);
+      requireClose(spacing[2], 2.0f);
+      FloatVec3Type origin = image->getOrigin();
+      requireClose(origin[0], -750.0f);
+      requireClose(origin[1], -855.662476f);
+      requireClose(origin[2], 0.0f);
+
+      AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+      DREAM3D_REQUIRE(nullptr != cellAttrMat.get())
+      Int32ArrayType::Pointer phases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+      FloatArrayType::Pointer eulers = cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+      FloatArrayType::Pointer confidence = cellAttrMat->getAttributeArrayAs<FloatArrayType>(Mic::Confidence);
+      DREAM3D_REQUIRE(nullptr != phases.get())
+      DREAM3D_REQUIRE(nullptr != eulers.get())
+      DREAM3D_REQUIRE(nullptr != confidence.get())
+      DREAM3D_REQUIRE_EQUAL(phases->getNumberOfTuples(), 72)
+
+      // each triangle covers a single grid point; every other point keeps zero angles and confidence
+      std::vector<float> expectedEulers(72 * 3, 0.0f);
+      std::vector<float> expectedConfidence(72, 0.0f);
+      const size_t k_Covered[3] = {14, 21, 57};
+      const float k_CoveredEulers[3][3] = {{0.1f, 0.2f, 0.3f}, {0.4f, 0.5f, 0.6f}, {0.7f, 0.8f, 0.9f}};
+      const float k_CoveredConfidence[3] = {0.9f, 0.8f, 0.7f};
+      for(size_t i = 0; i < 3; i++)
+      {
+        for(size_t c = 0; c < 3; c++)
+        {
+          expectedEulers[k_Covered[i] * 3 + c] = k_CoveredEulers[i][c];
+        }
+        expectedConfidence[k_Covered[i]] = k_CoveredConfidence[i];
+      }
+      for(size_t i = 0; i < 72; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(phases->getValue(i), 1)
+        requireClose(confidence->getValue(i), expectedConfidence[i]);
+        for(size_t c = 0; c < 3; c++)
+        {
+          requireClose(eulers->getComponent(i, c), expectedEulers[i * 3 + c]);
+        }
+      }
+
+      // the cache keeps the bounds of each slice, in mm
+      ReadMicVolume::Pointer reader = std::dynamic_pointer_cast<ReadMicVolume>(filter);
+      DREAM3D_REQUIRE(nullptr != reader.get())
+      std::vector<MicReader::MicSlice> bounds = reader->getSliceBounds_Cache();
+      DREAM3D_REQUIRE_EQUAL(bounds.size(), 2)
+      const float k_Bounds[2][4] = {{-0.75f, 1.75f, -0.855662465f, 1.72168779f}, {-0.25f, 1.75f, -0.278312206f, 1.72168779f}};
+      for(size_t z = 0; z < 2; z++)
+      {
+        requireClose(bounds[z].edgeLength, 0.5f);
+        requireClose(bounds[z].xMin, k_Bounds[z][0]);
+        requireClose(bounds[z].xMax, k_Bounds[z][1]);
+        requireClose(bounds[z].yMin, k_Bounds[z][2]);
+        requireClose(bounds[z].yMax, k_Bounds[z][3]);
+      }
+
+      // the single phase of the .dat file is cubic
+      AttributeMatrix::Pointer cellEnsembleAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName);
+      DREAM3D_REQUIRE(nullptr != cellEnsembleAttrMat.get())
+      UInt32ArrayType::Pointer crystalStructures = cellEnsembleAttrMat->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures);
+      FloatArrayType::Pointer latticeConstants = cellEnsembleAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::EnsembleData::LatticeConstants);
+      DREAM3D_REQUIRE(nullptr != crystalStructures.get())
+      DREAM3D_REQUIRE(nullptr != latticeConstants.get())
+      DREAM3D_REQUIRE_EQUAL(crystalStructures->getNumberOfTuples(), 2)
+      DREAM3D_REQUIRE_EQUAL(crystalStructures->getValue(1), Ebsd::CrystalStructure::Cubic_High)
+      requireClose(latticeConstants->getComponent(1, 0), 3.6f);
+      requireClose(latticeConstants->getComponent(1, 5), 90.0f);
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestReadMicVolumeErrors()
+    {
+      writeTestFiles();
+
+      QString filtName = "ReadMicVolume";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      DREAM3D_REQUIRE(nullptr != filterFactory.get())
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(DataContainerArray::New());
+      bool propWasSet = filter->setProperty("SliceSpacing", 0.0f);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -23001)
+
+      filter = filterFactory->create();
+      filter->setDataContainerArray(DataContainerArray::New());
+      QVariant var;
+      FileListInfo_t input;
+      input.InputPath = UnitTest::ReadMicVolumeTest::TestDir;
+      input.FilePrefix = "slice_";
+      input.FileSuffix = "";
+      input.FileExtension = "mic";
+      input.StartIndex = 1;
+      input.EndIndex = 0;
+      input.IncrementIndex = 1;
+      input.PaddingDigits = 0;
+      input.Ordering = 0;
+      var.setValue(input);
+      propWasSet = filter->setProperty("InputFileListInfo", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -23002)
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      std::cout << "###### ReadMicVolumeTest ######" << std::endl;
+      int err = EXIT_SUCCESS;
+
+      DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+      DREAM3D_REGISTER_TEST(TestReadMicVolume())
+      DREAM3D_REGISTER_TEST(TestReadMicVolumeErrors())
+
+      DREAM3D_REGISTER_TEST(RemoveTestFiles())
+    }
+
+  public:
+    ReadMicVolumeTest(const ReadMicVolumeTest&) = delete;            // Copy Constructor Not Implemented
+    ReadMicVolumeTest(ReadMicVolumeTest&&) = delete;                 // Move Constructor Not Implemented
+    ReadMicVolumeTest& operator=(const ReadMicVolumeTest&) = delete; // Copy Assignment Not Implemented
+    ReadMicVolumeTest& operator=(ReadMicVolumeTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,405 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+namespace
+{
+const size_t k_Dims[3] = {20, 20, 10};
+const size_t k_MaskedPlane = 9;
+
+/* Spheres centered on voxels with radii halfway between voxel distances, so that no voxel lies on a sphere
+ * and a voxel is only equally deep inside two spheres of the same radius at the same distance. Columns are
+ * Feature Id, center x y z in voxels, radius
+ */
+const int32_t k_NumFeatures = 5;
+const float k_Features[k_NumFeatures][5] = {
+    {1, 6, 6, 4, 4.5f},  // shares the plane x = 10 with Feature 2, where the lower Feature Id wins
+    {2, 14, 6, 4, 4.5f}, //
+    {3, 10, 14, 5, 3.5f}, // overlaps Feature 4
+    {4, 10, 9, 4, 2.5f},  // lies between Features 1, 2 and 3 and is deepest around its own center
+    {5, 3, 16, 7, 2.5f},  // reaches into the masked plane
+};
+} // namespace
+
+class TesselateFarFieldGrainsTest
+{
+
+  public:
+    TesselateFarFieldGrainsTest() = default;
+    virtual ~TesselateFarFieldGrainsTest() = default;
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      QFile::remove(UnitTest::TesselateFarFieldGrainsTest::FeatureFile);
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFilterAvailability()
+    {
+      // Now instantiate the TesselateFarFieldGrains Filter from the FilterManager
+      QString filtName = "TesselateFarFieldGrains";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The DREAM3DReview Requires the use of the " << filtName.toStdString() << " filter which is found in the DREAM3DReview Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void writeFeatureFile()
+    {
+      // the filter centers the features in x and y and places them relative to the beam center in z
+      QString contents;
+      QTextStream out(&contents);
+      out << "NumFeatures " << k_NumFeatures << "\n";
+      out << "BeamCenter 0\n";
+      out << "BeamThickness 10\n";
+      out << "GlobalZPos 0\n";
+      out << "NumPhases 1\n";
+      out << "Nickel Cubic 3.6 3.6 3.6 90 90 90\n";
+      for(int32_t i = 0; i < k_NumFeatures; i++)
+      {
+        const float* feature = k_Features[i];
+        out << feature[0] << " 1 1 0 0 0 1 0 0 0 1 " << feature[1] - k_Dims[0] / 2.0f << " " << feature[2] - k_Dims[1] / 2.0f << " " << feature[3] << " 3.6 3.6 3.6 90 90 90 0 0 0 "
+            << feature[4] << " 1\n";
+      }
+      out.flush();
+
+      QFile file(UnitTest::TesselateFarFieldGrainsTest::FeatureFile);
+      DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::WriteOnly | QIODevice::Truncate), true)
+      QByteArray bytes = contents.toLatin1();
+      DREAM3D_REQUIRE_EQUAL(file.write(bytes), bytes.size())
+      file.close();
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer createDataContainerArray()
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(k_Dims[0], k_Dims[1], k_Dims[2]);
+      image->setSpacing(1.0f, 1.0f, 1.0f);
+      image->setOrigin(0.0f, 0.0f, 0.0f);
+      m->setGeometry(image);
+      dca->addOrReplaceDataContainer(m);
+
+      std::vector<size_t> tDims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+      AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+      m->addOrReplaceAttributeMatrix(cellAttrMat);
+
+      std::vector<size_t> cDims(1, 1);
+      BoolArrayType::Pointer mask = BoolArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Mask, true);
+      size_t sliceSize = k_Dims[0] * k_Dims[1];
+      for(size_t i = 0; i < mask->getNumberOfTuples(); i++)
+      {
+        mask->setValue(i, i / sliceSize != k_MaskedPlane);
+      }
+      cellAttrMat->insertOrAssign(mask);
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    Int32ArrayType::Pointer runFilter(int gapFillMethod)
+    {
+      writeFeatureFile();
+
+      QString filtName = "TesselateFarFieldGrains";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      DREAM3D_REQUIRE(nullptr != filterFactory.get())
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      DataContainerArray::Pointer dca = createDataContainerArray();
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      FileListInfo_t input;
+      input.InputPath = UnitTest::TestTempDir;
+      input.FilePrefix = UnitTest::TesselateFarFieldGrainsTest::FeatureFilePrefix;
+      input.FileSuffix = "";
+      input.FileExtension = "txt";
+      input.StartIndex = 0;
+      input.EndIndex = 0;
+      input.IncrementIndex = 1;
+      input.PaddingDigits = 0;
+      input.Ordering = 0;
+      var.setValue(input);
+      bool propWasSet = filter->setProperty("FeatureInputFileListInfo", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+      propWasSet = filter->setProperty("OutputCellAttributeMatrixName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask));
+      propWasSet = filter->setProperty("MaskArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("GapFillMethod", gapFillMethod);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+      DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+      AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+      Int32ArrayType::Pointer featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+      Int32ArrayType::Pointer phases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+      DREAM3D_REQUIRE(nullptr != featureIds.get())
+      DREAM3D_REQUIRE(nullptr != phases.get())
+      DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), k_Dims[0] * k_Dims[1] * k_Dims[2])
+
+      // every Feature owns voxels, so none are removed
+      AttributeMatrix::Pointer cellFeatureAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      DREAM3D_REQUIRE(nullptr != cellFeatureAttrMat.get())
+      DREAM3D_REQUIRE_EQUAL(cellFeatureAttrMat->getNumberOfTuples(), static_cast<size_t>(k_NumFeatures + 1))
+
+      for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(phases->getValue(i), featureIds->getValue(i) > 0 ? 1 : 0)
+      }
+      return featureIds;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    std::vector<int32_t> expectedAssignment()
+    {
+      // each voxel goes to the sphere it lies deepest inside, relative to the radius, and to the lowest
+      // Feature Id among equally deep ones; voxels outside every sphere stay unassigned
+      std::vector<int32_t> expected(k_Dims[0] * k_Dims[1] * k_Dims[2], -1);
+      for(size_t plane = 0; plane < k_Dims[2]; plane++)
+      {
+        for(size_t row = 0; row < k_Dims[1]; row++)
+        {
+          for(size_t column = 0; column < k_Dims[0]; column++)
+          {
+            size_t index = (plane * k_Dims[1] + row) * k_Dims[0] + column;
+            if(plane == k_MaskedPlane)
+            {
+              expected[index] = 0;
+              continue;
+            }
+            double deepest = 1.0;
+            for(int32_t i = 0; i < k_NumFeatures; i++)
+            {
+              const float* feature = k_Features[i];
+              double dx = static_cast<double>(column) - feature[1];
+              double dy = static_cast<double>(row) - feature[2];
+              double dz = static_cast<double>(plane) - feature[3];
+              double depth = (dx * dx + dy * dy + dz * dz) / (feature[4] * feature[4]);
+              if(depth < deepest)
+              {
+                deepest = depth;
+                expected[index] = static_cast<int32_t>(feature[0]);
+              }
+            }
+          }
+        }
+      }
+      return expected;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestAssignVoxels()
+    {
+      std::vector<int32_t> expected = expectedAssignment();
+      Int32ArrayType::Pointer featureIds = runFilter(0);
+
+      size_t assigned = 0;
+      for(size_t i = 0; i < expected.size(); i++)
+      {
+        // the gaps are filled afterwards, so only the voxels inside a sphere or masked out are fixed here
+        if(expected[i] >= 0)
+        {
+          DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), expected[i])
+          assigned++;
+        }
+      }
+      DREAM3D_REQUIRE(assigned < expected.size())
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    std::vector<int32_t> expectedMajorityFill(std::vector<int32_t> featureIds)
+    {
+      // repeated passes over the whole volume as the filter used to make them: every unassigned voxel takes the
+      // Feature held by most of its face neighbors after each pass, the first to reach the winning count on ties
+      const int64_t dims[3] = {static_cast<int64_t>(k_Dims[0]), static_cast<int64_t>(k_Dims[1]), static_cast<int64_t>(k_Dims[2])};
+      const int64_t neighpoints[6] = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
+      std::vector<int64_t> neighbors(featureIds.size(), -1);
+      std::vector<int32_t> n(k_NumFeatures + 1, 0);
+      size_t count = 1;
+      while(count != 0)
+      {
+        count = 0;
+        for(int64_t plane = 0; plane < dims[2]; plane++)
+        {
+          for(int64_t row = 0; row < dims[1]; row++)
+          {
+            for(int64_t column = 0; column < dims[0]; column++)
+            {
+              int64_t index = (plane * dims[1] + row) * dims[0] + column;
+              if(featureIds[index] >= 0)
+              {
+                continue;
+              }
+              count++;
+              const bool good[6] = {plane > 0, row > 0, column > 0, column < dims[0] - 1, row < dims[1] - 1, plane < dims[2] - 1};
+              int32_t most = 0;
+              std::fill(n.begin(), n.end(), 0);
+              for(int32_t l = 0; l < 6; l++)
+              {
+                int32_t feature = good[l] ? featureIds[index + neighpoints[l]] : 0;
+                if(feature > 0)
+                {
+                  n[feature]++;
+                  if(n[feature] > most)
+                  {
+                    most = n[feature];
+                    neighbors[index] = index + neighpoints[l];
+                  }
+                }
+              }
+            }
+          }
+        }
+        for(size_t i = 0; i < featureIds.size(); i++)
+        {
+          if(featureIds[i] < 0 && neighbors[i] >= 0)
+          {
+            featureIds[i] = featureIds[neighbors[i]];
+          }
+        }
+      }
+      return featureIds;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int64_t squaredDistance(size_t index1, size_t index2)
+    {
+      int64_t d = 0;
+      for(size_t i = 0; i < 3; i++)
+      {
+        int64_t diff = static_cast<int64_t>(index1 % k_Dims[i]) - static_cast<int64_t>(index2 % k_Dims[i]);
+        d += diff * diff;
+        index1 /= k_Dims[i];
+        index2 /= k_Dims[i];
+      }
+      return d;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFillGaps()
+    {
+      std::vector<int32_t> assigned = expectedAssignment();
+
+      std::vector<int32_t> expected = expectedMajorityFill(assigned);
+      Int32ArrayType::Pointer featureIds = runFilter(0);
+      for(size_t i = 0; i < expected.size(); i++)
+      {
+        DREAM3D_REQUIRE(expected[i] >= 0)
+        DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), expected[i])
+      }
+
+      // each gap voxel goes to a Feature owning one of the assigned voxels nearest to it
+      featureIds = runFilter(1);
+      for(size_t i = 0; i < assigned.size(); i++)
+      {
+        int32_t feature = featureIds->getValue(i);
+        if(assigned[i] >= 0)
+        {
+          DREAM3D_REQUIRE_EQUAL(feature, assigned[i])
+          continue;
+        }
+        DREAM3D_REQUIRE(feature > 0)
+        int64_t nearest = std::numeric_limits<int64_t>::max();
+        int64_t nearestOfFeature = std::numeric_limits<int64_t>::max();
+        for(size_t j = 0; j < assigned.size(); j++)
+        {
+          if(assigned[j] <= 0)
+          {
+            continue;
+          }
+          int64_t d = squaredDistance(i, j);
+          nearest = std::min(nearest, d);
+          if(assigned[j] == feature)
+          {
+            nearestOfFeature = std::min(nearestOfFeature, d);
+          }
+        }
+        DREAM3D_REQUIRE_EQUAL(nearestOfFeature, nearest)
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      std::cout << "###### TesselateFarFieldGrainsTest ######" << std::endl;
+      int err = EXIT_SUCCESS;
+
+      DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+      DREAM3D_REGISTER_TEST(TestAssignVoxels())
+      DREAM3D_REGISTER_TEST(TestFillGaps())
+
+      DREAM3D_REGISTER_TEST(RemoveTestFiles())
+    }
+
+  public:
+    TesselateFarFieldGrainsTest(const TesselateFarFieldGrainsTest&) = delete;            // Copy Constructor Not Implemented
+    TesselateFarFieldGrainsTest(TesselateFarFieldGrainsTest&&) = delete;                 // Move Constructor Not Implemented
+    TesselateFarFieldGrainsTest& operator=(const TesselateFarFieldGrainsTest&) = delete; // Copy Assignment Not Implemented
+    TesselateFarFieldGrainsTest& operator=(TesselateFarFieldGrainsTest&&) = delete;      // Move Assignment Not Implemented
+};